@@ -26,6 +26,7 @@
 #define __ADAPTWINPOLYESTIMATOR_H__
 
 #include <deque>
+#include <vector>
 
 #include <yarp/sig/Vector.h>
 #include <iCub/ctrl/math.h>
@@ -86,6 +87,26 @@ protected:
 
     bool firstRun;
 
+    // state of the incremental mode: the latest N+1 elements are
+    // kept per dimension in a ring buffer along with the running
+    // sums of the time moments and of the data over the window
+    bool incremental;
+    bool incValid;
+    unsigned int incTicks;
+    unsigned int incHead;
+    double incT0;
+    std::vector<double> incTime;
+    std::vector<double> incData;
+    std::vector<double> incSums;
+    std::vector<double> incRef;
+    std::vector<unsigned int> incLen;
+
+    void incAdd(const unsigned int i, const unsigned int age, const double sign);
+    void incRebuild(const size_t dim, const int delta);
+    void incFit(const unsigned int i, const unsigned int n, const double d,
+                bool &stop);
+    bool incEstimate(yarp::sig::Vector &esteem, const int delta);
+
     /**
     * Find the regressor which best fits in least square sense the 
     * last n data sample couples, or all couples if n==0. 
@@ -146,6 +167,26 @@ public:
     */
     yarp::sig::Vector getMSE() { return mse; }
 
+    /**
+    * Enable/disable the incremental mode, where the fit over each
+    * window is computed from running moment sums of the data that
+    * are updated as samples enter and leave the window, instead of
+    * solving the least-squares problem from scratch.
+    * @param sw true to enable the incremental mode.
+    * @return true/false on success/failure.
+    * @note Available for polynomials of order 1 and 2 only, and
+    *       regardless of any redefinition of fit(). Elements are
+    *       expected to be fed one at a time through feedData() or
+    *       estimate(); otherwise the running sums are rebuilt.
+    */
+    bool setIncrementalMode(const bool sw);
+
+    /**
+    * Return the status of the incremental mode.
+    * @return true iff the incremental mode is enabled.
+    */
+    bool getIncrementalMode() const { return incremental; }
+
     /**
     * Execute the algorithm upon the elements list, with the max 
     * deviation threshold given by D. 
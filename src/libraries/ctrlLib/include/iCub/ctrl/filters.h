@@ -23,6 +23,7 @@
 #define __FILTERS_H__
 
 #include <deque>
+#include <vector>
 
 #include <yarp/sig/Vector.h>
 #include <iCub/ctrl/math.h>
@@ -80,11 +81,18 @@ protected:
    yarp::sig::Vector a;
    yarp::sig::Vector y;
 
-   std::deque<yarp::sig::Vector> uold;
-   std::deque<yarp::sig::Vector> yold;
+   // past inputs and outputs are stored in ring buffers arranged
+   // by lag, so that the samples of all the channels at a given
+   // lag are contiguous; uhead and yhead point to the latest ones
+   std::vector<double> uold;
+   std::vector<double> yold;
+   size_t uhead;
+   size_t yhead;
    size_t n;
    size_t m;
 
+   void allocStates(const size_t dim);
+
 public:
    /**
    * Creates a filter with specified numerator and denominator 
@@ -318,12 +326,27 @@ public:
 class MedianFilter : public IFilter
 {
 protected:
-   std::deque<std::deque<double> > uold;
+   // each channel keeps its window of n+1 samples in a ring and
+   // splits it into a max-heap (lower half) and a min-heap (upper
+   // half) of slot indices, so that the median lies on the heaps
+   // tops and a new sample costs O(log n) to be accounted for
+   std::vector<double> win;
+   std::vector<size_t> heap;
+   std::vector<size_t> pos;
    yarp::sig::Vector y;
    size_t n;
    size_t m;
-
-   double median(std::deque<double>& v);
+   size_t W;
+   size_t loCap;
+   size_t loCnt;
+   size_t hiCnt;
+   size_t head;
+
+   void siftUp(const double *v, size_t *h, size_t *p, const size_t base,
+               size_t i, const bool lo);
+   void siftDown(const double *v, size_t *h, size_t *p, const size_t base,
+                 size_t i, const size_t cnt, const bool lo);
+   void exchangeTops(const double *v, size_t *h, size_t *p);
 
 public:
    /**
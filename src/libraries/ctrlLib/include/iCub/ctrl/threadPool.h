@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+/**
+ * \defgroup threadPool Thread Pool
+ *  
+ * @ingroup ctrlLib
+ *
+ * Persistent workers for running batches of independent jobs 
+ * concurrently within a control loop. 
+ *
+ */ 
+
+
+#ifndef __CTRL_THREADPOOL_H__
+#define __CTRL_THREADPOOL_H__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+
+namespace iCub
+{
+
+namespace ctrl
+{
+
+/**
+* \ingroup threadPool
+*
+* Persistent workers that execute batches of independent jobs. 
+* The calling thread takes part in the computation, so that 
+* nThreads-1 workers are spawned. 
+*/
+class ThreadPool
+{
+protected:
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable cvStart;
+    std::condition_variable cvDone;
+
+    const std::function<void(unsigned int)> *job;
+    unsigned int numJobs;
+    unsigned int nextJob;
+    unsigned int pending;
+    unsigned long batch;
+    bool quit;
+
+    void consume(std::unique_lock<std::mutex> &lck);
+    void loop();
+
+public:
+    /**
+    * Constructor. 
+    * @param nThreads is the number of threads taking part in the 
+    *                 computation, the calling one included.
+    */
+    ThreadPool(const unsigned int nThreads);
+
+    /**
+    * Return the number of threads taking part in the computation, 
+    * the calling one included. 
+    * @return the number of threads.
+    */
+    unsigned int getNumThreads() const;
+
+    /**
+    * Call job(i) for each i in [0,n) distributing the calls over 
+    * the threads. 
+    * @param n is the number of jobs. 
+    * @param job is the function to be called; the calls must be 
+    *            independent of each other.
+    * @note The method returns only when all the calls have 
+    *       completed. It is not meant to be invoked concurrently
+    *       by several threads.
+    */
+    void run(const unsigned int n, const std::function<void(unsigned int)> &job);
+
+    /**
+    * Destructor. It waits for the workers to terminate.
+    */
+    virtual ~ThreadPool();
+};
+
+}
+
+}
+
+#endif
+
+
+
@@ -34,6 +34,11 @@ AWPolyEstimator::AWPolyEstimator(unsigned int _order, unsigned int _N, const dou
     x.resize(N);
 
     firstRun=true;
+    incremental=false;
+    incValid=false;
+    incTicks=0;
+    incHead=0;
+    incT0=0.0;
 }
 
 
@@ -117,6 +122,18 @@ Vector AWPolyEstimator::estimate()
     if (delta<0)
         return esteem;
 
+    if (incremental)
+    {
+        if (incEstimate(esteem,delta))
+        {
+            int margin=delta-10;
+            if (margin>0)
+                elemList.erase(elemList.begin(),elemList.begin()+margin);
+        }
+
+        return esteem;
+    }
+
     // retrieve the time vector
     // starting from t=0 (numeric stability reason)
     t[0]=0.0;
@@ -197,6 +214,299 @@ void AWPolyEstimator::reset()
         winLen.resize(elemList[0].data.length(),N);
         elemList.clear();
     }
+
+    incValid=false;
+}
+
+
+/***************************************************************************/
+bool AWPolyEstimator::setIncrementalMode(const bool sw)
+{
+    if (sw && ((order<1) || (order>2)))
+    {
+        yError()<<"Incremental mode is available for orders 1 and 2 only";
+        return false;
+    }
+
+    incremental=sw;
+    incValid=false;
+    return true;
+}
+
+
+/***************************************************************************/
+void AWPolyEstimator::incAdd(const unsigned int i, const unsigned int age,
+                             const double sign)
+{
+    // sums are arranged as: sum(t^j) for j=0,...,2*order, then
+    // sum(t^j*y) for j=0,...,order and finally sum(y^2); times
+    // are taken with respect to incT0 and data with respect to
+    // incRef, to keep the magnitudes low
+    size_t stride=3*order+3;
+    double *S=&incSums[i*stride];
+    double *Sy=S+2*order+1;
+
+    unsigned int slot=(incHead+N+1-age)%(N+1);
+    double tk=incTime[slot]-incT0;
+    double yk=incData[i*(N+1)+slot]-incRef[i];
+    double p=sign;
+    for (unsigned int j=0; j<=2*order; j++)
+    {
+        S[j]+=p;
+        if (j<=order)
+            Sy[j]+=p*yk;
+        p*=tk;
+    }
+
+    Sy[order+1]+=sign*yk*yk;
+}
+
+
+/***************************************************************************/
+void AWPolyEstimator::incRebuild(const size_t dim, const int delta)
+{
+    // the ring buffer is filled with the window of maximum length,
+    // whereas the running windows restart empty
+    incTime.assign(N+1,0.0);
+    incData.assign(dim*(N+1),0.0);
+    for (unsigned int j=0; j<N; j++)
+    {
+        const AWPolyElement &el=elemList[delta+j];
+        incTime[j]=el.time;
+        for (size_t i=0; i<dim; i++)
+            incData[i*(N+1)+j]=el.data[i];
+    }
+
+    incHead=N-1;
+    incT0=incTime[0];
+    incSums.assign(dim*(3*order+3),0.0);
+    incRef.resize(dim);
+    incLen.assign(dim,0);
+    for (size_t i=0; i<dim; i++)
+        incRef[i]=incData[i*(N+1)+incHead];
+
+    incTicks=0;
+    incValid=true;
+}
+
+
+/***************************************************************************/
+void AWPolyEstimator::incFit(const unsigned int i, const unsigned int n,
+                             const double d, bool &stop)
+{
+    size_t stride=3*order+3;
+    const double *S=&incSums[i*stride];
+    const double *Sy=S+2*order+1;
+    unsigned int P=order+1;
+
+    // move the moments to the time of the latest element, which
+    // keeps the normal equations well conditioned
+    double tNew=incTime[incHead];
+    double a=tNew-incT0;
+    double M[5],b[3];
+    for (unsigned int k=0; k<=2*order; k++)
+    {
+        double c=1.0;
+        double pa=1.0;
+        M[k]=0.0;
+        if (k<P)
+            b[k]=0.0;
+
+        for (unsigned int j=k; ; j--)
+        {
+            M[k]+=c*pa*S[j];
+            if (k<P)
+                b[k]+=c*pa*Sy[j];
+
+            if (j==0)
+                break;
+
+            c=c*j/(k-j+1);
+            pa*=-a;
+        }
+    }
+
+    // solve the normal equations
+    double cl[3]={0.0,0.0,0.0};
+    if (P==2)
+    {
+        double den=M[0]*M[2]-M[1]*M[1];
+        cl[0]=(b[0]*M[2]-M[1]*b[1])/den;
+        cl[1]=(M[0]*b[1]-M[1]*b[0])/den;
+    }
+    else
+    {
+        // gaussian elimination with partial pivoting
+        double G[3][4];
+        for (unsigned int r=0; r<P; r++)
+        {
+            for (unsigned int c=0; c<P; c++)
+                G[r][c]=M[r+c];
+            G[r][P]=b[r];
+        }
+
+        for (unsigned int c=0; c<P; c++)
+        {
+            unsigned int piv=c;
+            for (unsigned int r=c+1; r<P; r++)
+                if (fabs(G[r][c])>fabs(G[piv][c]))
+                    piv=r;
+
+            if (piv!=c)
+                for (unsigned int j=c; j<=P; j++)
+                    std::swap(G[c][j],G[piv][j]);
+
+            for (unsigned int r=c+1; r<P; r++)
+            {
+                double f=G[r][c]/G[c][c];
+                for (unsigned int j=c; j<=P; j++)
+                    G[r][j]-=f*G[c][j];
+            }
+        }
+
+        for (int r=P-1; r>=0; r--)
+        {
+            double v=G[r][P];
+            for (unsigned int j=r+1; j<P; j++)
+                v-=G[r][j]*cl[j];
+            cl[r]=v/G[r][r];
+        }
+    }
+
+    // the sum of squared residuals tells whether the maximum
+    // deviation is crossed unless it falls within [D^2,n*D^2],
+    // where the residuals need to be inspected one by one
+    double yy=Sy[P];
+    double sse=yy;
+    for (unsigned int r=0; r<P; r++)
+        sse-=cl[r]*b[r];
+    sse=std::max(sse,0.0);
+
+    double D2=D*D;
+    double tol=1e-10*yy;
+    if (sse<D2-tol)
+        stop=false;
+    else if (sse>n*D2+tol)
+        stop=true;
+    else
+    {
+        // start from the latest elements, where the deviation is
+        // expected to show up first
+        const double *y=&incData[i*(N+1)];
+        double ref=incRef[i];
+        double sse_=0.0;
+        stop=false;
+        for (unsigned int age=0; age<n; age++)
+        {
+            unsigned int slot=(incHead+N+1-age)%(N+1);
+            double u=incTime[slot]-tNew;
+            double e=y[slot]-ref-(cl[0]+cl[1]*u+cl[2]*u*u);
+            if (fabs(e)>D)
+            {
+                stop=true;
+                break;
+            }
+
+            sse_+=e*e;
+        }
+
+        if (!stop)
+            sse=sse_;
+    }
+
+    mse[i]=sse/n;
+
+    // express the regressor with respect to the time of the first
+    // element of the window of maximum length, as fit() does
+    coeff[0]=cl[0]-cl[1]*d+cl[2]*d*d+incRef[i];
+    coeff[1]=cl[1]-2.0*cl[2]*d;
+    if (order>1)
+        coeff[2]=cl[2];
+}
+
+
+/***************************************************************************/
+bool AWPolyEstimator::incEstimate(Vector &esteem, const int delta)
+{
+    size_t dim=esteem.length();
+    size_t L=elemList.size();
+    const AWPolyElement &last=elemList[L-1];
+
+    // the sums are rebuilt periodically to prevent the accumulation
+    // of round-off errors, and whenever the elements have not been
+    // fed one at a time
+    bool rebuild=!incValid || (L<2) || (incData.size()!=dim*(N+1)) ||
+                 (elemList[L-2].time!=incTime[incHead]) || (++incTicks>=N);
+    if (rebuild)
+    {
+        for (unsigned int j=1; j<N; j++)
+        {
+            if (elemList[delta+j].time<=elemList[delta].time)
+            {
+                yWarning()<<"Provided non-increasing time vector";
+                incValid=false;
+                return false;
+            }
+        }
+
+        incRebuild(dim,delta);
+    }
+    else if (last.time<=elemList[delta].time)
+    {
+        yWarning()<<"Provided non-increasing time vector";
+        incValid=false;
+        return false;
+    }
+    else
+    {
+        incHead=(incHead+1)%(N+1);
+        incTime[incHead]=last.time;
+        for (unsigned int i=0; i<dim; i++)
+        {
+            incData[i*(N+1)+incHead]=last.data[i];
+            incAdd(i,0,1.0);
+            incLen[i]++;
+        }
+    }
+
+    double d=last.time-elemList[delta].time;
+
+    for (unsigned int i=0; i<dim; i++)
+    {
+        // change the window length of two units, back and forth
+        unsigned int n1=(unsigned int)((winLen[i]>(order+1))?(winLen[i]-1):(order+1));
+        unsigned int n2=(unsigned int)((winLen[i]<N)?(winLen[i]+1):N);
+
+        // bring the running window, which ends at the latest
+        // element, to the shortest length
+        while (incLen[i]>n1)
+            incAdd(i,--incLen[i],-1.0);
+
+        while (incLen[i]<n1)
+            incAdd(i,incLen[i]++,1.0);
+
+        // cycle upon all possibile window's length
+        for (unsigned int n=n1; n<=n2; n++)
+        {
+            if (n>incLen[i])
+                incAdd(i,incLen[i]++,1.0);
+
+            bool _stop;
+            incFit(i,n,d,_stop);
+
+            // set the new window's length in case of
+            // crossing of max deviation threshold
+            if (_stop)
+            {
+                winLen[i]=n;
+                break;
+            }
+        }
+
+        esteem[i]=getEsteeme();
+    }
+
+    return true;
 }
 
 
@@ -31,20 +31,33 @@ Filter::Filter(const Vector &num, const Vector &den, const Vector &y0)
     m=b.length(); n=a.length();
     yAssert((m>0)&&(n>0));
 
-    uold.insert(uold.begin(),m-1,zeros((int)y0.length()));
-    yold.insert(yold.begin(),n-1,zeros((int)y0.length()));
-
+    allocStates(y0.length());
     init(y0);    
 }
 
 
+/***************************************************************************/
+void Filter::allocStates(const size_t dim)
+{
+    uold.assign((m-1)*dim,0.0);
+    yold.assign((n-1)*dim,0.0);
+    uhead=yhead=0;
+}
+
+
 /***************************************************************************/
 void Filter::init(const Vector &y0)
 {
     // take the last input
     // as guess for the next input
-    if (uold.size()>0)
-        init(y0,uold[0]);
+    if (m>1)
+    {
+        size_t dim=uold.size()/(m-1);
+        Vector u0(dim);
+        for (size_t j=0; j<dim; j++)
+            u0[j]=uold[uhead*dim+j];
+        init(y0,u0);
+    }
     else    // otherwise use zero
         init(y0,zeros((int)y0.length()));    
 }
@@ -78,12 +91,18 @@ void Filter::init(const Vector &y0, const Vector &u0)
             y_init=a[0]/(a[0]-sum_a)*y;
         // if sum_a==a[0] then the filter can only be initialized to zero
     }
-    
-    for (size_t i=0; i<yold.size(); i++)
-        yold[i]=y_init;
-    
-    for (size_t i=0; i<uold.size(); i++)
-        uold[i]=u_init;
+
+    size_t dim=y.length();
+    allocStates(dim);
+
+    for (size_t i=0; i<n-1; i++)
+        for (size_t j=0; j<dim; j++)
+            yold[i*dim+j]=y_init[j];
+
+    size_t dim_u=std::min(dim,u_init.length());
+    for (size_t i=0; i<m-1; i++)
+        for (size_t j=0; j<dim_u; j++)
+            uold[i*dim+j]=u_init[j];
 }
 
 
@@ -101,15 +120,10 @@ void Filter::setCoeffs(const Vector &num, const Vector &den)
     b=num;
     a=den;
 
-    uold.clear();
-    yold.clear();
-
     m=b.length(); n=a.length();
     yAssert((m>0)&&(n>0));
 
-    uold.insert(uold.begin(),m-1,zeros((int)y.length()));
-    yold.insert(yold.begin(),n-1,zeros((int)y.length()));
-
+    allocStates(y.length());
     init(y);
 }
 
@@ -131,8 +145,21 @@ bool Filter::adjustCoeffs(const Vector &num, const Vector &den)
 /***************************************************************************/
 void Filter::getStates(deque<Vector> &u, deque<Vector> &y)
 {
-    u=uold;
-    y=yold;
+    size_t dim=this->y.length();
+
+    u.assign(m-1,Vector(dim));
+    for (size_t i=0; i<m-1; i++)
+    {
+        const double *src=&uold[((uhead+i)%(m-1))*dim];
+        std::copy(src,src+dim,u[i].data());
+    }
+
+    y.assign(n-1,Vector(dim));
+    for (size_t i=0; i<n-1; i++)
+    {
+        const double *src=&yold[((yhead+i)%(n-1))*dim];
+        std::copy(src,src+dim,y[i].data());
+    }
 }
 
 
@@ -140,25 +167,50 @@ void Filter::getStates(deque<Vector> &u, deque<Vector> &y)
 const Vector& Filter::filt(const Vector &u)
 {
     yAssert(y.length()==u.length());
-    for (size_t j=0; j<y.length(); j++)
-        y[j]=b[0]*u[j];
+    size_t dim=y.length();
+    double *_y=y.data();
+    const double *_u=u.data();
+
+    // loops run over the channels, which are contiguous for
+    // each lag, and are thus amenable to vectorization
+    const double b0=b[0];
+    for (size_t j=0; j<dim; j++)
+        _y[j]=b0*_u[j];
     
     for (size_t i=1; i<m; i++)
-        for (size_t j=0; j<y.length(); j++)
-            y[j]+=b[i]*uold[i-1][j];
+    {
+        const double bi=b[i];
+        const double *_uold=&uold[((uhead+i-1)%(m-1))*dim];
+        for (size_t j=0; j<dim; j++)
+            _y[j]+=bi*_uold[j];
+    }
     
     for (size_t i=1; i<n; i++)
-        for (size_t j=0; j<y.length(); j++)
-            y[j]-=a[i]*yold[i-1][j];
-    
-    for (size_t j=0; j<y.length(); j++)
-        y[j]/=a[0];
-    
-    uold.push_front(u);
-    uold.pop_back();
+    {
+        const double ai=a[i];
+        const double *_yold=&yold[((yhead+i-1)%(n-1))*dim];
+        for (size_t j=0; j<dim; j++)
+            _y[j]-=ai*_yold[j];
+    }
     
-    yold.push_front(y);
-    yold.pop_back();
+    // skip the division for normalized coefficients
+    const double a0=a[0];
+    if (a0!=1.0)
+        for (size_t j=0; j<dim; j++)
+            _y[j]/=a0;
+
+    // the latest samples take the place of the oldest ones
+    if (m>1)
+    {
+        uhead=(uhead+m-2)%(m-1);
+        std::copy(_u,_u+dim,&uold[uhead*dim]);
+    }
+
+    if (n>1)
+    {
+        yhead=(yhead+n-2)%(n-1);
+        std::copy(_y,_y+dim,&yold[yhead*dim]);
+    }
     
     return y;
 }
@@ -200,16 +252,33 @@ void RateLimiter::setLimits(const Vector &rL, const Vector &rU)
 /**********************************************************************/
 const Vector& RateLimiter::filt(const Vector &u)
 {
-    uD=u-uLim;
-    for (size_t i=0; i<n; i++)
+    yAssert(uLim.length()==u.length());
+    size_t dim=u.length();
+    size_t nLim=std::min(n,dim);
+    if (uD.length()!=dim)
+        uD.resize(dim);
+
+    const double *_u=u.data();
+    const double *_rL=rateLowerLim.data();
+    const double *_rU=rateUpperLim.data();
+    double *_uD=uD.data();
+    double *_uLim=uLim.data();
+
+    // branchless clamping, amenable to vectorization
+    for (size_t i=0; i<nLim; i++)
     {
-        if (uD[i]>rateUpperLim[i])
-            uD[i]=rateUpperLim[i];
-        else if (uD[i]<rateLowerLim[i])
-            uD[i]=rateLowerLim[i];
+        double d=_u[i]-_uLim[i];
+        d=(d>_rU[i])?_rU[i]:((d<_rL[i])?_rL[i]:d);
+        _uD[i]=d;
+        _uLim[i]+=d;
+    }
+
+    for (size_t i=nLim; i<dim; i++)
+    {
+        _uD[i]=_u[i]-_uLim[i];
+        _uLim[i]+=_uD[i];
     }
 
-    uLim+=uD;
     return uLim;
 }
 
@@ -306,11 +375,15 @@ void MedianFilter::init(const Vector &y0)
     yAssert(y0.length()>0);
     y=y0;
     m=y.length();
-    uold.assign(m,deque<double>());
+    W=n+1;
+    loCap=(W+1)>>1;
+    win.assign(m*W,0.0);
+    heap.assign(m*W,0);
+    pos.assign(m*W,0);
+    loCnt=hiCnt=head=0;
 }
 
 
-
 /***************************************************************************/
 void MedianFilter::setOrder(const size_t n)
 {
@@ -320,16 +393,76 @@ void MedianFilter::setOrder(const size_t n)
 
 
 /***************************************************************************/
-double MedianFilter::median(deque<double>& v)
+void MedianFilter::siftUp(const double *v, size_t *h, size_t *p,
+                          const size_t base, size_t i, const bool lo)
 {
-    size_t L=v.size()>>1;
-    nth_element(v.begin(),v.begin()+L,v.end());
-    if (v.size()&0x01)
-        return v[L];
-    else
+    while (i>0)
+    {
+        size_t j=(i-1)>>1;
+        size_t a=h[base+i];
+        size_t b=h[base+j];
+        if (lo?(v[a]>v[b]):(v[a]<v[b]))
+        {
+            h[base+i]=b; p[b]=base+i;
+            h[base+j]=a; p[a]=base+j;
+            i=j;
+        }
+        else
+            break;
+    }
+}
+
+
+/***************************************************************************/
+void MedianFilter::siftDown(const double *v, size_t *h, size_t *p,
+                            const size_t base, size_t i, const size_t cnt,
+                            const bool lo)
+{
+    for (;;)
     {
-        nth_element(v.begin(),v.begin()+L-1,v.end());
-        return 0.5*(v[L]+v[L-1]);
+        size_t j=(i<<1)+1;
+        if (j>=cnt)
+            break;
+
+        if (j+1<cnt)
+        {
+            double vl=v[h[base+j]];
+            double vr=v[h[base+j+1]];
+            if (lo?(vr>vl):(vr<vl))
+                j++;
+        }
+
+        size_t a=h[base+i];
+        size_t b=h[base+j];
+        if (lo?(v[b]>v[a]):(v[b]<v[a]))
+        {
+            h[base+i]=b; p[b]=base+i;
+            h[base+j]=a; p[a]=base+j;
+            i=j;
+        }
+        else
+            break;
+    }
+}
+
+
+/***************************************************************************/
+void MedianFilter::exchangeTops(const double *v, size_t *h, size_t *p)
+{
+    // only one sample at a time can break the ordering between the
+    // two halves and, if so, it has already reached the top of its
+    // heap: swapping the tops and sinking them restores the ordering
+    if ((loCnt>0) && (hiCnt>0))
+    {
+        size_t a=h[0];
+        size_t b=h[loCap];
+        if (v[a]>v[b])
+        {
+            h[0]=b; p[b]=0;
+            h[loCap]=a; p[a]=loCap;
+            siftDown(v,h,p,0,0,loCnt,true);
+            siftDown(v,h,p,loCap,0,hiCnt,false);
+        }
     }
 }
 
@@ -338,17 +471,65 @@ double MedianFilter::median(deque<double>& v)
 const Vector& MedianFilter::filt(const Vector &u)
 {
     yAssert(y.length()==u.length());
-    for (size_t i=0; i<m; i++)
-        uold[i].push_front(u[i]);
+    const double *pu=u.data();
+    size_t cnt=loCnt+hiCnt;
 
-    if (uold[0].size()>n)
+    if (cnt<W)
     {
-        for (size_t i=0; i<m; i++)
+        // the window is filling up: the slots are taken in order
+        // and the lower half is given the extra sample, if any
+        const bool lo=(loCnt==hiCnt);
+        const size_t base=(lo?0:loCap);
+        const size_t i=(lo?loCnt:hiCnt);
+        if (lo)
+            loCnt++;
+        else
+            hiCnt++;
+
+        for (size_t c=0; c<m; c++)
         {
-            deque<double> tmp=uold[i];
-            y[i]=median(tmp);
-            uold[i].pop_back();
+            double *v=&win[c*W];
+            size_t *h=&heap[c*W];
+            size_t *p=&pos[c*W];
+
+            v[cnt]=pu[c];
+            h[base+i]=cnt; p[cnt]=base+i;
+            siftUp(v,h,p,base,i,lo);
+            exchangeTops(v,h,p);
         }
+
+        if (++cnt<W)
+            return y;
+    }
+    else
+    {
+        // the new sample overwrites the oldest one in place
+        for (size_t c=0; c<m; c++)
+        {
+            double *v=&win[c*W];
+            size_t *h=&heap[c*W];
+            size_t *p=&pos[c*W];
+
+            v[head]=pu[c];
+            const bool lo=(p[head]<loCap);
+            const size_t base=(lo?0:loCap);
+            const size_t i=p[head]-base;
+            siftUp(v,h,p,base,i,lo);
+            siftDown(v,h,p,base,p[head]-base,lo?loCnt:hiCnt,lo);
+            exchangeTops(v,h,p);
+        }
+
+        head=(head+1)%W;
+    }
+
+    for (size_t c=0; c<m; c++)
+    {
+        const double *v=&win[c*W];
+        const size_t *h=&heap[c*W];
+        if (W&0x01)
+            y[c]=v[h[0]];
+        else
+            y[c]=0.5*(v[h[loCap]]+v[h[0]]);
     }
 
     return y;
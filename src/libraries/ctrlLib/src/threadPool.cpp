@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+#include <iCub/ctrl/threadPool.h>
+
+using namespace std;
+using namespace iCub::ctrl;
+
+
+/***************************************************************************/
+ThreadPool::ThreadPool(const unsigned int nThreads) :
+                       job(NULL), numJobs(0), nextJob(0), pending(0),
+                       batch(0), quit(false)
+{
+    for (unsigned int i=1; i<nThreads; i++)
+        workers.push_back(thread(&ThreadPool::loop,this));
+}
+
+
+/***************************************************************************/
+void ThreadPool::consume(unique_lock<mutex> &lck)
+{
+    // to be called with mtx locked
+    while (nextJob<numJobs)
+    {
+        unsigned int i=nextJob++;
+        lck.unlock();
+        (*job)(i);
+        lck.lock();
+        if (--pending==0)
+            cvDone.notify_all();
+    }
+}
+
+
+/***************************************************************************/
+void ThreadPool::loop()
+{
+    unsigned long lastBatch=0;
+    unique_lock<mutex> lck(mtx);
+    while (true)
+    {
+        cvStart.wait(lck,[&](){ return (quit || (batch!=lastBatch)); });
+        if (quit)
+            return;
+
+        lastBatch=batch;
+        consume(lck);
+    }
+}
+
+
+/***************************************************************************/
+unsigned int ThreadPool::getNumThreads() const
+{
+    return (unsigned int)workers.size()+1;
+}
+
+
+/***************************************************************************/
+void ThreadPool::run(const unsigned int n, const function<void(unsigned int)> &_job)
+{
+    unique_lock<mutex> lck(mtx);
+    job=&_job;
+    numJobs=n;
+    nextJob=0;
+    pending=n;
+    batch++;
+    cvStart.notify_all();
+
+    consume(lck);
+    cvDone.wait(lck,[&](){ return (pending==0); });
+    job=NULL;
+}
+
+
+/***************************************************************************/
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lck(mtx);
+        quit=true;
+    }
+    cvStart.notify_all();
+    for (size_t i=0; i<workers.size(); i++)
+        workers[i].join();
+}
+
+
@@ -118,6 +118,7 @@ class iDynLink : public iKin::iKinLink
 {
     friend class iDynChain;
     friend class OneLinkNewtonEuler;
+    friend class OneChainNewtonEuler;
 
 protected:
     // DH rototranslation matrix (it's the same matrix you get calling iKinLink->getH(true) but it's stored here for performance reason)
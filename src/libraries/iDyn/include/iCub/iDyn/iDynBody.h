@@ -54,11 +54,17 @@
 #include <iCub/iDyn/iDynContact.h>
 #include <deque>
 #include <string>
+#include <functional>
 
 
 namespace iCub
 {
 
+namespace ctrl
+{
+    class ThreadPool;
+}
+
 namespace iDyn
 {
 
@@ -602,6 +608,22 @@ protected:
     */
     unsigned int howManyKinematicInputs(bool afterAttach=false) const;
 
+    /// the workers solving independent limbs concurrently (NULL if the parallel mode is off)
+    iCub::ctrl::ThreadPool *pool;
+
+    /**
+    * Calls job(i) for each i in [0,n). If the parallel mode is enabled the calls
+    * are distributed over the workers and the method returns only when all of them
+    * are over; otherwise they are performed sequentially by the calling thread.
+    * @param n the number of jobs, one per limb
+    * @param job the function solving the i-th limb; it must only access data of that limb
+    */
+    void runOnLimbs(const unsigned int n, const std::function<void(unsigned int)> &job);
+
+    // the workers cannot be shared among nodes
+    iDynNode(const iDynNode&) = delete;
+    iDynNode &operator=(const iDynNode&) = delete;
+
 public:
 
     /**
@@ -618,6 +640,29 @@ public:
     */
     iDynNode(const std::string &_info, const NewEulMode _mode=DYNAMIC, unsigned int verb=iCub::skinDynLib::VERBOSE);
 
+    /**
+    * Destructor
+    */
+    virtual ~iDynNode();
+
+    /**
+    * Enable/disable the parallel mode. When enabled, the limbs that do not depend on
+    * each other (i.e. those receiving kinematics from the node and those sending wrenches
+    * to the node) are solved concurrently during solveKinematics() and solveWrench(),
+    * and are joined at the node before the results are summed by the RigidBodyTransformation.
+    * The workers are created once here and persist until the mode is disabled.
+    * @param enable true to enable the parallel mode, false to go back to the sequential one
+    * @param nThreads the number of limbs solved at the same time, including the calling thread
+    * @return true if succeeds, false otherwise
+    */
+    bool setParallelMode(const bool enable, const unsigned int nThreads=2);
+
+    /**
+    * Return true if the parallel mode is enabled
+    * @return true if the limbs are solved concurrently
+    */
+    bool isParallelMode() const;
+
     /**
     * Add one limb to the node, defining its RigidBodyTransformation. A new RigidBodyTransformation
     * is added to the RBT list.
@@ -1560,6 +1605,16 @@ public:
     * @return true if succeeds, false otherwise
     */
     bool EXPERIMENTAL_getCOMvelocity(iCub::skinDynLib::BodyPart which_part, yarp::sig::Vector &vel, yarp::sig::Vector &dq);
+
+    /**
+    * Enable/disable the parallel mode in both the upper and lower torso, so that
+    * arms and legs are solved concurrently. Upper and lower torso are still solved
+    * one after the other, since the latter depends on the former.
+    * @param enable true to enable the parallel mode
+    * @param nThreads the number of limbs solved at the same time within each node
+    * @return true if succeeds, false otherwise
+    */
+    bool setParallelMode(const bool enable, const unsigned int nThreads=2);
 };
 
 
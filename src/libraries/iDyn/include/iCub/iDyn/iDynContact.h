@@ -59,10 +59,38 @@ protected:
     // body part related to this solver
     iCub::skinDynLib::BodyPart      bodyPart;
 
+    // rototranslation matrices from <firstContactLink-1> to each link of the contact subchain
+    std::vector<yarp::sig::Matrix>  subChainH;
+    // linear system A*X=B of the last estimate (kept to avoid reallocations)
+    yarp::sig::Matrix               A;
+    yarp::sig::Vector               B;
+    yarp::sig::Vector               X;
+    // complete orthogonal decomposition of A (Householder vectors stored in place,
+    // column permutation, rank), reused as long as A does not change
+    yarp::sig::Matrix               codA;
+    yarp::sig::Matrix               codW;
+    std::vector<unsigned int>       codPerm;
+    double                          codTauQ[6];
+    double                          codTauZ[6];
+    unsigned int                    codRank;
+    bool                            codValid;
+    yarp::sig::Vector               codY;
+
     void findContactSubChain(unsigned int &firstLink, unsigned int &lastLink);
-    
-    yarp::sig::Matrix buildA(unsigned int firstContactLink, unsigned int lastContactLink);
-    yarp::sig::Vector buildB(unsigned int firstContactLink, unsigned int lastContactLink);
+
+    void computeSubChainH(unsigned int firstContactLink, unsigned int lastContactLink);
+    const yarp::sig::Matrix& getSubChainH(unsigned int firstContactLink, unsigned int link) const;
+
+    const yarp::sig::Matrix& buildA(unsigned int firstContactLink, unsigned int lastContactLink);
+    const yarp::sig::Vector& buildB(unsigned int firstContactLink, unsigned int lastContactLink);
+
+    /**
+     * Compute the least-squares minimum-norm solution of A*X=B through a complete
+     * orthogonal decomposition of A (QR with column pivoting), whose rank is the number
+     * of diagonal elements of R larger than TOLLERANCE (the cutoff is raised to the
+     * rounding level of the factorization when A is badly scaled).
+     */
+    const yarp::sig::Vector& solveAXB();
     
     //***************************************************************************************
     // UTILITY METHODS
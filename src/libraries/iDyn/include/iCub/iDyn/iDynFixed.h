@@ -0,0 +1,615 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+/**
+ * \defgroup iDynFixed iDynFixed
+ *
+ * @ingroup iDyn
+ *
+ * Header-only versions of the standard iCub limbs whose
+ * kinematic and inertial parameters are known at compile time.
+ *
+ * \note <b>SI units adopted</b>: meters for lengths and radians
+ *       for angles.
+ *
+ * \section intro_sec Description
+ *
+ * iDynFixedLimb solves the Newton-Euler recursion of a limb
+ * described by a model class, i.e. a class providing the number
+ * of links N, the rotational part of H0 through R0() and the
+ * parameters of each link through link(). The parameters are
+ * constexpr data, hence the recursion is unrolled at compile time
+ * and does not involve virtual calls nor heap allocations.
+ *
+ * The models iCubRightArmDynModel, iCubLeftArmDynModel,
+ * iCubRightLegDynModel, iCubLeftLegDynModel and iCubTorsoDynModel
+ * reproduce the parameters of iCubArmDyn, iCubLegDyn and
+ * iCubTorsoDyn, and the resulting limbs compute the same torques
+ * of the corresponding iDynLimb in KINFWD_WREBWD mode.
+ *
+ * \note Only the default parameters are reproduced, i.e. those
+ *       in use when neither LEGS_NO_WEIGHT nor TORSO_NO_WEIGHT
+ *       are defined.
+ *
+ **/
+
+#ifndef __IDYNFIXED_H__
+#define __IDYNFIXED_H__
+
+#include <cmath>
+#include <type_traits>
+#include <yarp/sig/Vector.h>
+#include <iCub/ctrl/math.h>
+#include <iCub/iDyn/iDyn.h>
+
+
+namespace iCub
+{
+
+namespace iDyn
+{
+
+/**
+* \ingroup iDynFixed
+*
+* Constant parameters of a link, listed in the same order as
+* the arguments of the iDynLink constructor.
+*/
+struct iDynFixedLink
+{
+    double m;
+    double rcx, rcy, rcz;
+    double Ixx, Ixy, Ixz, Iyy, Iyz, Izz;
+    double A, D, alpha, offset;
+};
+
+
+/**
+* \ingroup iDynFixed
+*
+* Newton-Euler solver for a limb whose parameters are given at
+* compile time by the class Model (see iCubRightArmDynModel for
+* the required interface).
+*
+* Joints values refer to all the N links, thus the links that
+* iDynLimb keeps blocked (e.g. the torso within iCubArmDyn) shall
+* be given here explicitly.
+*
+* \note The mode DYNAMIC_W_ROTOR behaves as DYNAMIC, since the
+*       standard limbs have no motor/rotor parameters.
+*/
+template<class Model>
+class iDynFixedLimb
+{
+public:
+    static constexpr unsigned int N=Model::N;
+
+protected:
+    NewEulMode mode;
+
+    double ca[N];
+    double sa[N];
+    double R[N][9];
+
+    // quantities expressed in each frame: index 0 refers to the
+    // base, index j+1 to the link j
+    double w[N+1][3];
+    double dw[N+1][3];
+    double ddp[N+1][3];
+    double ddpC[N+1][3];
+    double F[N+1][3];
+    double Mu[N+1][3];
+
+    double FBase[3];
+    double MuBase[3];
+
+    static void cross(const double *a, const double *b, double *c)
+    {
+        c[0]=a[1]*b[2]-a[2]*b[1];
+        c[1]=a[2]*b[0]-a[0]*b[2];
+        c[2]=a[0]*b[1]-a[1]*b[0];
+    }
+
+    static void mul(const double *M, const double *v, double *r)
+    {
+        r[0]=M[0]*v[0]+M[1]*v[1]+M[2]*v[2];
+        r[1]=M[3]*v[0]+M[4]*v[1]+M[5]*v[2];
+        r[2]=M[6]*v[0]+M[7]*v[1]+M[8]*v[2];
+    }
+
+    static void mulT(const double *M, const double *v, double *r)
+    {
+        r[0]=M[0]*v[0]+M[3]*v[1]+M[6]*v[2];
+        r[1]=M[1]*v[0]+M[4]*v[1]+M[7]*v[2];
+        r[2]=M[2]*v[0]+M[5]*v[1]+M[8]*v[2];
+    }
+
+    static void mulI(const iDynFixedLink &L, const double *v, double *r)
+    {
+        r[0]=L.Ixx*v[0]+L.Ixy*v[1]+L.Ixz*v[2];
+        r[1]=L.Ixy*v[0]+L.Iyy*v[1]+L.Iyz*v[2];
+        r[2]=L.Ixz*v[0]+L.Iyz*v[1]+L.Izz*v[2];
+    }
+
+    template<unsigned int j>
+    void forward(const double *q, const double *dq, const double *ddq,
+                 std::integral_constant<unsigned int,j>)
+    {
+        constexpr iDynFixedLink L=Model::link(j);
+        const double *wp=w[j], *dwp=dw[j], *ddpp=ddp[j];
+        double *Rj=R[j];
+
+        double theta=q[j]+L.offset;
+        double c=cos(theta);
+        double s=sin(theta);
+        Rj[0]=c;    Rj[1]=-s*ca[j];     Rj[2]=s*sa[j];
+        Rj[3]=s;    Rj[4]=c*ca[j];      Rj[5]=-c*sa[j];
+        Rj[6]=0.0;  Rj[7]=sa[j];        Rj[8]=ca[j];
+
+        mulT(Rj,ddpp,ddp[j+1]);
+
+        if (mode==STATIC)
+        {
+            for (int k=0; k<3; k++)
+            {
+                w[j+1][k]=dw[j+1][k]=0.0;
+                ddpC[j+1][k]=ddp[j+1][k];
+            }
+        }
+        else
+        {
+            const double r[3]={L.A,L.D*sa[j],L.D*ca[j]};
+            const double rc[3]={L.rcx,L.rcy,L.rcz};
+            double v[3],c1[3],c2[3];
+
+            v[0]=wp[0]; v[1]=wp[1]; v[2]=wp[2]+dq[j];
+            mulT(Rj,v,w[j+1]);
+
+            v[0]=dwp[0]+dq[j]*wp[1];
+            v[1]=dwp[1]-dq[j]*wp[0];
+            v[2]=dwp[2]+(mode==DYNAMIC_CORIOLIS_GRAVITY ? 0.0 : ddq[j]);
+            mulT(Rj,v,dw[j+1]);
+
+            cross(dw[j+1],r,c1);
+            cross(w[j+1],r,v);
+            cross(w[j+1],v,c2);
+            for (int k=0; k<3; k++)
+                ddp[j+1][k]+=c1[k]+c2[k];
+
+            cross(dw[j+1],rc,c1);
+            cross(w[j+1],rc,v);
+            cross(w[j+1],v,c2);
+            for (int k=0; k<3; k++)
+                ddpC[j+1][k]=ddp[j+1][k]+c1[k]+c2[k];
+        }
+
+        forward(q,dq,ddq,std::integral_constant<unsigned int,j+1>());
+    }
+
+    void forward(const double*, const double*, const double*,
+                 std::integral_constant<unsigned int,N>) { }
+
+    template<unsigned int j>
+    void backwardLink()
+    {
+        constexpr iDynFixedLink L=Model::link(j);
+        const double *Rj=R[j];
+        const double *Fn=F[j+1], *Mun=Mu[j+1];
+        const double r[3]={L.A,L.D*sa[j],L.D*ca[j]};
+        const double rc[3]={L.rcx,L.rcy,L.rcz};
+        double v[3],u[3],c[3],t[3];
+
+        for (int k=0; k<3; k++)
+        {
+            c[k]=L.m*ddpC[j+1][k];
+            v[k]=c[k]+Fn[k];
+        }
+        mul(Rj,v,F[j]);
+
+        cross(r,Fn,v);
+        for (int k=0; k<3; k++)
+            u[k]=r[k]+rc[k];
+        cross(u,c,t);
+        for (int k=0; k<3; k++)
+            v[k]+=t[k]+Mun[k];
+
+        if (mode!=STATIC)
+        {
+            mulI(L,dw[j+1],u);
+            mulI(L,w[j+1],t);
+            cross(w[j+1],t,c);
+            for (int k=0; k<3; k++)
+                v[k]+=u[k]+c[k];
+        }
+
+        mul(Rj,v,Mu[j]);
+    }
+
+    template<unsigned int j>
+    void backward(std::integral_constant<unsigned int,j>)
+    {
+        backwardLink<j>();
+        backward(std::integral_constant<unsigned int,j-1>());
+    }
+
+    void backward(std::integral_constant<unsigned int,0>)
+    {
+        backwardLink<0>();
+    }
+
+public:
+    /**
+    * Constructor.
+    * @param _mode is the Newton-Euler computation mode.
+    */
+    explicit iDynFixedLimb(const NewEulMode _mode=DYNAMIC) : mode(_mode)
+    {
+        static_assert(N>0,"the limb must have at least one link");
+        for (unsigned int j=0; j<N; j++)
+        {
+            ca[j]=cos(Model::link(j).alpha);
+            sa[j]=sin(Model::link(j).alpha);
+        }
+
+        for (unsigned int j=0; j<=N; j++)
+            for (int k=0; k<3; k++)
+                w[j][k]=dw[j][k]=ddp[j][k]=ddpC[j][k]=F[j][k]=Mu[j][k]=0.0;
+
+        for (int k=0; k<3; k++)
+            FBase[k]=MuBase[k]=0.0;
+    }
+
+    /**
+    * Sets the Newton-Euler computation mode.
+    * @param _mode is the new mode.
+    */
+    void setMode(const NewEulMode _mode) { mode=_mode; }
+
+    /**
+    * Returns the Newton-Euler computation mode.
+    * @return the current mode.
+    */
+    NewEulMode getMode() const { return mode; }
+
+    /**
+    * Returns the number of links of the limb.
+    * @return the number of links.
+    */
+    unsigned int getN() const { return N; }
+
+    /**
+    * Computes the forward kinematics from the base and the
+    * backward wrenches from the end-effector, as
+    * iDynChain::computeNewtonEuler() does.
+    * @param q are the N joints angles.
+    * @param dq are the N joints velocities.
+    * @param ddq are the N joints accelerations.
+    * @param w0 is the angular velocity of the base.
+    * @param dw0 is the angular acceleration of the base.
+    * @param ddp0 is the linear acceleration of the base.
+    * @param Fend is the force applied at the end-effector.
+    * @param Muend is the moment applied at the end-effector.
+    */
+    void computeNewtonEuler(const double *q, const double *dq, const double *ddq,
+                            const double *w0, const double *dw0, const double *ddp0,
+                            const double *Fend, const double *Muend)
+    {
+        // the base quantities are rotated through H0
+        for (int k=0; k<3; k++)
+        {
+            w[0][k]=Model::R0(0,k)*w0[0]+Model::R0(1,k)*w0[1]+Model::R0(2,k)*w0[2];
+            dw[0][k]=Model::R0(0,k)*dw0[0]+Model::R0(1,k)*dw0[1]+Model::R0(2,k)*dw0[2];
+            ddp[0][k]=Model::R0(0,k)*ddp0[0]+Model::R0(1,k)*ddp0[1]+Model::R0(2,k)*ddp0[2];
+        }
+
+        forward(q,dq,ddq,std::integral_constant<unsigned int,0>());
+
+        for (int k=0; k<3; k++)
+        {
+            F[N][k]=Fend[k];
+            Mu[N][k]=Muend[k];
+        }
+
+        backward(std::integral_constant<unsigned int,N-1>());
+
+        for (int k=0; k<3; k++)
+        {
+            FBase[k]=Model::R0(k,0)*F[0][0]+Model::R0(k,1)*F[0][1]+Model::R0(k,2)*F[0][2];
+            MuBase[k]=Model::R0(k,0)*Mu[0][0]+Model::R0(k,1)*Mu[0][1]+Model::R0(k,2)*Mu[0][2];
+        }
+    }
+
+    /**
+    * Computes the forward kinematics from the base and the
+    * backward wrenches from the end-effector.
+    * @param q are the N joints angles.
+    * @param dq are the N joints velocities.
+    * @param ddq are the N joints accelerations.
+    * @param w0 is the angular velocity of the base.
+    * @param dw0 is the angular acceleration of the base.
+    * @param ddp0 is the linear acceleration of the base.
+    * @param Fend is the force applied at the end-effector.
+    * @param Muend is the moment applied at the end-effector.
+    * @return true/false on success/failure (wrong sizes).
+    */
+    bool computeNewtonEuler(const yarp::sig::Vector &q, const yarp::sig::Vector &dq,
+                            const yarp::sig::Vector &ddq, const yarp::sig::Vector &w0,
+                            const yarp::sig::Vector &dw0, const yarp::sig::Vector &ddp0,
+                            const yarp::sig::Vector &Fend, const yarp::sig::Vector &Muend)
+    {
+        if ((q.length()!=N) || (dq.length()!=N) || (ddq.length()!=N) ||
+            (w0.length()!=3) || (dw0.length()!=3) || (ddp0.length()!=3) ||
+            (Fend.length()!=3) || (Muend.length()!=3))
+            return false;
+
+        computeNewtonEuler(q.data(),dq.data(),ddq.data(),w0.data(),dw0.data(),
+                           ddp0.data(),Fend.data(),Muend.data());
+        return true;
+    }
+
+    /**
+    * Returns the torque of a link.
+    * @param i is the link index.
+    * @return the torque.
+    */
+    double getTorque(const unsigned int i) const { return Mu[i][2]; }
+
+    /**
+    * Copies the torques of the links.
+    * @param tau is the output array of N elements.
+    */
+    void getTorques(double *tau) const
+    {
+        for (unsigned int i=0; i<N; i++)
+            tau[i]=Mu[i][2];
+    }
+
+    /**
+    * Returns the torques of the links.
+    * @return the Nx1 vector of torques.
+    */
+    yarp::sig::Vector getTorques() const
+    {
+        yarp::sig::Vector tau(N);
+        getTorques(tau.data());
+        return tau;
+    }
+
+    /**
+    * Returns the force of a link, expressed in the link frame.
+    * @param i is the link index.
+    * @return pointer to the 3 force components.
+    */
+    const double *getForce(const unsigned int i) const { return F[i+1]; }
+
+    /**
+    * Returns the moment of a link, expressed in the link frame.
+    * @param i is the link index.
+    * @return pointer to the 3 moment components.
+    */
+    const double *getMoment(const unsigned int i) const { return Mu[i+1]; }
+
+    /**
+    * Returns the force exchanged at the base, expressed in the
+    * frame preceding H0.
+    * @return pointer to the 3 force components.
+    */
+    const double *getForceBase() const { return FBase; }
+
+    /**
+    * Returns the moment exchanged at the base, expressed in the
+    * frame preceding H0.
+    * @return pointer to the 3 moment components.
+    */
+    const double *getMomentBase() const { return MuBase; }
+};
+
+template<class Model>
+constexpr unsigned int iDynFixedLimb<Model>::N;
+
+
+/**
+* \ingroup iDynFixed
+*
+* Parameters of the right arm as in iCubArmDyn("right"): the
+* first three links belong to the torso.
+*/
+struct iCubRightArmDynModel
+{
+    static constexpr unsigned int N=10;
+
+    static constexpr double R0(const unsigned int r, const unsigned int c)
+    {
+        return ((r==0)&&(c==1)) ? -1.0 : (((r==1)&&(c==2)) ? -1.0 : (((r==2)&&(c==0)) ? 1.0 : 0.0));
+    }
+
+    static constexpr iDynFixedLink link(const unsigned int j)
+    {
+        //                 m,      rcx,      rcy,       rcz,      Ixx,        Ixy,        Ixz,     Iyy,       Iyz,     Izz,          A,        D,     alpha,            offset
+        const iDynFixedLink l[N]={
+            {            0,        0,        0,         0,        0,          0,          0,       0,         0,       0,      0.032,      0.0,  M_PI/2.0,               0.0},
+            {            0,        0,        0,         0,        0,          0,          0,       0,         0,       0,        0.0,      0.0,  M_PI/2.0,         -M_PI/2.0},
+            {            0,        0,        0,         0,        0,          0,          0,       0,         0,       0, -0.0233647,  -0.1433,  M_PI/2.0, -105.0*ctrl::CTRL_DEG2RAD},
+            {        0.189, 0.005e-3,  18.7e-3,   1.19e-3, 123.0e-6,   0.021e-6,  -0.001e-6, 24.4e-6,   4.22e-6, 113.0e-6,        0.0, -0.10774,  M_PI/2.0,         -M_PI/2.0},
+            {        0.179,-0.094e-3, -6.27e-3,  -16.6e-3, 137.0e-6, -0.453e-06,  0.203e-06, 83.0e-6,   20.7e-6,  99.3e-6,        0.0,      0.0, -M_PI/2.0,         -M_PI/2.0},
+            {        0.884,  1.79e-3, -62.9e-3, 0.064e-03, 743.0e-6,    63.9e-6,  0.851e-06,336.0e-6,  -3.61e-6, 735.0e-6,     -0.015, -0.15228, -M_PI/2.0, -105.0*ctrl::CTRL_DEG2RAD},
+            {        0.074, -13.7e-3, -3.71e-3,   1.05e-3,  28.4e-6,  -0.502e-6,  -0.399e-6, 9.24e-6, -0.371e-6,  29.9e-6,      0.015,      0.0,  M_PI/2.0,               0.0},
+            {        0.525,-0.347e-3,  71.3e-3,  -4.76e-3, 766.0e-6,    5.66e-6,    1.40e-6,164.0e-6,   18.2e-6, 699.0e-6,        0.0,  -0.1373,  M_PI/2.0,         -M_PI/2.0},
+            {            0,        0,        0,         0,        0,          0,          0,       0,         0,       0,        0.0,      0.0,  M_PI/2.0,          M_PI/2.0},
+            {        0.213,  7.73e-3, -8.05e-3,  -9.00e-3, 154.0e-6,    12.6e-6,   -6.08e-6,250.0e-6,   17.6e-6, 378.0e-6,     0.0625,    0.016,       0.0,              M_PI}
+        };
+        return l[j];
+    }
+};
+
+
+/**
+* \ingroup iDynFixed
+*
+* Parameters of the left arm as in iCubArmDyn("left"): the
+* first three links belong to the torso.
+*/
+struct iCubLeftArmDynModel
+{
+    static constexpr unsigned int N=10;
+
+    static constexpr double R0(const unsigned int r, const unsigned int c)
+    {
+        return iCubRightArmDynModel::R0(r,c);
+    }
+
+    static constexpr iDynFixedLink link(const unsigned int j)
+    {
+        //                 m,       rcx,        rcy,       rcz,        Ixx,        Ixy,       Ixz,        Iyy,        Iyz,        Izz,          A,       D,     alpha,           offset
+        const iDynFixedLink l[N]={
+            {            0,         0,          0,         0,          0,          0,         0,          0,          0,          0,      0.032,     0.0,  M_PI/2.0,              0.0},
+            {            0,         0,          0,         0,          0,          0,         0,          0,          0,          0,        0.0,     0.0,  M_PI/2.0,        -M_PI/2.0},
+            {            0,         0,          0,         0,          0,          0,         0,          0,          0,          0,  0.0233647, -0.1433, -M_PI/2.0, 105.0*ctrl::CTRL_DEG2RAD},
+            {         0.13, -0.004e-3,  14.915e-3, -0.019e-3,  54.421e-6,   0.009e-6,    0.0e-6,   9.331e-6,  -0.017e-6,  54.862e-6,        0.0, 0.10774, -M_PI/2.0,         M_PI/2.0},
+            {        0.178,  0.097e-3,  -6.271e-3, 16.622e-3,   137.2e-6,   0.466e-6,  0.365e-6,  82.927e-6, -20.524e-6,  99.274e-6,        0.0,     0.0,  M_PI/2.0,        -M_PI/2.0},
+            {        0.894, -1.769e-3,  63.302e-3, -0.084e-3, 748.531e-6,  63.340e-6, -0.903e-6, 338.109e-6,  -4.031e-6, 741.022e-6,      0.015, 0.15228, -M_PI/2.0,  75.0*ctrl::CTRL_DEG2RAD},
+            {        0.074, 13.718e-3,   3.712e-3, -1.046e-3,  28.389e-6,  -0.515e-6, -0.408e-6,   9.244e-6,  -0.371e-6,  29.968e-6,     -0.015,     0.0,  M_PI/2.0,              0.0},
+            {        0.525,  0.264e-3, -71.327e-3,  4.672e-3, 765.393e-6,   4.337e-6,  0.239e-6, 164.578e-6,  19.381e-6, 698.060e-6,        0.0,  0.1373,  M_PI/2.0,        -M_PI/2.0},
+            {            0,         0,          0,         0,          0,          0,         0,          0,          0,          0,        0.0,     0.0,  M_PI/2.0,         M_PI/2.0},
+            {        0.214,  7.851e-3,  -8.319e-3,  9.284e-3, 157.143e-6,  12.780e-6,  4.823e-6, 247.995e-6, -18.188e-6, 380.535e-6,     0.0625,  -0.016,       0.0,              0.0}
+        };
+        return l[j];
+    }
+};
+
+
+/**
+* \ingroup iDynFixed
+*
+* Parameters of the right leg as in iCubLegDyn("right").
+*/
+struct iCubRightLegDynModel
+{
+    static constexpr unsigned int N=6;
+
+    static constexpr double R0(const unsigned int r, const unsigned int c)
+    {
+        return (r==c) ? 1.0 : 0.0;
+    }
+
+    static constexpr iDynFixedLink link(const unsigned int j)
+    {
+        //                 m,     rcx,     rcy,      rcz, Ixx, Ixy, Ixz, Iyy, Iyz, Izz,      A,      D,     alpha,   offset
+        const iDynFixedLink l[N]={
+            {        0.754,       0, -0.0782,        0,   0,   0,   0,   0,   0,   0,    0.0,    0.0,  M_PI/2.0, M_PI/2.0},
+            {        0.526,       0,       0,  0.03045,   0,   0,   0,   0,   0,   0,    0.0,    0.0,  M_PI/2.0, M_PI/2.0},
+            {        2.175, 0.00144, 0.06417,  0.00039,   0,   0,   0,   0,   0,   0,    0.0, 0.2236, -M_PI/2.0,-M_PI/2.0},
+            {        1.264,  0.1059, 0.00182, -0.00211,   0,   0,   0,   0,   0,   0, -0.213,    0.0,      M_PI, M_PI/2.0},
+            {        0.746, -0.0054, 0.00163,  -0.0172,   0,   0,   0,   0,   0,   0,    0.0,    0.0,  M_PI/2.0,      0.0},
+            {        0.010,       0,       0,        0,   0,   0,   0,   0,   0,   0, -0.041,    0.0,      M_PI,      0.0}
+        };
+        return l[j];
+    }
+};
+
+
+/**
+* \ingroup iDynFixed
+*
+* Parameters of the left leg as in iCubLegDyn("left").
+*/
+struct iCubLeftLegDynModel
+{
+    static constexpr unsigned int N=6;
+
+    static constexpr double R0(const unsigned int r, const unsigned int c)
+    {
+        return (r==c) ? 1.0 : 0.0;
+    }
+
+    static constexpr iDynFixedLink link(const unsigned int j)
+    {
+        //                 m,     rcx,     rcy,      rcz,          Ixx,         Ixy,        Ixz,          Iyy,         Iyz,         Izz,      A,       D,     alpha,   offset
+        const iDynFixedLink l[N]={
+            {        0.754,       0, -0.0782,        0,   471.076e-6,    2.059e-6,   1.451e-6,   346.478e-6,    1.545e-6,  510.315e-6,    0.0,     0.0, -M_PI/2.0, M_PI/2.0},
+            {        0.526,       0,       0, -0.03045,  738.0487e-6,   -0.074e-6,  -0.062e-6,   561.583e-6,   10.835e-6,  294.119e-6,    0.0,     0.0, -M_PI/2.0, M_PI/2.0},
+            {        2.175, 0.00144, 0.06417, -0.00039,  7591.073e-6,  -67.260e-6,   2.267e-6, 1423.0245e-6, 36.37258e-6, 7553.849e-6,    0.0, -0.2236,  M_PI/2.0,-M_PI/2.0},
+            {        1.264,  0.1059, 0.00182,  0.00211,   998.950e-6, -185.699e-6, -63.147e-6,  4450.537e-6,    0.786e-6, 4207.657e-6, -0.213,     0.0,      M_PI, M_PI/2.0},
+            {        0.746, -0.0054, 0.00163,   0.0172,   633.230e-6,   -7.081e-6,  41.421e-6,   687.760e-6,   20.817e-6,  313.897e-6,    0.0,     0.0, -M_PI/2.0,      0.0},
+            {        0.010,       0,       0,        0,            0,           0,          0,            0,           0,           0, -0.041,     0.0,       0.0,      0.0}
+        };
+        return l[j];
+    }
+};
+
+
+/**
+* \ingroup iDynFixed
+*
+* Parameters of the torso as in iCubTorsoDyn("lower"), whose H0
+* is the identity.
+*/
+struct iCubTorsoDynModel
+{
+    static constexpr unsigned int N=3;
+
+    static constexpr double R0(const unsigned int r, const unsigned int c)
+    {
+        return (r==c) ? 1.0 : 0.0;
+    }
+
+    static constexpr iDynFixedLink link(const unsigned int j)
+    {
+        //                 m,       rcx,       rcy,        rcz,      Ixx,       Ixy,       Ixz,      Iyy,       Iyz,      Izz,       A,         D,     alpha,    offset
+        const iDynFixedLink l[N]={
+            {            0,  3.120e-2,         0,  -9.758e-7, 4.544e-4, -4.263e-5, -3.889e-8, 1.141e-3,  0.000e-0, 1.236e-3, 32.0e-3,         0,  M_PI/2.0,       0.0},
+            {            0,         0, +4.296e-5,  -1.360e-3, 5.308e-4, -1.923e-6,  5.095e-5, 2.031e-3, -3.849e-7, 1.803e-3,       0,   -5.5e-3,  M_PI/2.0, -M_PI/2.0},
+            {      4.81e+0, -8.102e-5, -1.183e-1,          0, 7.472e-2, -3.600e-6, -4.705e-5, 8.145e-2,  4.567e-3, 1.306e-2, 2.31e-3, -193.3e-3, -M_PI/2.0, -M_PI/2.0}
+        };
+        return l[j];
+    }
+};
+
+
+/**
+* \ingroup iDynFixed
+*
+* Right arm with torso, equivalent to iCubArmDyn("right").
+*/
+typedef iDynFixedLimb<iCubRightArmDynModel> iCubRightArmDynFixed;
+
+/**
+* \ingroup iDynFixed
+*
+* Left arm with torso, equivalent to iCubArmDyn("left").
+*/
+typedef iDynFixedLimb<iCubLeftArmDynModel> iCubLeftArmDynFixed;
+
+/**
+* \ingroup iDynFixed
+*
+* Right leg, equivalent to iCubLegDyn("right").
+*/
+typedef iDynFixedLimb<iCubRightLegDynModel> iCubRightLegDynFixed;
+
+/**
+* \ingroup iDynFixed
+*
+* Left leg, equivalent to iCubLegDyn("left").
+*/
+typedef iDynFixedLimb<iCubLeftLegDynModel> iCubLeftLegDynFixed;
+
+/**
+* \ingroup iDynFixed
+*
+* Torso, equivalent to iCubTorsoDyn("lower") in KINFWD_WREBWD
+* mode.
+*/
+typedef iDynFixedLimb<iCubTorsoDynModel> iCubTorsoDynFixed;
+
+}
+
+}
+
+#endif
+
+
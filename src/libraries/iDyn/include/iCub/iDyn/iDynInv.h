@@ -51,6 +51,7 @@
 #include <iCub/skinDynLib/common.h>
 #include <deque>
 #include <string>
+#include <vector>
 
 
 namespace iCub
@@ -94,6 +95,8 @@ const std::string ChainComputationMode_s[4] = {"Kinematic Forward - Wrench Forwa
 */
 class OneLinkNewtonEuler
 {
+    friend class OneChainNewtonEuler;
+
 protected:
 
     /// STATIC/DYNAMIC/DYNAMIC_W_ROTOR/DYNAMIC_CORIOLIS_GRAVITY
@@ -490,6 +493,8 @@ public:
 */
 class BaseLinkNewtonEuler : public OneLinkNewtonEuler
 {
+    friend class OneChainNewtonEuler;
+
 protected:
     ///initial angular velocity
     yarp::sig::Vector w;    
@@ -873,6 +878,31 @@ public:
 
 };
 
+/**
+* \ingroup RecursiveNewtonEuler
+*
+* Compact state of one frame of a OneChainNewtonEuler, stored 
+* contiguously and used by the allocation-free recursions. 
+* Matrices are row-major.
+*/
+struct NewEulLinkState
+{
+    /// rotation from the previous frame
+    double R[9];
+    /// distance from the previous frame, projected in the current frame
+    double r[3];
+    /// center of mass
+    double rc[3];
+    /// inertia matrix
+    double I[9];
+    /// rotor versor
+    double zm[3];
+    double m, dq, ddq;
+    double kr, Im, Fv, Fs;
+    double w[3], dw[3], dwM[3], ddp[3], ddpC[3];
+    double F[3], Mu[3];
+};
+
 /**
 * \ingroup RecursiveNewtonEuler
 *
@@ -901,6 +931,15 @@ protected:
     /// verbosity flag
     unsigned int verbose;
 
+    /// compact state of the frames, indexed as neChain
+    std::vector<NewEulLinkState> neState;
+
+    /**
+     * Copies the parameters and the current state of the i-th link
+     * into the compact state.
+     */
+    void loadLinkState(unsigned int i);
+
 public:
 
   /**
@@ -196,6 +196,8 @@ void iDynLink::clone(const iDynLink &c)
     F = c.getForce();
     Mu = c.getMoment();
     Tau = c.getTorque();
+    H_store.resize(4,4); R_store.resize(3,3);
+    r_store.resize(3); r_proj_store.resize(3);
     H_store_valid = false;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -394,7 +396,7 @@ void iDynLink::zero()
     Tau = 0.0;
     Im = 0.0; kr = 0.0; Fv = 0.0;   Fs = 0.0;
     HC = eye(4,4); RC = eye(3,3); rc = zeros(3);
-    H_store = eye(4,4); R_store = eye(3,3); r_store = zeros(3);
+    H_store = eye(4,4); R_store = eye(3,3); r_store = zeros(3); r_proj_store = zeros(3);
     H_store_valid = false;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -428,10 +430,16 @@ void iDynLink::updateHstore()
 {
     if(!H_store_valid)
     {
-        H_store = iKinLink::getH(true);
-        R_store = H_store.submatrix(0,2,0,2);
-        r_store = H_store.subcol(0,3,3);
-        r_proj_store = r_store*R_store;
+        // fill the stored quantities in place to avoid temporaries
+        fillH(H_store.data());
+        for(int i=0; i<3; i++)
+        {
+            for(int j=0; j<3; j++)
+                R_store(i,j) = H_store(i,j);
+            r_store[i] = H_store(i,3);
+        }
+        for(int j=0; j<3; j++)
+            r_proj_store[j] = r_store[0]*R_store(0,j) + r_store[1]*R_store(1,j) + r_store[2]*R_store(2,j);
         H_store_valid = true;
     }
 }
@@ -23,6 +23,7 @@
 
 #include <iCub/iDyn/iDyn.h>
 #include <iCub/iDyn/iDynBody.h>
+#include <iCub/ctrl/threadPool.h>
 
 using namespace std;
 using namespace yarp::os;
@@ -415,6 +416,7 @@ Matrix RigidBodyTransformation::getHCOM(unsigned int iLink)
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 iDynNode::iDynNode(const NewEulMode _mode)
 {
+    pool = NULL;
     rbtList.clear();
     mode = _mode;
     verbose = iCub::skinDynLib::VERBOSE;
@@ -424,12 +426,51 @@ iDynNode::iDynNode(const NewEulMode _mode)
 iDynNode::iDynNode(const string &_info, const NewEulMode _mode, unsigned int verb)
 {
     info=_info;
+    pool = NULL;
     rbtList.clear();
     mode = _mode;
     verbose = verb;
     zero();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+iDynNode::~iDynNode()
+{
+    delete pool; pool = NULL;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool iDynNode::setParallelMode(const bool enable, const unsigned int nThreads)
+{
+    delete pool; pool = NULL;
+
+    if(enable)
+    {
+        if(nThreads<2)
+        {
+            if(verbose)
+                fprintf(stderr,"iDynNode: error, the parallel mode requires at least 2 threads instead of %d. Keeping the sequential mode in the node <%s> \n",nThreads,info.c_str());
+            return false;
+        }
+        pool = new iCub::ctrl::ThreadPool(nThreads);
+    }
+    return true;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool iDynNode::isParallelMode() const
+{
+    return (pool!=NULL);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void iDynNode::runOnLimbs(const unsigned int n, const function<void(unsigned int)> &job)
+{
+    if((pool!=NULL) && (n>1))
+        pool->run(n,job);
+    else
+    {
+        for(unsigned int i=0; i<n; i++)
+            job(i);
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void iDynNode::zero()
 {
     w.resize(3); w.zero();
@@ -483,7 +524,8 @@ bool iDynNode::solveKinematics()
     if(inputNode==1)
     {
         //now forward the kinematic input from limbs whose kinematic flow is input type
-        for(unsigned int i=0; i<rbtList.size(); i++)
+        //these limbs only depend on the node, hence they can be solved concurrently
+        runOnLimbs((unsigned int)rbtList.size(),[this](unsigned int i)
         {
             if(rbtList[i].getKinematicFlow()==RBT_NODE_OUT)
             {
@@ -492,7 +534,7 @@ bool iDynNode::solveKinematics()
                 //solve kinematics in that limb/chain
                 rbtList[i].computeLimbKinematic();
             }
-        }
+        });
         return true;
     
     }
@@ -532,7 +574,8 @@ bool iDynNode::solveKinematics(const Vector &w0, const Vector &dw0, const Vector
     if(inputNode==1)
     {
         //now forward the kinematic input from limbs whose kinematic flow is input type
-        for(unsigned int i=0; i<rbtList.size(); i++)
+        //these limbs only depend on the node, hence they can be solved concurrently
+        runOnLimbs((unsigned int)rbtList.size(),[this](unsigned int i)
         {
             if(rbtList[i].getKinematicFlow()==RBT_NODE_OUT)
             {
@@ -541,7 +584,7 @@ bool iDynNode::solveKinematics(const Vector &w0, const Vector &dw0, const Vector
                 //solve kinematics in that limb/chain
                 rbtList[i].computeLimbKinematic();
             }
-        }
+        });
         return true;
     
     }
@@ -595,12 +638,19 @@ bool iDynNode::solveWrench()
     //first get the forces/moments from each limb
     //assuming that each limb has been properly set with the outcoming measured
     //forces/moments which are necessary for the wrench computation
+    //the wrench pass of each limb is independent from the others, so that the limbs
+    //can be solved concurrently and joined here, before the node summation
+    runOnLimbs((unsigned int)rbtList.size(),[this](unsigned int i)
+    {
+        if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)
+            //compute the wrench pass in that limb
+            rbtList[i].computeLimbWrench();
+    });
+
     for(unsigned int i=0; i<rbtList.size(); i++)
     {
         if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)         
         {
-            //compute the wrench pass in that limb
-            rbtList[i].computeLimbWrench();
             //update the node force/moment with the wrench coming from the limb base/end
             // note that getWrench sum the result to F,Mu - because they are passed by reference
             // F = F + F[i], Mu = Mu + Mu[i]
@@ -628,7 +678,7 @@ bool iDynNode::solveWrench()
     }
 
     //now forward the wrench output from the node to limbs whose wrench flow is output type
-    for(unsigned int i=0; i<rbtList.size(); i++)
+    runOnLimbs((unsigned int)rbtList.size(),[this](unsigned int i)
     {
         if(rbtList[i].getWrenchFlow()==RBT_NODE_OUT)
         {
@@ -637,7 +687,7 @@ bool iDynNode::solveWrench()
             //solve wrench in that limb/chain
             rbtList[i].computeLimbWrench();
         }
-    }
+    });
     return true;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -1358,9 +1408,11 @@ bool iDynSensorNode::solveWrench()
     //first get the forces/moments from each limb
     //assuming that each limb has been properly set with the outcoming measured
     //forces/moments which are necessary for the wrench computation
-    for(unsigned int i=0; i<rbtList.size(); i++)
+    //the wrench pass of each limb is independent from the others, so that the limbs
+    //can be solved concurrently and joined here, before the node summation
+    runOnLimbs((unsigned int)rbtList.size(),[this](unsigned int i)
     {
-        if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)         
+        if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)
         {
             //compute the wrench pass in that limb
             // if there's a sensor, we must use iDynSensor
@@ -1369,7 +1421,13 @@ bool iDynSensorNode::solveWrench()
                 sensorList[i]->computeWrenchFromSensorNewtonEuler();
             else
                 rbtList[i].computeLimbWrench();
+        }
+    });
 
+    for(unsigned int i=0; i<rbtList.size(); i++)
+    {
+        if(rbtList[i].getWrenchFlow()==RBT_NODE_IN)         
+        {
             //update the node force/moment with the wrench coming from the limb base/end
             // note that getWrench sum the result to F,Mu - because they are passed by reference
             // F = F + F[i], Mu = Mu + Mu[i]
@@ -1397,7 +1455,7 @@ bool iDynSensorNode::solveWrench()
 
     //now forward the wrench output from the node to limbs whose wrench flow is output type
     // assuming they don't have a FT sensor
-    for(unsigned int i=0; i<rbtList.size(); i++)
+    runOnLimbs((unsigned int)rbtList.size(),[this](unsigned int i)
     {
         if(rbtList[i].getWrenchFlow()==RBT_NODE_OUT)
         {
@@ -1406,7 +1464,7 @@ bool iDynSensorNode::solveWrench()
             //solve wrench in that limb/chain
             rbtList[i].computeLimbWrench();
         }
-    }
+    });
     return true;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -3030,3 +3088,12 @@ bool iCubWholeBody::EXPERIMENTAL_getCOMvelocity(BodyPart which_part, Vector &com
 
 
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool iCubWholeBody::setParallelMode(const bool enable, const unsigned int nThreads)
+{
+    bool ok = upperTorso->setParallelMode(enable,nThreads);
+    ok = ok && lowerTorso->setParallelMode(enable,nThreads);
+    if(!ok)
+        upperTorso->setParallelMode(false);
+    return ok;
+}
@@ -17,8 +17,11 @@
 */
 
 #include <iostream>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
 #include <iCub/iDyn/iDynContact.h>
-#include <yarp/math/SVD.h>
 #include <stdio.h>
 
 using namespace std;
@@ -30,18 +33,17 @@ using namespace iCub::ctrl;
 using namespace iCub::skinDynLib;
 
 
-
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // IDYN CONTACT SOLVER
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 iDynContactSolver::iDynContactSolver(iDynChain *_c, const string &_info, const NewEulMode _mode, BodyPart _bodyPart, unsigned int verb)
-:iDynSensor(_c, _info, _mode, verb), bodyPart(_bodyPart){}
+:iDynSensor(_c, _info, _mode, verb), bodyPart(_bodyPart), codRank(0), codValid(false){}
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 iDynContactSolver::iDynContactSolver(iDynChain *_c, unsigned int sensLink, SensorLinkNewtonEuler *sensor, 
                                     const string &_info, const NewEulMode _mode, BodyPart _bodyPart, unsigned int verb)
-:iDynSensor(_c, _info, _mode, verb), bodyPart(_bodyPart)
+:iDynSensor(_c, _info, _mode, verb), bodyPart(_bodyPart), codRank(0), codValid(false)
 {
     lSens = sensLink;
     sens = sensor;
@@ -49,7 +51,7 @@ iDynContactSolver::iDynContactSolver(iDynChain *_c, unsigned int sensLink, Senso
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 iDynContactSolver::iDynContactSolver(iDynChain *_c, unsigned int sensLink, const Matrix &_H, const Matrix &_HC, double _m, 
                                      const Matrix &_I, const string &_info, const NewEulMode _mode, BodyPart _bodyPart, unsigned int verb)
-:iDynSensor(_c, sensLink, _H, _HC, _m, _I, _info, _mode, verb), bodyPart(_bodyPart){}
+:iDynSensor(_c, sensLink, _H, _HC, _m, _I, _info, _mode, verb), bodyPart(_bodyPart), codRank(0), codValid(false){}
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 iDynContactSolver::~iDynContactSolver(){}
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -138,27 +140,31 @@ const dynContactList& iDynContactSolver::computeExternalContacts()
 
     // BUILD AND SOLVE THE LINEAR SYSTEM AX=B RELATIVE TO THE CONTACT SUB-CHAIN
     // the reference frame is the <firstContactLink-1> 
-    Matrix A = buildA(firstContactLink, lastContactLink);
-    Vector B = buildB(firstContactLink, lastContactLink);
-    Matrix pinv_A = pinv(A, TOLLERANCE);
-    Vector X = pinv_A * B;
+    computeSubChainH(firstContactLink, lastContactLink);
+    buildA(firstContactLink, lastContactLink);
+    buildB(firstContactLink, lastContactLink);
+    solveAXB();
     
     // SET THE COMPUTED VALUES IN THE CONTACT LIST
+    // (the rotation from the contact link to <firstContactLink-1> is the transpose of the cached one)
     unsigned int unknownInd = 0;
-    Matrix H, R;
+    Vector v(3);
     for(dynContactList::iterator it = contactList.begin(); it!=contactList.end(); it++)
     {
         if(it->isForceDirectionKnown())
             it->setForceModule( X(unknownInd++));
         else
         {
-            H = getHFromAtoB(it->getLinkNumber(), firstContactLink-1);
-            R = H.submatrix(0,2,0,2);
-            it->setForce( R * X.subVector(unknownInd, unknownInd+2));
+            const Matrix &H = getSubChainH(firstContactLink, it->getLinkNumber());
+            for(int i=0; i<3; i++)
+                v[i] = H(0,i)*X[unknownInd] + H(1,i)*X[unknownInd+1] + H(2,i)*X[unknownInd+2];
+            it->setForce(v);
             unknownInd += 3;
             if(!it->isMomentKnown())
             {
-                it->setMoment(R * X.subVector(unknownInd, unknownInd+2));
+                for(int i=0; i<3; i++)
+                    v[i] = H(0,i)*X[unknownInd] + H(1,i)*X[unknownInd+1] + H(2,i)*X[unknownInd+2];
+                it->setMoment(v);
                 unknownInd += 3;
             }
         }
@@ -185,10 +191,38 @@ void iDynContactSolver::computeWrenchFromSensorNewtonEuler()
     chain->NE->computeTorques();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-Matrix iDynContactSolver::buildA(unsigned int firstContactLink, unsigned int lastContactLink)
+void iDynContactSolver::computeSubChainH(unsigned int firstContactLink, unsigned int lastContactLink)
+{
+    // H from <firstContactLink-1> to each link is obtained from the one of the previous link,
+    // so that every link transform is multiplied only once; the matrices are kept across the
+    // estimates and the list only grows, so that nothing is allocated once the longest
+    // contact subchain has been met
+    size_t num = lastContactLink-firstContactLink+2;
+    if(subChainH.size()<num)
+        subChainH.resize(num, eye(4,4));
+    subChainH[0].eye();
+    for(unsigned int i=firstContactLink; i<=lastContactLink; i++)
+    {
+        const Matrix &Hprev = subChainH[i-firstContactLink];
+        const Matrix &Hlink = chain->refLink(i)->getH();
+        Matrix &H = subChainH[i-firstContactLink+1];
+        for(int r=0; r<4; r++)
+            for(int c=0; c<4; c++)
+                H(r,c) = Hprev(r,0)*Hlink(0,c) + Hprev(r,1)*Hlink(1,c) + Hprev(r,2)*Hlink(2,c) + Hprev(r,3)*Hlink(3,c);
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+const Matrix& iDynContactSolver::getSubChainH(unsigned int firstContactLink, unsigned int link) const
+{
+    return subChainH[link-firstContactLink+1];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+const Matrix& iDynContactSolver::buildA(unsigned int firstContactLink, unsigned int lastContactLink)
 {
     unsigned int unknownNum = getUnknownNumber();
-    Matrix A(6, unknownNum);
+    if(A.rows()!=6 || A.cols()!=unknownNum)
+        A.resize(6, unknownNum);
+    A.zero();
 
     // For each contact add some columns to A:
     //    * wrench: add 6 columns, 3 composed by I_3 above and the S(r_E) below, 3 composed by 0_3 above and I_3 below
@@ -196,39 +230,42 @@ Matrix iDynContactSolver::buildA(unsigned int firstContactLink, unsigned int las
     //    * force module: add 1 column composed by the force direction unit vector above and the cross product between 
     //          the contact point and the force direction unit vector below    
     unsigned int colInd = 0;
-    Matrix H, R;
-    Matrix eye3x3 = eye(3,3);
-    Matrix zero3x3 = zeros(3,3);
-    Vector r, temp1, temp2;
+    double p[3], d[3];
     dynContactList::const_iterator it = contactList.begin();
 
     for(; it!=contactList.end(); it++)
     {
-        // compute the rototranslation matrix from <firstContactLink-1> to the current link
-        H = getHFromAtoB(firstContactLink-1, it->getLinkNumber());
-        R = H.submatrix(0,2,0,2);
-        r = H.subcol(0,3,3);
+        // rototranslation matrix from <firstContactLink-1> to the current link
+        const Matrix &H = getSubChainH(firstContactLink, it->getLinkNumber());
+        const Vector &CoP = it->getCoP();
+        for(int i=0; i<3; i++)
+            p[i] = H(i,0)*CoP[0] + H(i,1)*CoP[1] + H(i,2)*CoP[2] + H(i,3);
 
         if(it->isForceDirectionKnown())
         {                    // 1 UNKNOWN: FORCE MODULE
-            temp1 = R*it->getForceDirection();       // force direction unit vector
-            temp2 = R*it->getCoP();
-            temp2 += r;
-            A.setSubcol(temp1, 0, colInd);
-            A.setSubcol(cross(temp2, temp1), 3, colInd++);
+            const Vector &Fdir = it->getForceDirection();
+            for(int i=0; i<3; i++)
+                d[i] = H(i,0)*Fdir[0] + H(i,1)*Fdir[1] + H(i,2)*Fdir[2];
+            for(int i=0; i<3; i++)
+                A(i,colInd) = d[i];
+            A(3,colInd) = p[1]*d[2] - p[2]*d[1];
+            A(4,colInd) = p[2]*d[0] - p[0]*d[2];
+            A(5,colInd) = p[0]*d[1] - p[1]*d[0];
+            colInd++;
         }
         else
         {                                              // 3 UNKNOWNS: FORCE
-            temp1 = R*it->getCoP();
-            temp1 += r;
-            A.setSubmatrix(eye3x3, 0, colInd);
-            A.setSubmatrix(crossProductMatrix(temp1), 3, colInd);
+            for(int i=0; i<3; i++)
+                A(i,colInd+i) = 1.0;
+            A(3,colInd+1) = -p[2];  A(3,colInd+2) =  p[1];
+            A(4,colInd)   =  p[2];  A(4,colInd+2) = -p[0];
+            A(5,colInd)   = -p[1];  A(5,colInd+1) =  p[0];
             colInd += 3;
             
             if(!it->isMomentKnown())
             {                       // 6 UNKNOWNS: FORCE AND MOMENT
-                A.setSubmatrix(zero3x3, 0, colInd);
-                A.setSubmatrix(eye3x3, 3, colInd);
+                for(int i=0; i<3; i++)
+                    A(3+i,colInd+i) = 1.0;
                 colInd += 3;
             }
         }
@@ -236,27 +273,36 @@ Matrix iDynContactSolver::buildA(unsigned int firstContactLink, unsigned int las
     return A;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-Vector iDynContactSolver::buildB(unsigned int firstContactLink, unsigned int lastContactLink)
+const Vector& iDynContactSolver::buildB(unsigned int firstContactLink, unsigned int lastContactLink)
 {
-    Matrix H, R;
-    Vector r;
+    // B is filled in place and the 3x3 products are expanded on plain arrays,
+    // so that no temporary matrix or vector is allocated at each estimate
+    if(B.size()!=6)
+        B.resize(6);
+    double *Bforce = B.data();
+    double *Bmoment = B.data()+3;
+    double f[3], v[3], R[3][3], r[3];
 
     // Initialize the force part of the B vector (first 3 components) as:
     //    * minus the force applied on the first link
     //    * plus the force exchanged by the last link on the next one
-    Matrix Hlast = getHFromAtoB(firstContactLink-1, lastContactLink);
-    Matrix Rlast = Hlast.submatrix(0,2,0,2);
-    Vector rLast = Hlast.subcol(0,3,3);
-    //Vector rLast = Hlast.submatrix(0,2,3,3).getCol(0);
-    Vector Bforce = Rlast * chain->getForce(lastContactLink); 
-    Bforce -= chain->getForce(firstContactLink-1);
+    const Matrix &Hlast = getSubChainH(firstContactLink, lastContactLink);
+    const Vector &Flast = chain->getForce(lastContactLink);
+    const Vector &Ffirst = chain->getForce(firstContactLink-1);
+    for(int i=0; i<3; i++)
+    {
+        f[i] = Hlast(i,0)*Flast[0] + Hlast(i,1)*Flast[1] + Hlast(i,2)*Flast[2];
+        Bforce[i] = f[i] - Ffirst[i];
+    }
 
     // For each link add the mass multiplied by the linear accelleration of the COM
     for(unsigned int i=firstContactLink; i<=lastContactLink; i++)
     {
-        H = getHFromAtoB(firstContactLink-1, i);
-        R = H.submatrix(0,2,0,2);
-        Bforce += chain->getMass(i) * R * chain->getLinAccCOM(i);
+        const Matrix &H = getSubChainH(firstContactLink, i);
+        const Vector &acc = chain->getLinAccCOM(i);
+        double m = chain->getMass(i);
+        for(int k=0; k<3; k++)
+            Bforce[k] += m * (H(k,0)*acc[0] + H(k,1)*acc[1] + H(k,2)*acc[2]);
     }
 
     // initialize the moment part (computed w.r.t. the begin of the first link) of the B vector (last 3 components) as:
@@ -264,9 +310,13 @@ Vector iDynContactSolver::buildB(unsigned int firstContactLink, unsigned int las
     //  * minus the moment applied on the first link
     //  * the displacement between the beginning of the first link and the end of the last link, 
     //    vector product the force exerted by the last link on the next one
-    Vector Bmoment = Rlast * chain->getMoment(lastContactLink);
-    Bmoment -= chain->getMoment(firstContactLink-1);
-    Bmoment += cross(rLast, Rlast* chain->getForce(lastContactLink));
+    const Vector &Mlast = chain->getMoment(lastContactLink);
+    const Vector &Mfirst = chain->getMoment(firstContactLink-1);
+    for(int i=0; i<3; i++)
+        Bmoment[i] = Hlast(i,0)*Mlast[0] + Hlast(i,1)*Mlast[1] + Hlast(i,2)*Mlast[2] - Mfirst[i];
+    Bmoment[0] += Hlast(1,3)*f[2] - Hlast(2,3)*f[1];
+    Bmoment[1] += Hlast(2,3)*f[0] - Hlast(0,3)*f[2];
+    Bmoment[2] += Hlast(0,3)*f[1] - Hlast(1,3)*f[0];
 
     // Then for each link add:
     //  * the gravitational contribution
@@ -277,17 +327,198 @@ Vector iDynContactSolver::buildB(unsigned int firstContactLink, unsigned int las
     {
         link = chain->refLink(i);
 
-        H = getHFromAtoB(firstContactLink-1, i);
-        H *= link->getCOM();
-        R = H.submatrix(0,2,0,2);
-        r = H.subcol(0,3,3);        // vector from <firstContactLink-1> to COM of i
-        
-        Bmoment += link->getMass() * cross(r, R * link->getLinAccC());
-        Bmoment += R * (link->getInertia() * link->getdW() +
-                                 cross(link->getW(), link->getInertia()*link->getW()));
+        // rotation and vector from <firstContactLink-1> to COM of i
+        const Matrix &H = getSubChainH(firstContactLink, i);
+        const Matrix &COM = link->getCOM();
+        for(int a=0; a<3; a++)
+        {
+            for(int b=0; b<3; b++)
+                R[a][b] = H(a,0)*COM(0,b) + H(a,1)*COM(1,b) + H(a,2)*COM(2,b);
+            r[a] = H(a,0)*COM(0,3) + H(a,1)*COM(1,3) + H(a,2)*COM(2,3) + H(a,3);
+        }
+
+        // mass * r x (R * linAccC)
+        const Vector &acc = link->getLinAccC();
+        double m = link->getMass();
+        for(int k=0; k<3; k++)
+            f[k] = m * (R[k][0]*acc[0] + R[k][1]*acc[1] + R[k][2]*acc[2]);
+        Bmoment[0] += r[1]*f[2] - r[2]*f[1];
+        Bmoment[1] += r[2]*f[0] - r[0]*f[2];
+        Bmoment[2] += r[0]*f[1] - r[1]*f[0];
+
+        // R * (I*dW + W x (I*W))
+        const Matrix &I = link->getInertia();
+        const Vector &w = link->getW();
+        const Vector &dw = link->getdW();
+        for(int k=0; k<3; k++)
+            f[k] = I(k,0)*w[0] + I(k,1)*w[1] + I(k,2)*w[2];
+        v[0] = w[1]*f[2] - w[2]*f[1];
+        v[1] = w[2]*f[0] - w[0]*f[2];
+        v[2] = w[0]*f[1] - w[1]*f[0];
+        for(int k=0; k<3; k++)
+            v[k] += I(k,0)*dw[0] + I(k,1)*dw[1] + I(k,2)*dw[2];
+        for(int k=0; k<3; k++)
+            Bmoment[k] += R[k][0]*v[0] + R[k][1]*v[1] + R[k][2]*v[2];
+    }
+
+    return B;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+const Vector& iDynContactSolver::solveAXB()
+{
+    // The minimum-norm least-squares solution comes from the complete orthogonal decomposition
+    // A*P = Q*[T 0; 0 0]*Z': a QR with column pivoting, whose R12 block is then annihilated from
+    // the right. Working on A itself, instead of the normal equations, does not square its
+    // condition number. A has 6 rows, hence at most 6 Householder reflections per side.
+    const unsigned int n = A.cols();
+    if(X.size()!=n)
+        X.resize(n);
+    if(codY.size()!=n)
+        codY.resize(n);
+
+    // the factorization is reused as long as A does not change (e.g. the robot is still)
+    if(!codValid || codA.rows()!=A.rows() || codA.cols()!=n ||
+       memcmp(codA.data(), A.data(), 6*n*sizeof(double))!=0)
+    {
+        if(codW.rows()!=6 || codW.cols()!=n)
+            codW.resize(6, n);
+        if(codPerm.size()!=n)
+            codPerm.resize(n);
+        double *W = codW.data();
+        memcpy(W, A.data(), 6*n*sizeof(double));
+        for(unsigned int j=0; j<n; j++)
+            codPerm[j] = j;
+
+        // Q: reflections I-tau*v*v' (v[k]=1) stored below the diagonal of R
+        const unsigned int kMax = (n<6 ? n : 6);
+        double cutoff = 0.0;
+        codRank = 0;
+        for(unsigned int k=0; k<kMax; k++)
+        {
+            // bring forward the column with the largest norm below row k
+            unsigned int piv = k;
+            double best = -1.0;
+            for(unsigned int j=k; j<n; j++)
+            {
+                double s = 0.0;
+                for(unsigned int i=k; i<6; i++)
+                    s += W[i*n+j]*W[i*n+j];
+                if(s>best)
+                {
+                    best = s;
+                    piv = j;
+                }
+            }
+            if(piv!=k)
+            {
+                for(unsigned int i=0; i<6; i++)
+                    swap(W[i*n+k], W[i*n+piv]);
+                swap(codPerm[k], codPerm[piv]);
+            }
+
+            // the rank is the number of diagonal elements of R above TOLLERANCE, as in pinv();
+            // the cutoff is raised to the rounding level of the factorization when A is badly scaled
+            double colNorm = sqrt(best);
+            if(k==0)
+                cutoff = max(TOLLERANCE, (n>6 ? n : 6)*numeric_limits<double>::epsilon()*colNorm);
+            if(colNorm<=cutoff)
+                break;
+
+            double x0 = W[k*n+k];
+            double beta = (x0>=0.0 ? -colNorm : colNorm);
+            double scale = 1.0/(x0-beta);
+            codTauQ[k] = (beta-x0)/beta;
+            for(unsigned int i=k+1; i<6; i++)
+                W[i*n+k] *= scale;
+            W[k*n+k] = beta;
+            for(unsigned int j=k+1; j<n; j++)
+            {
+                double s = W[k*n+j];
+                for(unsigned int i=k+1; i<6; i++)
+                    s += W[i*n+k]*W[i*n+j];
+                s *= codTauQ[k];
+                W[k*n+j] -= s;
+                for(unsigned int i=k+1; i<6; i++)
+                    W[i*n+j] -= s*W[i*n+k];
+            }
+            codRank++;
+        }
+
+        // Z: reflections I-tau*z*z' acting on the columns k and r..n-1 (z[k]=1), stored
+        // in place of R12, so that [R11 R12] = [T 0]*Z'
+        const unsigned int r = codRank;
+        for(int k=(int)r-1; (k>=0) && (r<n); k--)
+        {
+            double x0 = W[k*n+k];
+            double s2 = x0*x0;
+            for(unsigned int j=r; j<n; j++)
+                s2 += W[k*n+j]*W[k*n+j];
+            double beta = (x0>=0.0 ? -sqrt(s2) : sqrt(s2));
+            double scale = 1.0/(x0-beta);
+            codTauZ[k] = (beta-x0)/beta;
+            for(unsigned int j=r; j<n; j++)
+                W[k*n+j] *= scale;
+            W[k*n+k] = beta;
+            for(int i=0; i<k; i++)
+            {
+                double s = W[i*n+k];
+                for(unsigned int j=r; j<n; j++)
+                    s += W[i*n+j]*W[k*n+j];
+                s *= codTauZ[k];
+                W[i*n+k] -= s;
+                for(unsigned int j=r; j<n; j++)
+                    W[i*n+j] -= s*W[k*n+j];
+            }
+        }
+
+        codA = A;
+        codValid = true;
+    }
+
+    const unsigned int r = codRank;
+    const double *W = codW.data();
+    double *y = codY.data();
+
+    // c = Q'*B (only the first r components are needed)
+    double c[6];
+    for(int i=0; i<6; i++)
+        c[i] = B[i];
+    for(unsigned int k=0; k<r; k++)
+    {
+        double s = c[k];
+        for(unsigned int i=k+1; i<6; i++)
+            s += W[i*n+k]*c[i];
+        s *= codTauQ[k];
+        c[k] -= s;
+        for(unsigned int i=k+1; i<6; i++)
+            c[i] -= s*W[i*n+k];
+    }
+
+    // T*w = c by back substitution, then y = Z*[w; 0]
+    for(unsigned int j=0; j<n; j++)
+        y[j] = 0.0;
+    for(int k=(int)r-1; k>=0; k--)
+    {
+        double s = c[k];
+        for(unsigned int j=k+1; j<r; j++)
+            s -= W[k*n+j]*y[j];
+        y[k] = s/W[k*n+k];
+    }
+    for(unsigned int k=0; (k<r) && (r<n); k++)
+    {
+        double s = y[k];
+        for(unsigned int j=r; j<n; j++)
+            s += W[k*n+j]*y[j];
+        s *= codTauZ[k];
+        y[k] -= s;
+        for(unsigned int j=r; j<n; j++)
+            y[j] -= s*W[k*n+j];
     }
 
-    return cat(Bforce, Bmoment);
+    // X = P*y
+    for(unsigned int j=0; j<n; j++)
+        X[codPerm[j]] = y[j];
+    return X;
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 const dynContactList& iDynContactSolver::getContactList() const
@@ -1669,6 +1669,46 @@ string SensorLinkNewtonEuler::getType() const
 //
 //================================
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// helpers of the allocation-free recursion on 3-vectors and 3x3 row-major matrices
+static inline void mul3(const double *R, const double *v, double *out)
+{
+    out[0] = R[0]*v[0] + R[1]*v[1] + R[2]*v[2];
+    out[1] = R[3]*v[0] + R[4]*v[1] + R[5]*v[2];
+    out[2] = R[6]*v[0] + R[7]*v[1] + R[8]*v[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline void mul3T(const double *R, const double *v, double *out)
+{
+    out[0] = v[0]*R[0] + v[1]*R[3] + v[2]*R[6];
+    out[1] = v[0]*R[1] + v[1]*R[4] + v[2]*R[7];
+    out[2] = v[0]*R[2] + v[1]*R[5] + v[2]*R[8];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline void cross3(const double *a, const double *b, double *out)
+{
+    out[0] = a[1]*b[2] - a[2]*b[1];
+    out[1] = a[2]*b[0] - a[0]*b[2];
+    out[2] = a[0]*b[1] - a[1]*b[0];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline void copy3(const Vector &v, double *out)
+{
+    out[0] = v[0]; out[1] = v[1]; out[2] = v[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline void copy3(const double *v, Vector &out)
+{
+    out[0] = v[0]; out[1] = v[1]; out[2] = v[2];
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+static inline void copy3x3(const Matrix &M, double *out)
+{
+    for(int i=0; i<3; i++)
+        for(int j=0; j<3; j++)
+            out[3*i+j] = M(i,j);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 OneChainNewtonEuler::OneChainNewtonEuler(iDynChain *_c, string _info, const NewEulMode _mode, unsigned int verb)
 {
@@ -1708,6 +1748,8 @@ OneChainNewtonEuler::OneChainNewtonEuler(iDynChain *_c, string _info, const NewE
     //the end effector is the last (nLinks+2-1 because it's an index)
     nEndEff = nLinks+1;
 
+    //the compact state is sized once and for all
+    neState.resize(nLinks+2);
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 OneChainNewtonEuler::~OneChainNewtonEuler()
@@ -1847,12 +1889,86 @@ NewEulMode  OneChainNewtonEuler::getMode()      const       {return mode;}
     //   main computation methods
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void OneChainNewtonEuler::loadLinkState(unsigned int i)
+{
+    iDynLink *l = neChain[i]->link;
+    NewEulLinkState &s = neState[i];
+
+    copy3x3(l->getR(),s.R);
+    copy3(l->r_proj_store,s.r);
+    copy3(l->rc,s.rc);
+    copy3x3(l->I,s.I);
+    copy3(neChain[i]->zm,s.zm);
+    s.m = l->m;     s.dq = l->dq;   s.ddq = l->ddq;
+    s.kr = l->kr;   s.Im = l->Im;   s.Fv = l->Fv;   s.Fs = l->Fs;
+    copy3(l->w,s.w);
+    copy3(l->dw,s.dw);
+    copy3(l->dwM,s.dwM);
+    copy3(l->ddp,s.ddp);
+    copy3(l->ddpC,s.ddpC);
+}
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void OneChainNewtonEuler::ForwardKinematicFromBase()
 {
-    for(unsigned int i=1;i<nEndEff;i++)
+    // same as calling neChain[i]->ForwardKinematics(neChain[i-1]) for
+    // each link, but on the compact state and without temporaries
+    NewEulLinkState *s = neState.data();
+    copy3(neChain[0]->getAngVel(),s[0].w);
+    copy3(neChain[0]->getAngAcc(),s[0].dw);
+    copy3(neChain[0]->getLinAcc(),s[0].ddp);
+
+    double v[3], c[3], cc[3];
+    for(unsigned int i=1; i<nEndEff; i++)
     {
-        neChain[i]->ForwardKinematics(neChain[i-1]);
+        loadLinkState(i);
+        NewEulLinkState &cur = s[i];
+        const NewEulLinkState &prev = s[i-1];
+
+        switch(mode)
+        {
+        case DYNAMIC:
+        case DYNAMIC_W_ROTOR:
+        case DYNAMIC_CORIOLIS_GRAVITY:
+            {
+                v[0] = prev.w[0]; v[1] = prev.w[1]; v[2] = prev.w[2] + cur.dq;
+                mul3T(cur.R,v,cur.w);
+
+                v[0] = prev.dw[0] + cur.dq*prev.w[1];
+                v[1] = prev.dw[1] - cur.dq*prev.w[0];
+                v[2] = prev.dw[2] + (mode==DYNAMIC_CORIOLIS_GRAVITY ? 0.0 : cur.ddq);
+                mul3T(cur.R,v,cur.dw);
+
+                mul3T(cur.R,prev.ddp,cur.ddp);
+                cross3(cur.dw,cur.r,c);
+                cross3(cur.w,cur.r,v);
+                cross3(cur.w,v,cc);
+                for(int k=0; k<3; k++)
+                    cur.ddp[k] += c[k] + cc[k];
+
+                cross3(cur.dw,cur.rc,c);
+                cross3(cur.w,cur.rc,v);
+                cross3(cur.w,v,cc);
+                for(int k=0; k<3; k++)
+                    cur.ddpC[k] = cur.ddp[k] + c[k] + cc[k];
+                break;
+            }
+        case STATIC:
+            {
+                for(int k=0; k<3; k++)
+                    cur.w[k] = cur.dw[k] = 0.0;
+                mul3T(cur.R,prev.ddp,cur.ddp);
+                for(int k=0; k<3; k++)
+                    cur.ddpC[k] = cur.ddp[k];
+                break;
+            }
+        }
+
+        iDynLink *l = neChain[i]->link;
+        copy3(cur.w,l->w);
+        copy3(cur.dw,l->dw);
+        copy3(cur.ddp,l->ddp);
+        copy3(cur.ddpC,l->ddpC);
     }
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -1881,12 +1997,88 @@ void OneChainNewtonEuler::BackwardKinematicFromEnd(const Vector &_w, const Vecto
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void OneChainNewtonEuler::BackwardWrenchFromEnd()
-{    
-    for(int i=nEndEff-1; i>=0; i--)
-        neChain[i]->BackwardWrench(neChain[i+1]);
+{
+    // same as calling neChain[i]->BackwardWrench(neChain[i+1]) and then
+    // neChain[i]->computeTorque(neChain[i-1]) for each link, but on the
+    // compact state and without temporaries
+    NewEulLinkState *s = neState.data();
+    for(unsigned int i=1; i<nEndEff; i++)
+        loadLinkState(i);
 
-    for(int i=nEndEff-1; i>0; i--)
-        neChain[i]->computeTorque(neChain[i-1]);
+    // the final frame carries no inertial contributions and it is not
+    // rotated with respect to the last link
+    copy3(neChain[nEndEff]->getForce(),s[nEndEff-1].F);
+    copy3(neChain[nEndEff]->getMoment(false),s[nEndEff-1].Mu);
+
+    double v[3], u[3], c[3];
+    for(int i=nEndEff-2; i>=0; i--)
+    {
+        NewEulLinkState &cur = s[i];
+        const NewEulLinkState &next = s[i+1];
+
+        for(int k=0; k<3; k++)
+            v[k] = next.m*next.ddpC[k] + next.F[k];
+        mul3(next.R,v,cur.F);
+
+        cross3(next.r,next.F,v);
+        for(int k=0; k<3; k++)
+        {
+            u[k] = next.r[k] + next.rc[k];
+            c[k] = next.m*next.ddpC[k];
+        }
+        double tmp[3];
+        cross3(u,c,tmp);
+        for(int k=0; k<3; k++)
+            v[k] += tmp[k] + next.Mu[k];
+
+        if(mode!=STATIC)
+        {
+            mul3(next.I,next.dw,u);
+            for(int k=0; k<3; k++)
+                v[k] += u[k];
+            mul3(next.I,next.w,u);
+            cross3(next.w,u,c);
+            for(int k=0; k<3; k++)
+                v[k] += c[k];
+        }
+
+        mul3(next.R,v,cur.Mu);
+
+        if(mode==DYNAMIC_W_ROTOR)
+        {
+            cross3(next.w,next.zm,c);
+            for(int k=0; k<3; k++)
+                cur.Mu[k] += next.kr*next.ddq*next.Im*next.zm[k] + next.kr*next.dq*next.Im*c[k];
+        }
+    }
+
+    // write back the wrenches: the base rotates them through H0
+    for(unsigned int i=1; i<nEndEff; i++)
+    {
+        iDynLink *l = neChain[i]->link;
+        copy3(s[i].F,l->F);
+        copy3(s[i].Mu,l->Mu);
+    }
+
+    BaseLinkNewtonEuler *base = static_cast<BaseLinkNewtonEuler*>(neChain[0]);
+    if(base->Mu0.length()!=3)
+        base->Mu0.resize(3);
+    for(int k=0; k<3; k++)
+    {
+        base->F[k] = base->H0(k,0)*s[0].F[0] + base->H0(k,1)*s[0].F[1] + base->H0(k,2)*s[0].F[2];
+        base->Mu[k] = base->H0(k,0)*s[0].Mu[0] + base->H0(k,1)*s[0].Mu[1] + base->H0(k,2)*s[0].Mu[2];
+    }
+    copy3(s[0].Mu,base->Mu0);
+
+    for(unsigned int i=nEndEff-1; i>0; i--)
+    {
+        const NewEulLinkState &cur = s[i];
+        double Tau = s[i-1].Mu[2];
+        if(mode==DYNAMIC_W_ROTOR)
+            Tau += cur.kr*cur.Im*(cur.dwM[0]*cur.zm[0] + cur.dwM[1]*cur.zm[1] + cur.dwM[2]*cur.zm[2])
+                   + cur.Fv*cur.dq + cur.Fs*sign(cur.dq);
+        neChain[i]->link->Tau = Tau;
+    }
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 void OneChainNewtonEuler::computeTorques()
@@ -55,6 +55,7 @@
 
 #include <string>
 #include <deque>
+#include <vector>
 
 #include <yarp/os/Property.h>
 #include <yarp/dev/ControlBoardInterfaces.h>
@@ -118,6 +119,8 @@ protected:
     void         release()          { blocked=false;              }
     void         rmCumH()           { cumulative=false;           }
     void         addCumH(const yarp::sig::Matrix &_cumH);
+    void         fillH(double *_H) const;
+    void         fillDH(double *_DH) const;
 
 public:
     /**
@@ -370,6 +373,19 @@ protected:
     yarp::sig::Matrix hess_J;
     yarp::sig::Matrix hess_Jlnk;
 
+    // whole Hessian tensor filled by prepareForHessian():
+    // d2F/dqidqj is stored at hess_H[6*(i*DOF+j)]
+    std::vector<double> hess_H;
+
+    // row-major 4x4 storage for the allocation-free path;
+    // fast_fwdH keeps the prefix transforms along with the DH
+    // parameters they were computed with (fast_DH), so that only
+    // the links following the first changed one get recomputed
+    std::vector<double> fast_H;
+    std::vector<double> fast_fwdH;
+    std::vector<double> fast_bwdH;
+    std::vector<double> fast_DH;
+
     virtual void clone(const iKinChain &c);
     virtual void build();
     virtual void dispose();
@@ -378,6 +394,13 @@ protected:
     yarp::sig::Vector dRotAng(const yarp::sig::Matrix &R, const yarp::sig::Matrix &dR);
     yarp::sig::Vector d2RotAng(const yarp::sig::Matrix &R, const yarp::sig::Matrix &dRi,
                                const yarp::sig::Matrix &dRj, const yarp::sig::Matrix &d2R);
+    void              fastForward();
+    void              fastBackward();
+    void              batchChunk(const yarp::sig::Matrix &Q, const size_t k0, const size_t k1,
+                                 yarp::sig::Matrix *X, const bool axisRep,
+                                 std::deque<yarp::sig::Matrix> *J) const;
+    void              batchRun(const yarp::sig::Matrix &Q, yarp::sig::Matrix *X, const bool axisRep,
+                               std::deque<yarp::sig::Matrix> *J, const unsigned int nThreads) const;
 
 public:
     /**
@@ -751,6 +774,88 @@ public:
     */
     yarp::sig::Matrix GeoJacobian(const yarp::sig::Vector &q);
 
+    /**
+    * Computes the rigid roto-translation matrix from the root 
+    * reference frame to the end-effector frame (HN is taken into 
+    * account) without any heap allocation. 
+    * @param H is the output 4x4 matrix; it is resized only if its 
+    *          dimensions are not already correct.
+    * @note Same result as getH(), meant for high-rate loops.
+    */
+    void fastGetH(yarp::sig::Matrix &H);
+
+    /**
+    * Computes the geometric Jacobian of the end-effector without 
+    * any heap allocation. 
+    * @param J is the output 6xDOF matrix; it is resized only if 
+    *          its dimensions are not already correct.
+    * @note Same result as GeoJacobian(), meant for high-rate loops.
+    */
+    void fastGeoJacobian(yarp::sig::Matrix &J);
+
+    /**
+    * Computes the analitical Jacobian of the end-effector without 
+    * any heap allocation. 
+    * @param J is the output 6xDOF matrix; it is resized only if 
+    *          its dimensions are not already correct.
+    * @param col selects the part of the derived homogeneous matrix 
+    *            to be put in the upper side of the Jacobian
+    *            matrix: 0 => x, 1 => y, 2 => z, 3 => p (default)
+    * @note Same result as AnaJacobian(), but the cost grows 
+    *       linearly with the number of links.
+    */
+    void fastAnaJacobian(yarp::sig::Matrix &J, unsigned int col=3);
+
+    /**
+    * Computes the end-effector poses for a batch of joint 
+    * configurations. 
+    * @param Q is the DOFxM matrix whose columns are the M 
+    *          configurations to evaluate, so that the values of
+    *          each DOF are stored contiguously (structure of
+    *          arrays).
+    * @param X is the output matrix containing one pose per column:
+    *          7xM with axis/angle notation, 6xM with Euler angles.
+    * @param axisRep if true returns the axis/angle notation. 
+    * @param nThreads is the number of threads the batch is split 
+    *                 across (1 by default, meaning that the
+    *                 computation takes place in the caller thread).
+    * @note The chain state is not affected: joint limits are 
+    *       enforced as setAng() would do and blocked links keep
+    *       their current values. Links must not be modified while
+    *       the call is in progress.
+    */
+    void batchEndEffPose(const yarp::sig::Matrix &Q, yarp::sig::Matrix &X,
+                         const bool axisRep=true, const unsigned int nThreads=1) const;
+
+    /**
+    * Computes the geometric Jacobians of the end-effector for a 
+    * batch of joint configurations. 
+    * @param Q is the DOFxM matrix whose columns are the M 
+    *          configurations to evaluate.
+    * @param J is the output list of M 6xDOF geometric Jacobians. 
+    * @param nThreads is the number of threads the batch is split 
+    *                 across (1 by default).
+    * @see batchEndEffPose
+    */
+    void batchGeoJacobian(const yarp::sig::Matrix &Q, std::deque<yarp::sig::Matrix> &J,
+                          const unsigned int nThreads=1) const;
+
+    /**
+    * Computes both the end-effector poses and the geometric 
+    * Jacobians for a batch of joint configurations sharing one 
+    * single forward pass. 
+    * @param Q is the DOFxM matrix of configurations. 
+    * @param X is the output matrix of poses. 
+    * @param J is the output list of geometric Jacobians. 
+    * @param axisRep if true returns the axis/angle notation. 
+    * @param nThreads is the number of threads the batch is split 
+    *                 across (1 by default).
+    * @see batchEndEffPose
+    */
+    void batchEndEffPose(const yarp::sig::Matrix &Q, yarp::sig::Matrix &X,
+                         std::deque<yarp::sig::Matrix> &J, const bool axisRep=true,
+                         const unsigned int nThreads=1) const;
+
     /**
     * Returns the 6x1 vector \f$ 
     * \partial{^2}F\left(q\right)/\partial q_i \partial q_j, \f$
@@ -766,8 +871,11 @@ public:
 
     /**
     * Prepares computation for a successive call to 
-    * fastHessian_ij(). 
-    * @see fastHessian_ij
+    * fastHessian_ij() and fastDJacobian(). 
+    * The geometric Jacobian and the whole Hessian tensor are 
+    * computed in one go, evaluating each cross product only once.
+    * @see fastHessian_ij 
+    * @see fastDJacobian 
     */
     void prepareForHessian();
 
@@ -789,6 +897,16 @@ public:
     */
     yarp::sig::Vector fastHessian_ij(const unsigned int i, const unsigned int j);
 
+    /**
+    * Same as fastHessian_ij() but without any heap allocation. 
+    * @param i is the index of the first DOF. 
+    * @param j is the index of the second DOF.
+    * @param h is the output 6x1 vector; it is resized only if its 
+    *          length is not already correct.
+    * @see prepareForHessian
+    */
+    void fastHessian_ij(const unsigned int i, const unsigned int j, yarp::sig::Vector &h);
+
     /**
     * Returns the 6x1 vector \f$ 
     * \partial{^2}F\left(q\right)/\partial q_i \partial q_j, \f$
@@ -846,6 +964,19 @@ public:
     */
     yarp::sig::Matrix DJacobian(const yarp::sig::Vector &dq);
 
+    /**
+    * Compute the time derivative of the geometric Jacobian. 
+    * <i>Fast Version</i>: to be used in conjunction with 
+    * prepareForHessian(), thus sharing with fastHessian_ij() 
+    * the quantities computed for the current configuration. 
+    * @param dq the joint velocities.
+    * @return the 6xDOF matrix \f$ 
+    *         \partial{^2}F\left(q\right)/\partial t \partial q.
+    *                 \f$
+    * @see prepareForHessian
+    */
+    yarp::sig::Matrix fastDJacobian(const yarp::sig::Vector &dq);
+
     /**
     * Compute the time derivative of the geometric Jacobian
     * (link version).
@@ -26,6 +26,8 @@
 #ifndef __IKINIPOPT_H__
 #define __IKINIPOPT_H__
 
+#include <atomic>
+
 #include <iCub/iKin/iKinInv.h>
 
 
@@ -111,6 +113,14 @@ public:
     */
     virtual iKinLinIneqConstr &operator=(const iKinLinIneqConstr &obj);
 
+    /**
+    * Creates a copy of the current object preserving its dynamic 
+    * type. 
+    * @return a pointer to the new object, which is to be deleted 
+    *         by the caller.
+    */
+    virtual iKinLinIneqConstr *duplicate() const;
+
     /**
     * Returns a reference to the constraints matrix C.
     * @return constraints matrix C. 
@@ -186,6 +196,7 @@ public:
     */
     iCubAdditionalArmConstraints(iCubArm &arm);
 
+    iKinLinIneqConstr *duplicate() const;
     void update(void*);
 };
 
@@ -223,6 +234,18 @@ protected:
     double upperBoundInf;
     std::string posePriority;
 
+    bool   warmStart;
+    double maxWallTime;
+    yarp::sig::Vector warm_zL;
+    yarp::sig::Vector warm_zU;
+    yarp::sig::Vector warm_lambda;
+
+    yarp::sig::Vector optimize(const yarp::sig::Vector &q0, yarp::sig::Vector &xd,
+                               double weight2ndTask, yarp::sig::Vector &xd_2nd, yarp::sig::Vector &w_2nd,
+                               double weight3rdTask, yarp::sig::Vector &qd_3rd, yarp::sig::Vector &w_3rd,
+                               int *exit_code, bool *exhalt, std::atomic<bool> *exhaltAtomic,
+                               iKinIterateCallback *iterate);
+
 public:
     /**
     * Constructor. 
@@ -335,6 +358,43 @@ public:
     */ 
     double getMaxCpuTime() const;
 
+    /**
+    * Sets Maximum wall-clock seconds allowed for each call to 
+    * solve(). 
+    * @param max_wall_time exits returning the current iterate if 
+    *                      the elapsed time exceeds max_wall_time
+    *                      given in seconds; the exit code is then
+    *                      USER_REQUESTED_STOP (a non-positive value
+    *                      disables the check, as at start-up).
+    * @note Differently from setMaxCpuTime(), the check relies on a 
+    *       monotonic clock and does not depend on the CPU load.
+    */ 
+    void setMaxWallTime(const double max_wall_time) { maxWallTime=max_wall_time; }
+
+    /**
+    * Retrieves the current value of Maximum wall-clock seconds.
+    * @return max_wall_time.
+    */ 
+    double getMaxWallTime() const { return maxWallTime; }
+
+    /**
+    * Enables/disables the warm-start mode (disabled at start-up). 
+    * When enabled, the dual variables of the last successful 
+    * solution are used to initialize the next call to solve(), 
+    * which typically converges in much fewer iterations when the 
+    * new target is close to the previous one. The primal variables 
+    * are initialized with q0 as usual, thus the caller should pass 
+    * the previous solution to fully warm-start the problem. 
+    * @param enable true to enable the warm-start mode.
+    */
+    void setWarmStart(const bool enable);
+
+    /**
+    * Returns the status of the warm-start mode.
+    * @return true if the warm-start mode is enabled.
+    */
+    bool getWarmStart() const { return warmStart; }
+
     /**
     * Sets cost function tolerance.
     * @param tol tolerance.
@@ -454,6 +514,19 @@ public:
                                     double weight3rdTask, yarp::sig::Vector &qd_3rd, yarp::sig::Vector &w_3rd,
                                     int *exit_code=NULL, bool *exhalt=NULL, iKinIterateCallback *iterate=NULL);
 
+    /**
+    * Executes the IpOpt algorithm trying to converge on target, as 
+    * the solve() above, with the difference that the external 
+    * request to exit is an atomic flag, which can be safely raised 
+    * by another thread while the optimization is running. 
+    * @param exhalt checked for an external request to exit. 
+    * @return estimated joint angles. 
+    */
+    virtual yarp::sig::Vector solve(const yarp::sig::Vector &q0, yarp::sig::Vector &xd,
+                                    double weight2ndTask, yarp::sig::Vector &xd_2nd, yarp::sig::Vector &w_2nd,
+                                    double weight3rdTask, yarp::sig::Vector &qd_3rd, yarp::sig::Vector &w_3rd,
+                                    int *exit_code, std::atomic<bool> &exhalt, iKinIterateCallback *iterate=NULL);
+
     /**
     * Executes the IpOpt algorithm trying to converge on target. 
     * @param q0 is the vector of initial joint angles values. 
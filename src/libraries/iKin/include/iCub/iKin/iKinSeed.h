@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+/**
+ * \defgroup iKinSeed iKinSeed
+ *
+ * @ingroup iKin
+ *
+ * Precomputed reachability map providing initial guesses to the
+ * inverse kinematics solvers.
+ *
+ */
+
+#ifndef __IKINSEED_H__
+#define __IKINSEED_H__
+
+#include <string>
+#include <vector>
+
+#include <yarp/sig/Vector.h>
+
+#include <iCub/iKin/iKinFwd.h>
+
+
+namespace iCub
+{
+
+namespace iKin
+{
+
+/**
+* \ingroup iKinSeed
+*
+* Map from end-effector poses to joint configurations of a chain.
+* Poses are obtained by sampling the joints space and are
+* arranged in a uniform grid over the end-effector position, so
+* that the configuration lying closest to a given target can be
+* retrieved by visiting the neighbouring cells only.
+*
+* The map is meant to be built offline with build(), stored with
+* save() and loaded at start-up with load().
+*
+* \note Configurations refer to the DOF of the chain, whereas
+*       blocked links are kept at the values they had when the
+*       map was built.
+*/
+class iKinSeedMap
+{
+protected:
+    unsigned int N;
+    double       cellSize;
+    double       origin[3];
+    int          dims[3];
+
+    // per-cell entries in compressed form: entries of cell c lie
+    // within [cellStart[c],cellStart[c+1]); each entry stores the
+    // end-effector position, its rotation matrix and the N joints
+    std::vector<unsigned int> cellStart;
+    std::vector<float>        entries;
+
+    size_t stride() const { return 12+N; }
+    bool   getCell(const double *x, int *cell) const;
+
+public:
+    /**
+    * Default constructor.
+    */
+    iKinSeedMap();
+
+    /**
+    * Builds the map by sampling uniformly the joints space of the
+    * chain within the joints bounds.
+    * @param chain is the chain the map refers to; its state is not
+    *              affected.
+    * @param numSamples is the number of configurations to sample.
+    * @param _cellSize is the size of the grid cell in meters.
+    * @param maxPerCell is the maximum number of configurations
+    *                   retained within a cell.
+    * @param seed is the seed of the random number generator.
+    * @return true/false on success/failure.
+    */
+    bool build(iKinChain &chain, const unsigned int numSamples,
+               const double _cellSize=0.02, const unsigned int maxPerCell=16,
+               const unsigned int seed=0);
+
+    /**
+    * Stores the map in a binary file.
+    * @param fileName is the name of the file.
+    * @return true/false on success/failure.
+    * @note The file uses the native byte ordering.
+    */
+    bool save(const std::string &fileName) const;
+
+    /**
+    * Loads the map from a binary file previously created with
+    * save().
+    * @param fileName is the name of the file.
+    * @return true/false on success/failure.
+    */
+    bool load(const std::string &fileName);
+
+    /**
+    * Returns the number of DOF of the chain the map refers to.
+    * @return number of DOF (0 if the map is empty).
+    */
+    unsigned int getN() const { return N; }
+
+    /**
+    * Returns the number of configurations stored in the map.
+    * @return number of configurations.
+    */
+    size_t size() const { return (N>0 ? entries.size()/stride() : 0); }
+
+    /**
+    * Checks whether the map contains any configuration.
+    * @return true if the map is empty.
+    */
+    bool isEmpty() const { return (size()==0); }
+
+    /**
+    * Returns the distance between two poses used to rank the
+    * configurations.
+    * @param xd is the target pose, either in the 3x1 form
+    *           (position only) or 7x1 form (axis/angle notation).
+    * @param x is the pose to be compared.
+    * @param orientationWeight weights the orientation error with
+    *                          respect to the squared position
+    *                          error.
+    * @return the distance.
+    */
+    static double distance(const yarp::sig::Vector &xd, const yarp::sig::Vector &x,
+                           const double orientationWeight=0.01);
+
+    /**
+    * Retrieves the stored configuration whose end-effector pose is
+    * the closest to the target.
+    * @param xd is the target pose, either in the 3x1 form
+    *           (position only) or 7x1 form (axis/angle notation).
+    * @param q is the Nx1 output configuration.
+    * @param orientationWeight weights the orientation error with
+    *                          respect to the squared position
+    *                          error.
+    * @return true if a configuration was found in the
+    *         neighbourhood of the target.
+    */
+    bool getSeed(const yarp::sig::Vector &xd, yarp::sig::Vector &q,
+                 const double orientationWeight=0.01) const;
+};
+
+}
+
+}
+
+#endif
+
+
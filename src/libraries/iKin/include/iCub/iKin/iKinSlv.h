@@ -237,8 +237,11 @@ given rest
 #ifndef __IKINSLV_H__
 #define __IKINSLV_H__
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
+#include <random>
 #include <string>
 #include <deque>
 
@@ -252,6 +255,7 @@ given rest
 
 #include <iCub/iKin/iKinHlp.h>
 #include <iCub/iKin/iKinIpOpt.h>
+#include <iCub/iKin/iKinSeed.h>
 
 
 namespace iCub
@@ -336,6 +340,18 @@ struct PartDescriptor
 };
 
 
+struct MultiStartWorker
+{
+    iKinLimb          *lmb;
+    iKinLinIneqConstr *lic;
+    iKinIpOptMin      *slv;
+    yarp::sig::Vector  q0;
+    yarp::sig::Vector  q;
+    int                exit_code;
+    std::thread        thr;
+};
+
+
 /**
 * \ingroup iKinSlv
 *
@@ -395,10 +411,33 @@ protected:
     yarp::sig::Vector w_3rdTask;
     yarp::sig::Vector idx_3rdTask;
 
+    iKinSeedMap seedMap;
+
+    std::deque<MultiStartWorker*> msWorkers;
+    std::mutex                    mtx_ms;
+    std::condition_variable       cv_msStart;
+    std::condition_variable       cv_msDone;
+    std::mt19937                  msRand;
+    yarp::sig::Vector             msXd;
+    unsigned int                  msJob;
+    unsigned int                  msPending;
+    int                           msWinner;
+    bool                          msFirst;
+    std::atomic<bool>             msHalt;
+    bool                          msQuit;
+
     std::mutex mtx_dofEvent;
     std::condition_variable cv_dofEvent;
 
     virtual PartDescriptor *getPartDesc(yarp::os::Searchable &options)=0;
+    virtual yarp::sig::Vector getInitialGuess(const yarp::sig::Vector &xd);
+    virtual void startMultiStart(const unsigned int num, const double tol,
+                                 const double constr_tol, const int maxIter);
+    virtual void stopMultiStart();
+    virtual void syncMultiStartWorker(MultiStartWorker &w);
+    virtual void multiStartLoop(MultiStartWorker *w);
+    virtual yarp::sig::Vector solveMultiStart(const yarp::sig::Vector &q0, yarp::sig::Vector &xd,
+                                              const double weight2ndTask);
     virtual yarp::sig::Vector solve(yarp::sig::Vector &xd);
 
     virtual yarp::sig::Vector &encodeDOF();
@@ -516,6 +555,35 @@ public:
     * \b maxIter <int>: example (maxIter 200), specifies the maximum
     *    number of iterations allowed for one optimization instance.
     *  
+    * \b warmStart <vocab>: example (warmStart on), selects 
+    *    whether to initialize each optimization instance with the
+    *    dual variables of the previous solution; allowed values
+    *    are [on] or [off] (default).
+    *  
+    * \b maxWallTime <double>: example (maxWallTime 0.02), 
+    *    specifies in seconds the hard wall-clock budget for one
+    *    optimization instance, after which the current iterate is
+    *    returned; zero (default) disables this option.
+    *  
+    * \b seedMap <string>: example (seedMap seeds.bin), specifies 
+    *    the file containing the iKinSeedMap the initial guess of
+    *    each optimization instance is retrieved from whenever it
+    *    is closer to the target than the current configuration;
+    *    the map is used only while the solver DOF match those of
+    *    the map.
+    *  
+    * \b multiStart <int>: example (multiStart 3), specifies the 
+    *    number of additional optimization instances that are run
+    *    in parallel worker threads from different initial guesses
+    *    (the current configuration and random configurations
+    *    within the joints bounds); zero (default) disables this
+    *    option. Combine it with maxWallTime to bound the latency.
+    *  
+    * \b multiStartPolicy <string>: example (multiStartPolicy 
+    *    first), selects whether to return the [first] successful
+    *    solution, halting the other instances, or the [best]
+    *    solution (default) in terms of distance from the target.
+    *  
     * \b interPoints <vocab>: example (interPoints on), selects 
     *    whether to force or not the solver to output on the port
     *    all intermediate points of optimization instance; allowed
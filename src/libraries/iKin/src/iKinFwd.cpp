@@ -13,6 +13,8 @@
 #include <sstream>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <thread>
 
 #include <yarp/os/Log.h>
 
@@ -35,6 +37,22 @@ void iCub::iKin::notImplemented(const unsigned int verbose)
 }
 
 
+/************************************************************************/
+static inline void mul4x4(const double *A, const double *B, double *C)
+{
+    for (int r=0; r<4; r++)
+    {
+        const double *a=A+4*r;
+        double *c=C+4*r;
+
+        c[0]=a[0]*B[0]+a[1]*B[4]+a[2]*B[8] +a[3]*B[12];
+        c[1]=a[0]*B[1]+a[1]*B[5]+a[2]*B[9] +a[3]*B[13];
+        c[2]=a[0]*B[2]+a[1]*B[6]+a[2]*B[10]+a[3]*B[14];
+        c[3]=a[0]*B[3]+a[1]*B[7]+a[2]*B[11]+a[3]*B[15];
+    }
+}
+
+
 /************************************************************************/
 iKinLink::iKinLink(double _A, double _D, double _Alpha, double _Offset,
                    double _Min, double _Max): zeros1x1(zeros(1,1)), zeros1(zeros(1))
@@ -252,6 +270,35 @@ void iKinLink::addCumH(const Matrix &_cumH)
 }
 
 
+/************************************************************************/
+void iKinLink::fillH(double *_H) const
+{
+    double theta=Ang+Offset;
+    double c_theta=cos(theta);
+    double s_theta=sin(theta);
+
+    _H[0]=c_theta;  _H[1]=-s_theta*c_alpha; _H[2]=s_theta*s_alpha;   _H[3]=c_theta*A;
+    _H[4]=s_theta;  _H[5]=c_theta*c_alpha;  _H[6]=-c_theta*s_alpha;  _H[7]=s_theta*A;
+    _H[8]=0.0;      _H[9]=s_alpha;          _H[10]=c_alpha;          _H[11]=D;
+    _H[12]=0.0;     _H[13]=0.0;             _H[14]=0.0;              _H[15]=1.0;
+}
+
+
+/************************************************************************/
+void iKinLink::fillDH(double *_DH) const
+{
+    double theta=Ang+Offset;
+    double c_theta=cos(theta);
+    double s_theta=sin(theta);
+
+    _DH[0]=-s_theta; _DH[1]=-c_theta*c_alpha; _DH[2]=c_theta*s_alpha;  _DH[3]=-s_theta*A;
+    _DH[4]=c_theta;  _DH[5]=-s_theta*c_alpha; _DH[6]=s_theta*s_alpha;  _DH[7]=c_theta*A;
+
+    for (int i=8; i<16; i++)
+        _DH[i]=0.0;
+}
+
+
 /************************************************************************/
 iKinChain::iKinChain()
 {
@@ -271,6 +318,11 @@ void iKinChain::clone(const iKinChain &c)
     verbose  =c.verbose;
     hess_J   =c.hess_J;
     hess_Jlnk=c.hess_Jlnk;
+    hess_H   =c.hess_H;
+    fast_H   =c.fast_H;
+    fast_fwdH=c.fast_fwdH;
+    fast_bwdH=c.fast_bwdH;
+    fast_DH  =c.fast_DH;
 
     allList.assign(c.allList.begin(),c.allList.end());
     quickList.assign(c.quickList.begin(),c.quickList.end());
@@ -731,6 +783,21 @@ Vector iKinChain::d2RotAng(const Matrix &R, const Matrix &dRi,
 /************************************************************************/
 Matrix iKinChain::getH(const unsigned int i, const bool allLink)
 {
+    if (allLink)
+    {
+        yAssert(i<N);
+
+        fastForward();
+
+        Matrix H(4,4);
+        if (i>=N-1)
+            mul4x4(&fast_fwdH[16*(i+1)],HN.data(),H.data());
+        else
+            std::copy(&fast_fwdH[16*(i+1)],&fast_fwdH[16*(i+2)],H.data());
+
+        return H;
+    }
+
     Matrix H=H0;
     unsigned int _i,n;
     deque<iKinLink*> *l;
@@ -777,15 +844,10 @@ Matrix iKinChain::getH(const unsigned int i, const bool allLink)
 /************************************************************************/
 Matrix iKinChain::getH()
 {
-    // may be different from DOF since one blocked link may lie
-    // at the end of the chain.
-    unsigned int n=(unsigned int)quickList.size();
-    Matrix H=H0;
-
-    for (unsigned int i=0; i<n; i++)
-        H*=quickList[i]->getH();
+    Matrix H(4,4);
+    fastGetH(H);
 
-    return H*HN;
+    return H;
 }
 
 
@@ -956,43 +1018,8 @@ Matrix iKinChain::AnaJacobian(const unsigned int i, unsigned int col)
 /************************************************************************/
 Matrix iKinChain::AnaJacobian(unsigned int col)
 {
-    yAssert(DOF>0);
-
-    col=col>3 ? 3 : col;
-
-    // may be different from DOF since one blocked link may lie
-    // at the end of the chain.
-    unsigned int n=(unsigned int)quickList.size();
     Matrix J(6,DOF);
-    Matrix H,dH,_H;
-    Vector dr;
-
-    for (unsigned int i=0; i<DOF; i++)
-    {
-        H=dH=H0;
-
-        for (unsigned int j=0; j<n; j++)
-        {
-            _H=quickList[j]->getH();
-            H*=_H;
-
-            if (hash_dof[i]==j)
-                dH*=quickList[j]->getDnH();
-            else
-                dH*=_H;
-        }
-
-        H*=HN;
-        dH*=HN;
-        dr=dRotAng(H,dH);
-
-        J(0,i)=dH(0,col);
-        J(1,i)=dH(1,col);
-        J(2,i)=dH(2,col);
-        J(3,i)=dr[0];
-        J(4,i)=dr[1];
-        J(5,i)=dr[2];
-    }
+    fastAnaJacobian(J,col);
 
     return J;
 }
@@ -1013,31 +1040,29 @@ Matrix iKinChain::GeoJacobian(const unsigned int i)
 {
     yAssert(i<N);
 
-    Matrix J(6,i+1);
-    Matrix PN,Z;
-    Vector w;
-
-    deque<Matrix> intH;
-    intH.push_back(H0);
+    fastForward();
 
-    for (unsigned int j=0; j<=i; j++)
-        intH.push_back(intH[j]*allList[j]->getH(true));
+    Matrix J(6,i+1);
+    double PN[16];
 
-    PN=intH[i+1];
     if (i>=N-1)
-        PN=PN*HN;
+        mul4x4(&fast_fwdH[16*(i+1)],HN.data(),PN);
+    else
+        std::copy(&fast_fwdH[16*(i+1)],&fast_fwdH[16*(i+2)],PN);
 
     for (unsigned int j=0; j<=i; j++)
     {
-        Z=intH[j];
-        w=cross(Z,2,PN-Z,3);
+        const double *Z=&fast_fwdH[16*j];
+        double dx=PN[3]-Z[3];
+        double dy=PN[7]-Z[7];
+        double dz=PN[11]-Z[11];
 
-        J(0,j)=w[0];
-        J(1,j)=w[1];
-        J(2,j)=w[2];
-        J(3,j)=Z(0,2);
-        J(4,j)=Z(1,2);
-        J(5,j)=Z(2,2);
+        J(0,j)=Z[6]*dz-Z[10]*dy;
+        J(1,j)=Z[10]*dx-Z[2]*dz;
+        J(2,j)=Z[2]*dy-Z[6]*dx;
+        J(3,j)=Z[2];
+        J(4,j)=Z[6];
+        J(5,j)=Z[10];
     }
 
     return J;
@@ -1046,47 +1071,382 @@ Matrix iKinChain::GeoJacobian(const unsigned int i)
 
 /************************************************************************/
 Matrix iKinChain::GeoJacobian()
+{
+    Matrix J(6,DOF);
+    fastGeoJacobian(J);
+
+    return J;
+}
+
+
+/************************************************************************/
+Matrix iKinChain::GeoJacobian(const Vector &q)
 {
     yAssert(DOF>0);
 
-    Matrix J(6,DOF);
-    Matrix PN,Z;
-    Vector w;
+    setAng(q);
+    return GeoJacobian();
+}
 
-    deque<Matrix> intH;
-    intH.push_back(H0);
 
-    for (unsigned int i=0; i<N; i++)
-        intH.push_back(intH[i]*allList[i]->getH(true));
+/************************************************************************/
+void iKinChain::fastForward()
+{
+    // storage is reallocated only when the chain topology changes
+    if (fast_fwdH.size()!=16*(N+1))
+    {
+        fast_H.assign(16*N,0.0);
+        fast_fwdH.assign(16*(N+1),0.0);
+        fast_bwdH.assign(16*(N+1),0.0);
+        fast_DH.assign(4*N,std::numeric_limits<double>::quiet_NaN());
+    }
+
+    // fast_fwdH[j] = H0*A0*...*A(j-1)
+    double *fwd=fast_fwdH.data();
+    unsigned int j=0;
+
+    // skip the leading links whose parameters did not change
+    // since the last call: their prefix transforms are still valid
+    if (std::equal(H0.data(),H0.data()+16,fwd))
+    {
+        for (; j<N; j++)
+        {
+            const iKinLink *l=allList[j];
+            const double *dh=&fast_DH[4*j];
+            if ((dh[0]!=l->Ang+l->Offset) || (dh[1]!=l->A) ||
+                (dh[2]!=l->D) || (dh[3]!=l->Alpha))
+                break;
+        }
+    }
+    else
+        std::copy(H0.data(),H0.data()+16,fwd);
+
+    for (; j<N; j++)
+    {
+        const iKinLink *l=allList[j];
+        double *dh=&fast_DH[4*j];
+        dh[0]=l->Ang+l->Offset;
+        dh[1]=l->A;
+        dh[2]=l->D;
+        dh[3]=l->Alpha;
+
+        double *A=&fast_H[16*j];
+        l->fillH(A);
+        mul4x4(fwd+16*j,A,fwd+16*(j+1));
+    }
+}
+
+
+/************************************************************************/
+void iKinChain::fastBackward()
+{
+    // fast_bwdH[j] = Aj*...*A(N-1)*HN; to be called after fastForward()
+    double *bwd=fast_bwdH.data();
+    std::copy(HN.data(),HN.data()+16,bwd+16*N);
+
+    for (int j=N-1; j>=0; j--)
+        mul4x4(&fast_H[16*j],bwd+16*(j+1),bwd+16*j);
+}
+
+
+/************************************************************************/
+void iKinChain::fastGetH(Matrix &H)
+{
+    if ((H.rows()!=4) || (H.cols()!=4))
+        H.resize(4,4);
+
+    fastForward();
+    mul4x4(&fast_fwdH[16*N],HN.data(),H.data());
+}
 
-    PN=intH[N]*HN;
+
+/************************************************************************/
+void iKinChain::fastGeoJacobian(Matrix &J)
+{
+    yAssert(DOF>0);
+
+    if ((J.rows()!=6) || (J.cols()!=DOF))
+        J.resize(6,DOF);
+
+    fastForward();
+
+    double PN[16];
+    mul4x4(&fast_fwdH[16*N],HN.data(),PN);
 
     for (unsigned int i=0; i<DOF; i++)
     {
+        const double *Z=&fast_fwdH[16*hash[i]];
+        double dx=PN[3]-Z[3];
+        double dy=PN[7]-Z[7];
+        double dz=PN[11]-Z[11];
+
+        J(0,i)=Z[6]*dz-Z[10]*dy;
+        J(1,i)=Z[10]*dx-Z[2]*dz;
+        J(2,i)=Z[2]*dy-Z[6]*dx;
+        J(3,i)=Z[2];
+        J(4,i)=Z[6];
+        J(5,i)=Z[10];
+    }
+}
+
+
+/************************************************************************/
+void iKinChain::fastAnaJacobian(Matrix &J, unsigned int col)
+{
+    yAssert(DOF>0);
+
+    col=col>3 ? 3 : col;
+
+    if ((J.rows()!=6) || (J.cols()!=DOF))
+        J.resize(6,DOF);
+
+    fastForward();
+    fastBackward();
+
+    double H[16],dA[16],tmp[16],dH[16];
+    mul4x4(&fast_fwdH[16*N],HN.data(),H);
+
+    for (unsigned int i=0; i<DOF; i++)
+    {
+        // dH = H0*A0*...*dAj*...*A(N-1)*HN
         unsigned int j=hash[i];
+        allList[j]->fillDH(dA);
+        mul4x4(&fast_fwdH[16*j],dA,tmp);
+        mul4x4(tmp,&fast_bwdH[16*(j+1)],dH);
 
-        Z=intH[j];
-        w=cross(Z,2,PN-Z,3);
+        J(0,i)=dH[col];
+        J(1,i)=dH[4+col];
+        J(2,i)=dH[8+col];
 
-        J(0,i)=w[0];
-        J(1,i)=w[1];
-        J(2,i)=w[2];
-        J(3,i)=Z(0,2);
-        J(4,i)=Z(1,2);
-        J(5,i)=Z(2,2);
+        // same as dRotAng()
+        J(3,i)=(H[9]*dH[10]-H[10]*dH[9])/(H[9]*H[9]+H[10]*H[10]);
+        J(4,i)=dH[8]/sqrt(fabs(1-H[8]*H[8]));
+        J(5,i)=(H[4]*dH[0]-H[0]*dH[4])/(H[4]*H[4]+H[0]*H[0]);
     }
+}
 
-    return J;
+
+/************************************************************************/
+void iKinChain::batchChunk(const Matrix &Q, const size_t k0, const size_t k1,
+                           Matrix *X, const bool axisRep, deque<Matrix> *J) const
+{
+    // configurations are processed in blocks stored as structure of
+    // arrays: entry e of the upper 3x4 part of the running transform
+    // of the kth configuration lies at T[e*blk+k], so that the inner
+    // loops run across configurations and can be vectorized
+    const size_t blk=64;
+    vector<double> T(12*blk),c(blk),s(blk),Z,P;
+    if (J!=NULL)
+    {
+        Z.resize(3*DOF*blk);
+        P.resize(3*DOF*blk);
+    }
+
+    for (size_t b0=k0; b0<k1; b0+=blk)
+    {
+        const size_t m=std::min(blk,k1-b0);
+
+        for (int e=0; e<12; e++)
+            std::fill(&T[e*blk],&T[e*blk]+m,H0(e>>2,e&3));
+
+        for (unsigned int j=0, dof=0; j<N; j++)
+        {
+            const iKinLink *l=allList[j];
+
+            if (l->blocked)
+            {
+                std::fill(c.begin(),c.begin()+m,cos(l->Ang+l->Offset));
+                std::fill(s.begin(),s.begin()+m,sin(l->Ang+l->Offset));
+            }
+            else
+            {
+                // the z-axis and the origin of the frame preceding
+                // the joint are needed by the geometric Jacobian
+                if (J!=NULL)
+                {
+                    for (int r=0; r<3; r++)
+                    {
+                        std::copy(&T[(4*r+2)*blk],&T[(4*r+2)*blk]+m,&Z[(3*dof+r)*blk]);
+                        std::copy(&T[(4*r+3)*blk],&T[(4*r+3)*blk]+m,&P[(3*dof+r)*blk]);
+                    }
+                }
+
+                const double *q=Q[dof]+b0;
+                for (size_t k=0; k<m; k++)
+                {
+                    double theta=l->constrained ? std::min(std::max(q[k],l->Min),l->Max) : q[k];
+                    c[k]=cos(theta+l->Offset);
+                    s[k]=sin(theta+l->Offset);
+                }
+
+                dof++;
+            }
+
+            const double A=l->A, D=l->D;
+            const double ca=l->c_alpha, sa=l->s_alpha;
+            for (int r=0; r<3; r++)
+            {
+                double *t0=&T[4*r*blk];
+                double *t1=t0+blk;
+                double *t2=t1+blk;
+                double *t3=t2+blk;
+
+                for (size_t k=0; k<m; k++)
+                {
+                    double a0=t0[k], a1=t1[k], a2=t2[k];
+                    double u=a0*c[k]+a1*s[k];
+                    double v=a1*c[k]-a0*s[k];
+
+                    t0[k]=u;
+                    t1[k]=v*ca+a2*sa;
+                    t2[k]=a2*ca-v*sa;
+                    t3[k]+=u*A+a2*D;
+                }
+            }
+        }
+
+        for (size_t k=0; k<m; k++)
+        {
+            // E = T*HN
+            double E[12];
+            for (int r=0; r<3; r++)
+            {
+                double t[4]={T[4*r*blk+k],T[(4*r+1)*blk+k],T[(4*r+2)*blk+k],T[(4*r+3)*blk+k]};
+                for (int col=0; col<4; col++)
+                    E[4*r+col]=t[0]*HN(0,col)+t[1]*HN(1,col)+t[2]*HN(2,col)+(col==3 ? t[3] : 0.0);
+            }
+
+            if (X!=NULL)
+            {
+                Matrix &x=*X;
+                const size_t n=b0+k;
+                x(0,n)=E[3];
+                x(1,n)=E[7];
+                x(2,n)=E[11];
+
+                if (axisRep)
+                {
+                    // same as dcm2axis()
+                    double v0=E[9]-E[6];
+                    double v1=E[2]-E[8];
+                    double v2=E[4]-E[1];
+                    double r=sqrt(v0*v0+v1*v1+v2*v2);
+                    if (r<1e-9)
+                    {
+                        Matrix R=eye(4,4);
+                        for (int e=0; e<12; e++)
+                            R(e>>2,e&3)=E[e];
+
+                        Vector ax=dcm2axis(R);
+                        x(3,n)=ax[0];
+                        x(4,n)=ax[1];
+                        x(5,n)=ax[2];
+                        x(6,n)=ax[3];
+                    }
+                    else
+                    {
+                        x(3,n)=v0/r;
+                        x(4,n)=v1/r;
+                        x(5,n)=v2/r;
+                        x(6,n)=atan2(0.5*r,0.5*(E[0]+E[5]+E[10]-1.0));
+                    }
+                }
+                else
+                {
+                    // same as RotAng()
+                    x(3,n)=atan2(-E[9],E[10]);
+                    x(4,n)=asin(E[8]);
+                    x(5,n)=atan2(-E[4],E[0]);
+                }
+            }
+
+            if (J!=NULL)
+            {
+                Matrix &jac=(*J)[b0+k];
+                for (unsigned int i=0; i<DOF; i++)
+                {
+                    double zx=Z[3*i*blk+k], zy=Z[(3*i+1)*blk+k], zz=Z[(3*i+2)*blk+k];
+                    double dx=E[3]-P[3*i*blk+k];
+                    double dy=E[7]-P[(3*i+1)*blk+k];
+                    double dz=E[11]-P[(3*i+2)*blk+k];
+
+                    jac(0,i)=zy*dz-zz*dy;
+                    jac(1,i)=zz*dx-zx*dz;
+                    jac(2,i)=zx*dy-zy*dx;
+                    jac(3,i)=zx;
+                    jac(4,i)=zy;
+                    jac(5,i)=zz;
+                }
+            }
+        }
+    }
 }
 
 
 /************************************************************************/
-Matrix iKinChain::GeoJacobian(const Vector &q)
+void iKinChain::batchRun(const Matrix &Q, Matrix *X, const bool axisRep,
+                         deque<Matrix> *J, const unsigned int nThreads) const
 {
-    yAssert(DOF>0);
+    yAssert((DOF>0) && (Q.rows()==DOF));
 
-    setAng(q);
-    return GeoJacobian();
+    const size_t M=Q.cols();
+
+    // outputs are allocated here, workers only fill them in
+    if (X!=NULL)
+    {
+        size_t rows=axisRep ? 7 : 6;
+        if ((X->rows()!=rows) || (X->cols()!=M))
+            X->resize(rows,M);
+    }
+
+    if (J!=NULL)
+    {
+        J->resize(M);
+        for (size_t k=0; k<M; k++)
+            if (((*J)[k].rows()!=6) || ((*J)[k].cols()!=DOF))
+                (*J)[k].resize(6,DOF);
+    }
+
+    size_t n=std::max((size_t)1,std::min((size_t)nThreads,M));
+    size_t sz=M/n;
+
+    deque<thread> workers;
+    for (size_t i=1; i<n; i++)
+    {
+        size_t k0=i*sz;
+        size_t k1=(i==n-1) ? M : k0+sz;
+        workers.push_back(thread(&iKinChain::batchChunk,this,std::cref(Q),
+                                 k0,k1,X,axisRep,J));
+    }
+
+    batchChunk(Q,0,std::min(sz,M),X,axisRep,J);
+
+    for (size_t i=0; i<workers.size(); i++)
+        workers[i].join();
+}
+
+
+/************************************************************************/
+void iKinChain::batchEndEffPose(const Matrix &Q, Matrix &X, const bool axisRep,
+                                const unsigned int nThreads) const
+{
+    batchRun(Q,&X,axisRep,NULL,nThreads);
+}
+
+
+/************************************************************************/
+void iKinChain::batchGeoJacobian(const Matrix &Q, deque<Matrix> &J,
+                                 const unsigned int nThreads) const
+{
+    batchRun(Q,NULL,true,&J,nThreads);
+}
+
+
+/************************************************************************/
+void iKinChain::batchEndEffPose(const Matrix &Q, Matrix &X, deque<Matrix> &J,
+                                const bool axisRep, const unsigned int nThreads) const
+{
+    batchRun(Q,&X,axisRep,&J,nThreads);
 }
 
 
@@ -1109,42 +1469,65 @@ void iKinChain::prepareForHessian()
         return;
     }
 
-    hess_J=GeoJacobian();
+    fastGeoJacobian(hess_J);
+
+    // ref. E.D. Pohl, H. Lipkin, "A New Method of Robotic Motion Control Near Singularities",
+    // Advanced Robotics, 1991
+    // the linear part of d2F/dqidqj is symmetric and equal to cross(Jo_min(i,j),Jl_max(i,j)),
+    // whereas the angular part is cross(Jo_i,Jo_j) for i<j and zero otherwise
+    if (hess_H.size()!=6*DOF*DOF)
+        hess_H.resize(6*DOF*DOF);
+
+    for (unsigned int i=0; i<DOF; i++)
+    {
+        double oi0=hess_J(3,i), oi1=hess_J(4,i), oi2=hess_J(5,i);
+
+        for (unsigned int j=i; j<DOF; j++)
+        {
+            double *hij=&hess_H[6*(i*DOF+j)];
+            double *hji=&hess_H[6*(j*DOF+i)];
+
+            hij[0]=hji[0]=oi1*hess_J(2,j)-oi2*hess_J(1,j);
+            hij[1]=hji[1]=oi2*hess_J(0,j)-oi0*hess_J(2,j);
+            hij[2]=hji[2]=oi0*hess_J(1,j)-oi1*hess_J(0,j);
+
+            hij[3]=oi1*hess_J(5,j)-oi2*hess_J(4,j);
+            hij[4]=oi2*hess_J(3,j)-oi0*hess_J(5,j);
+            hij[5]=oi0*hess_J(4,j)-oi1*hess_J(3,j);
+
+            hji[3]=hji[4]=hji[5]=0.0;
+        }
+
+        // cross(Jo_i,Jo_i) vanishes
+        double *hii=&hess_H[6*(i*DOF+i)];
+        hii[3]=hii[4]=hii[5]=0.0;
+    }
 }
 
 
 /************************************************************************/
 Vector iKinChain::fastHessian_ij(const unsigned int i, const unsigned int j)
 {
-    yAssert((i<DOF) && (j<DOF));
-
-    // ref. E.D. Pohl, H. Lipkin, "A New Method of Robotic Motion Control Near Singularities",
-    // Advanced Robotics, 1991
-    Vector h(6,0.0);
-    if(i<j)
-    {
-        //h.setSubvector(0,cross(hess_Jo,i,hess_Jl,j));
-        h[0] = hess_J(4,i)*hess_J(2,j) - hess_J(5,i)*hess_J(1,j);
-        h[1] = hess_J(5,i)*hess_J(0,j) - hess_J(3,i)*hess_J(2,j);
-        h[2] = hess_J(3,i)*hess_J(1,j) - hess_J(4,i)*hess_J(0,j);
-        //h.setSubvector(3,cross(hess_Jo,i,hess_Jo,j));
-        h(3) = hess_J(4,i)*hess_J(5,j)-hess_J(5,i)*hess_J(4,j);
-        h(4) = hess_J(5,i)*hess_J(3,j)-hess_J(3,i)*hess_J(5,j);
-        h(5) = hess_J(3,i)*hess_J(4,j)-hess_J(4,i)*hess_J(3,j);
-    }
-    else
-    {
-        //h.setSubvector(0, cross(Jo,j,Jl,i));
-        h[0] = hess_J(4,j)*hess_J(2,i) - hess_J(5,j)*hess_J(1,i);
-        h[1] = hess_J(5,j)*hess_J(0,i) - hess_J(3,j)*hess_J(2,i);
-        h[2] = hess_J(3,j)*hess_J(1,i) - hess_J(4,j)*hess_J(0,i);
-        h[3]=h[4]=h[5]=0.0;
-    }
+    Vector h(6);
+    fastHessian_ij(i,j,h);
 
     return h;
 }
 
 
+/************************************************************************/
+void iKinChain::fastHessian_ij(const unsigned int i, const unsigned int j, Vector &h)
+{
+    yAssert((i<DOF) && (j<DOF) && (hess_H.size()==6*DOF*DOF));
+
+    if (h.length()!=6)
+        h.resize(6);
+
+    const double *hij=&hess_H[6*(i*DOF+j)];
+    std::copy(hij,hij+6,h.data());
+}
+
+
 /************************************************************************/
 Vector iKinChain::Hessian_ij(const unsigned int lnk, const unsigned int i,
                              const unsigned int j)
@@ -1203,48 +1586,30 @@ Vector iKinChain::fastHessian_ij(const unsigned int lnk, const unsigned int i,
 /************************************************************************/
 Matrix iKinChain::DJacobian(const Vector &dq)
 {
-    Matrix J=GeoJacobian();
+    prepareForHessian();
+    return fastDJacobian(dq);
+}
+
+
+/************************************************************************/
+Matrix iKinChain::fastDJacobian(const Vector &dq)
+{
+    yAssert((dq.length()>=DOF) && (hess_H.size()==6*DOF*DOF));
+
+    // dJ(:,i) = sum_j d2F/dqjdqi * dq_j
     Matrix dJ(6,DOF); dJ.zero();
-    double dqj,dqi,a,b,c;
-    for (unsigned int i=0; i<DOF; i++)  // i: col
+    for (unsigned int j=0; j<DOF; j++)
     {
-        for (unsigned int j=0; j<=i; j++)  // j: row
+        double dqj=dq[j];
+        for (unsigned int i=0; i<DOF; i++)
         {
-            dqj=dq[j];
-
-            a=J(4,j)*J(2,i)-J(5,j)*J(1,i);
-            b=J(5,j)*J(0,i)-J(3,j)*J(2,i);
-            c=J(3,j)*J(1,i)-J(4,j)*J(0,i);
-            dJ(0,i)+=dqj*a;
-            dJ(1,i)+=dqj*b;
-            dJ(2,i)+=dqj*c;
-            dJ(3,i)+=dqj*(J(4,j)*J(5,i)-J(5,j)*J(4,i));
-            dJ(4,i)+=dqj*(J(5,j)*J(3,i)-J(3,j)*J(5,i));
-            dJ(5,i)+=dqj*(J(3,j)*J(4,i)-J(4,j)*J(3,i));
-
-            if (i!=j)
-            {
-                dqi     =dq[i];
-                dJ(0,j)+=dqi*a;
-                dJ(1,j)+=dqi*b;
-                dJ(2,j)+=dqi*c;
-            }
+            const double *h=&hess_H[6*(j*DOF+i)];
+            for (int r=0; r<6; r++)
+                dJ(r,i)+=dqj*h[r];
         }
     }
 
     return dJ;
-
-    /* OLD IMPLEMENTATION (SLOWER, BUT CLEARER)
-    prepareForHessian();
-    Vector tmp(6,0.0);
-    for (unsigned int i=0; i<DOF; i++)
-    {
-        for (unsigned int j=0; j<DOF; j++)
-            tmp+=fastHessian_ij(j,i)*dq(j);
-
-        dJ.setCol(i,tmp);
-        tmp.zero();
-    }*/
 }
 
 
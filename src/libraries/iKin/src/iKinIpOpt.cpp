@@ -11,6 +11,7 @@
 #include <cstdlib>
 #include <limits>
 #include <string>
+#include <chrono>
 
 #include <IpTNLP.hpp>
 #include <IpIpoptApplication.hpp>
@@ -76,6 +77,13 @@ iKinLinIneqConstr &iKinLinIneqConstr::operator=(const iKinLinIneqConstr &obj)
 }
 
 
+/************************************************************************/
+iKinLinIneqConstr *iKinLinIneqConstr::duplicate() const
+{
+    return new iKinLinIneqConstr(*this);
+}
+
+
 /************************************************************************/
 void iCubAdditionalArmConstraints::clone(const iKinLinIneqConstr *obj)
 {
@@ -124,6 +132,13 @@ iCubAdditionalArmConstraints::iCubAdditionalArmConstraints(iCubArm &arm) :
 }
 
 
+/************************************************************************/
+iKinLinIneqConstr *iCubAdditionalArmConstraints::duplicate() const
+{
+    return new iCubAdditionalArmConstraints(*this);
+}
+
+
 /************************************************************************/
 void iCubAdditionalArmConstraints::update(void*)
 {
@@ -255,6 +270,7 @@ protected:
     yarp::sig::Vector  q0;
     yarp::sig::Vector  q;
     bool              *exhalt;
+    std::atomic<bool> *exhaltAtomic;
 
     yarp::sig::Vector  e_zero;
     yarp::sig::Vector  e_xyz;
@@ -282,6 +298,13 @@ protected:
 
     iKinIterateCallback *callback;
 
+    yarp::sig::Vector *warm_zL;
+    yarp::sig::Vector *warm_zU;
+    yarp::sig::Vector *warm_lambda;
+
+    bool wallTimeOn;
+    std::chrono::steady_clock::time_point wallTimeEnd;
+
     double weight2ndTask;
     double weight3rdTask;
     bool   firstGo;
@@ -422,6 +445,10 @@ public:
         upperBoundInf=std::numeric_limits<double>::max();
 
         callback=NULL;
+        exhaltAtomic=NULL;
+
+        warm_zL=warm_zU=warm_lambda=NULL;
+        wallTimeOn=false;
     }
 
     /************************************************************************/
@@ -430,6 +457,28 @@ public:
     /************************************************************************/
     void set_callback(iKinIterateCallback *_callback) { callback=_callback; }
 
+    /************************************************************************/
+    void set_exhalt(std::atomic<bool> *_exhalt) { exhaltAtomic=_exhalt; }
+
+    /************************************************************************/
+    void set_warm_start(yarp::sig::Vector *zL, yarp::sig::Vector *zU,
+                        yarp::sig::Vector *lambda)
+    {
+        warm_zL=zL;
+        warm_zU=zU;
+        warm_lambda=lambda;
+    }
+
+    /************************************************************************/
+    void set_max_wall_time(double max_wall_time)
+    {
+        wallTimeOn=(max_wall_time>0.0);
+        if (wallTimeOn)
+            wallTimeEnd=std::chrono::steady_clock::now()+
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(max_wall_time));
+    }
+
     /************************************************************************/
     void set_scaling(double _obj_scaling, double _x_scaling, double _g_scaling)
     {
@@ -551,6 +600,28 @@ public:
         for (Index i=0; i<n; i++)
             x[i]=q0[i];
 
+        // dual variables are requested only in warm-start mode:
+        // fall back to zero if the problem size changed meanwhile
+        if (init_z)
+        {
+            bool valid=(warm_zL!=NULL) && (warm_zL->length()==(size_t)n) &&
+                       (warm_zU->length()==(size_t)n);
+
+            for (Index i=0; i<n; i++)
+            {
+                z_L[i]=valid ? (*warm_zL)[i] : 0.0;
+                z_U[i]=valid ? (*warm_zU)[i] : 0.0;
+            }
+        }
+
+        if (init_lambda)
+        {
+            bool valid=(warm_lambda!=NULL) && (warm_lambda->length()==(size_t)m);
+
+            for (Index i=0; i<m; i++)
+                lambda[i]=valid ? (*warm_lambda)[i] : 0.0;
+        }
+
         return true;
     }
     
@@ -689,6 +760,10 @@ public:
             if (weight2ndTask!=0.0)
                 chain2ndTask.prepareForHessian();
 
+            // buffers are allocated once per call and not per element
+            yarp::sig::Vector h(6), h2(6);
+            yarp::sig::Vector h_xyz(3), h_ang(3), h_zero(3,0.0), h_2nd(3);
+
             Index idx=0;
             for (Index row=0; row<n; row++)
             {
@@ -696,8 +771,7 @@ public:
                 {
                     // warning: row and col are swapped due to asymmetry
                     // of orientation part within the hessian 
-                    yarp::sig::Vector h=chain.fastHessian_ij(col,row);
-                    yarp::sig::Vector h_xyz(3), h_ang(3), h_zero(3,0.0);
+                    chain.fastHessian_ij(col,row,h);
                     h_xyz[0]=h[0];
                     h_xyz[1]=h[1];
                     h_xyz[2]=h[2];
@@ -724,8 +798,7 @@ public:
                     {    
                         // warning: row and col are swapped due to asymmetry
                         // of orientation part within the hessian 
-                        yarp::sig::Vector h2=chain2ndTask.fastHessian_ij(col,row);
-                        yarp::sig::Vector h_2nd(3);
+                        chain2ndTask.fastHessian_ij(col,row,h2);
                         h_2nd[0]=(w_2nd[0]*w_2nd[0])*h2[0];
                         h_2nd[1]=(w_2nd[1]*w_2nd[1])*h2[1];
                         h_2nd[2]=(w_2nd[2]*w_2nd[2])*h2[2];
@@ -751,7 +824,12 @@ public:
         if (callback!=NULL)
             callback->exec(xd,q);
 
-        if (exhalt!=NULL)
+        if (wallTimeOn && (std::chrono::steady_clock::now()>=wallTimeEnd))
+            return false;
+
+        if (exhaltAtomic!=NULL)
+            return !exhaltAtomic->load();
+        else if (exhalt!=NULL)
             return !(*exhalt);
         else
             return true;
@@ -785,6 +863,33 @@ public:
             qd[i]=x[i];
 
         qd=chain.setAng(qd);
+
+        // retain the dual variables for warm-starting the next
+        // problem only if they refer to a genuine solution
+        if (warm_zL!=NULL)
+        {
+            if ((status==SUCCESS) || (status==STOP_AT_ACCEPTABLE_POINT))
+            {
+                warm_zL->resize(n);
+                warm_zU->resize(n);
+                warm_lambda->resize(m);
+
+                for (Index i=0; i<n; i++)
+                {
+                    (*warm_zL)[i]=z_L[i];
+                    (*warm_zU)[i]=z_U[i];
+                }
+
+                for (Index i=0; i<m; i++)
+                    (*warm_lambda)[i]=lambda[i];
+            }
+            else
+            {
+                warm_zL->resize(0);
+                warm_zU->resize(0);
+                warm_lambda->resize(0);
+            }
+        }
     }
 
     /************************************************************************/
@@ -801,6 +906,8 @@ iKinIpOptMin::iKinIpOptMin(iKinChain &c, const unsigned int _ctrlPose, const dou
     ctrlPose=_ctrlPose;
     posePriority="position";
     pLIC=&noLIC;
+    warmStart=false;
+    maxWallTime=0.0;
 
     if (ctrlPose>IKINCTRL_POSE_ANG)
         ctrlPose=IKINCTRL_POSE_ANG;
@@ -914,6 +1021,25 @@ double iKinIpOptMin::getMaxCpuTime() const
 }
 
 
+/************************************************************************/
+void iKinIpOptMin::setWarmStart(const bool enable)
+{
+    warmStart=enable;
+
+    if (!warmStart)
+    {
+        warm_zL.resize(0);
+        warm_zU.resize(0);
+        warm_lambda.resize(0);
+
+        CAST_IPOPTAPP(App)->Options()->SetStringValue("warm_start_init_point","no");
+        CAST_IPOPTAPP(App)->Options()->SetNumericValue("mu_init",0.1);
+        CAST_IPOPTAPP(App)->Options()->SetNumericValue("warm_start_bound_push",1e-3);
+        CAST_IPOPTAPP(App)->Options()->SetNumericValue("warm_start_mult_bound_push",1e-3);
+    }
+}
+
+
 /************************************************************************/
 void iKinIpOptMin::setTol(const double tol)
 {
@@ -1032,6 +1158,32 @@ yarp::sig::Vector iKinIpOptMin::solve(const yarp::sig::Vector &q0, yarp::sig::Ve
                                       yarp::sig::Vector &w_2nd, double weight3rdTask,
                                       yarp::sig::Vector &qd_3rd, yarp::sig::Vector &w_3rd,
                                       int *exit_code, bool *exhalt, iKinIterateCallback *iterate)
+{
+    return optimize(q0,xd,weight2ndTask,xd_2nd,w_2nd,weight3rdTask,qd_3rd,w_3rd,
+                    exit_code,exhalt,NULL,iterate);
+}
+
+
+/************************************************************************/
+yarp::sig::Vector iKinIpOptMin::solve(const yarp::sig::Vector &q0, yarp::sig::Vector &xd,
+                                      double weight2ndTask, yarp::sig::Vector &xd_2nd,
+                                      yarp::sig::Vector &w_2nd, double weight3rdTask,
+                                      yarp::sig::Vector &qd_3rd, yarp::sig::Vector &w_3rd,
+                                      int *exit_code, std::atomic<bool> &exhalt,
+                                      iKinIterateCallback *iterate)
+{
+    return optimize(q0,xd,weight2ndTask,xd_2nd,w_2nd,weight3rdTask,qd_3rd,w_3rd,
+                    exit_code,NULL,&exhalt,iterate);
+}
+
+
+/************************************************************************/
+yarp::sig::Vector iKinIpOptMin::optimize(const yarp::sig::Vector &q0, yarp::sig::Vector &xd,
+                                         double weight2ndTask, yarp::sig::Vector &xd_2nd,
+                                         yarp::sig::Vector &w_2nd, double weight3rdTask,
+                                         yarp::sig::Vector &qd_3rd, yarp::sig::Vector &w_3rd,
+                                         int *exit_code, bool *exhalt, std::atomic<bool> *exhaltAtomic,
+                                         iKinIterateCallback *iterate)
 {
     SmartPtr<iKin_NLP> nlp=new iKin_NLP(chain,ctrlPose,q0,xd,
                                         weight2ndTask,chain2ndTask,xd_2nd,w_2nd,
@@ -1042,6 +1194,21 @@ yarp::sig::Vector iKinIpOptMin::solve(const yarp::sig::Vector &q0, yarp::sig::Ve
     nlp->set_bound_inf(lowerBoundInf,upperBoundInf);
     nlp->set_posePriority(posePriority);
     nlp->set_callback(iterate);
+    nlp->set_exhalt(exhaltAtomic);
+    nlp->set_max_wall_time(maxWallTime);
+
+    if (warmStart)
+    {
+        // the barrier parameter shall start small not to drive
+        // the iterates away from the previous solution
+        bool warm=(warm_zL.length()>0);
+        CAST_IPOPTAPP(App)->Options()->SetStringValue("warm_start_init_point",warm?"yes":"no");
+        CAST_IPOPTAPP(App)->Options()->SetNumericValue("mu_init",warm?1e-6:0.1);
+        CAST_IPOPTAPP(App)->Options()->SetNumericValue("warm_start_bound_push",1e-6);
+        CAST_IPOPTAPP(App)->Options()->SetNumericValue("warm_start_mult_bound_push",1e-6);
+
+        nlp->set_warm_start(&warm_zL,&warm_zU,&warm_lambda);
+    }
 
     ApplicationReturnStatus status=CAST_IPOPTAPP(App)->OptimizeTNLP(GetRawPtr(nlp));
 
@@ -0,0 +1,393 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include <yarp/os/Log.h>
+#include <yarp/math/Math.h>
+
+#include <iCub/ctrl/math.h>
+#include <iCub/iKin/iKinSeed.h>
+
+#define IKINSEED_MAGIC          "iKSM"
+#define IKINSEED_VERSION        1
+#define IKINSEED_BATCH          4096
+
+using namespace std;
+using namespace yarp::sig;
+using namespace yarp::math;
+using namespace iCub::ctrl;
+using namespace iCub::iKin;
+
+
+/************************************************************************/
+static inline double orientationError(const double *Rd, const double *R)
+{
+    // 3-trace(Rd'*R) vanishes when the two rotations coincide
+    double tr=0.0;
+    for (int i=0; i<9; i++)
+        tr+=Rd[i]*R[i];
+
+    return 3.0-tr;
+}
+
+
+/************************************************************************/
+iKinSeedMap::iKinSeedMap()
+{
+    N=0;
+    cellSize=0.0;
+    origin[0]=origin[1]=origin[2]=0.0;
+    dims[0]=dims[1]=dims[2]=0;
+}
+
+
+/************************************************************************/
+bool iKinSeedMap::getCell(const double *x, int *cell) const
+{
+    for (int i=0; i<3; i++)
+    {
+        double c=floor((x[i]-origin[i])/cellSize);
+        if ((c<0.0) || (c>=dims[i]))
+            return false;
+
+        cell[i]=(int)c;
+    }
+
+    return true;
+}
+
+
+/************************************************************************/
+bool iKinSeedMap::build(iKinChain &chain, const unsigned int numSamples,
+                        const double _cellSize, const unsigned int maxPerCell,
+                        const unsigned int seed)
+{
+    unsigned int n=chain.getDOF();
+    if ((n==0) || (numSamples==0) || (_cellSize<=0.0) || (maxPerCell==0))
+    {
+        yError("iKinSeedMap: invalid parameters");
+        return false;
+    }
+
+    N=n;
+    cellSize=_cellSize;
+    size_t s=stride();
+
+    mt19937 gen(seed);
+    uniform_real_distribution<double> uniform(0.0,1.0);
+
+    // sample configurations and store the corresponding poses
+    vector<float> samples(numSamples*s);
+    Matrix Q,X;
+    for (unsigned int k0=0; k0<numSamples; k0+=IKINSEED_BATCH)
+    {
+        unsigned int m=std::min((unsigned int)IKINSEED_BATCH,numSamples-k0);
+        Q.resize(N,m);
+        for (unsigned int j=0; j<m; j++)
+            for (unsigned int i=0; i<N; i++)
+                Q(i,j)=chain(i).getMin()+(chain(i).getMax()-chain(i).getMin())*uniform(gen);
+
+        chain.batchEndEffPose(Q,X,true);
+
+        for (unsigned int j=0; j<m; j++)
+        {
+            float *e=&samples[(k0+j)*s];
+            Vector ax(4);
+            for (int i=0; i<4; i++)
+                ax[i]=X(3+i,j);
+            Matrix R=axis2dcm(ax);
+
+            for (int i=0; i<3; i++)
+                e[i]=(float)X(i,j);
+            for (int r=0; r<3; r++)
+                for (int c=0; c<3; c++)
+                    e[3+3*r+c]=(float)R(r,c);
+            for (unsigned int i=0; i<N; i++)
+                e[12+i]=(float)Q(i,j);
+        }
+    }
+
+    // define the grid on the bounding box of the positions
+    double lo[3],hi[3];
+    for (int i=0; i<3; i++)
+    {
+        lo[i]=std::numeric_limits<double>::max();
+        hi[i]=-std::numeric_limits<double>::max();
+    }
+
+    for (unsigned int k=0; k<numSamples; k++)
+    {
+        for (int i=0; i<3; i++)
+        {
+            lo[i]=std::min(lo[i],(double)samples[k*s+i]);
+            hi[i]=std::max(hi[i],(double)samples[k*s+i]);
+        }
+    }
+
+    for (int i=0; i<3; i++)
+    {
+        origin[i]=lo[i]-0.5*cellSize;
+        dims[i]=(int)floor((hi[i]-origin[i])/cellSize)+1;
+    }
+
+    size_t numCells=(size_t)dims[0]*dims[1]*dims[2];
+
+    // bin the samples retaining at most maxPerCell entries per cell
+    vector<unsigned int> cellOf(numSamples);
+    vector<unsigned int> count(numCells,0);
+    for (unsigned int k=0; k<numSamples; k++)
+    {
+        double x[3]={samples[k*s+0],samples[k*s+1],samples[k*s+2]};
+        int cell[3];
+        if (!getCell(x,cell))
+        {
+            cellOf[k]=(unsigned int)numCells;
+            continue;
+        }
+
+        size_t c=((size_t)cell[0]*dims[1]+cell[1])*dims[2]+cell[2];
+        if (count[c]<maxPerCell)
+        {
+            count[c]++;
+            cellOf[k]=(unsigned int)c;
+        }
+        else
+            cellOf[k]=(unsigned int)numCells;
+    }
+
+    cellStart.assign(numCells+1,0);
+    for (size_t c=0; c<numCells; c++)
+        cellStart[c+1]=cellStart[c]+count[c];
+
+    entries.resize((size_t)cellStart[numCells]*s);
+    vector<unsigned int> fill(cellStart.begin(),cellStart.end()-1);
+    for (unsigned int k=0; k<numSamples; k++)
+    {
+        unsigned int c=cellOf[k];
+        if (c<numCells)
+            memcpy(&entries[(size_t)(fill[c]++)*s],&samples[k*s],s*sizeof(float));
+    }
+
+    return true;
+}
+
+
+/************************************************************************/
+bool iKinSeedMap::save(const string &fileName) const
+{
+    if (N==0)
+    {
+        yError("iKinSeedMap: empty map");
+        return false;
+    }
+
+    FILE *f=fopen(fileName.c_str(),"wb");
+    if (f==NULL)
+    {
+        yError("iKinSeedMap: unable to open file %s",fileName.c_str());
+        return false;
+    }
+
+    unsigned int version=IKINSEED_VERSION;
+    unsigned int numCells=(unsigned int)(cellStart.size()-1);
+    unsigned int numEntries=(unsigned int)size();
+
+    bool ok=(fwrite(IKINSEED_MAGIC,1,4,f)==4);
+    ok&=(fwrite(&version,sizeof(version),1,f)==1);
+    ok&=(fwrite(&N,sizeof(N),1,f)==1);
+    ok&=(fwrite(&cellSize,sizeof(cellSize),1,f)==1);
+    ok&=(fwrite(origin,sizeof(double),3,f)==3);
+    ok&=(fwrite(dims,sizeof(int),3,f)==3);
+    ok&=(fwrite(&numEntries,sizeof(numEntries),1,f)==1);
+    ok&=(fwrite(cellStart.data(),sizeof(unsigned int),numCells+1,f)==numCells+1);
+    ok&=(fwrite(entries.data(),sizeof(float),entries.size(),f)==entries.size());
+    fclose(f);
+
+    if (!ok)
+        yError("iKinSeedMap: error while writing file %s",fileName.c_str());
+
+    return ok;
+}
+
+
+/************************************************************************/
+bool iKinSeedMap::load(const string &fileName)
+{
+    FILE *f=fopen(fileName.c_str(),"rb");
+    if (f==NULL)
+    {
+        yError("iKinSeedMap: unable to open file %s",fileName.c_str());
+        return false;
+    }
+
+    char magic[4];
+    unsigned int version,_N,numEntries;
+    double _cellSize,_origin[3];
+    int _dims[3];
+
+    bool ok=(fread(magic,1,4,f)==4) && (memcmp(magic,IKINSEED_MAGIC,4)==0);
+    ok=ok && (fread(&version,sizeof(version),1,f)==1) && (version==IKINSEED_VERSION);
+    ok=ok && (fread(&_N,sizeof(_N),1,f)==1) && (_N>0);
+    ok=ok && (fread(&_cellSize,sizeof(_cellSize),1,f)==1) && (_cellSize>0.0);
+    ok=ok && (fread(_origin,sizeof(double),3,f)==3);
+    ok=ok && (fread(_dims,sizeof(int),3,f)==3) && (_dims[0]>0) && (_dims[1]>0) && (_dims[2]>0);
+    ok=ok && (fread(&numEntries,sizeof(numEntries),1,f)==1);
+
+    vector<unsigned int> _cellStart;
+    vector<float> _entries;
+    if (ok)
+    {
+        size_t numCells=(size_t)_dims[0]*_dims[1]*_dims[2];
+        _cellStart.resize(numCells+1);
+        _entries.resize((size_t)numEntries*(12+_N));
+
+        ok=(fread(_cellStart.data(),sizeof(unsigned int),_cellStart.size(),f)==_cellStart.size());
+        ok=ok && (fread(_entries.data(),sizeof(float),_entries.size(),f)==_entries.size());
+        ok=ok && (_cellStart.front()==0) && (_cellStart.back()==numEntries);
+
+        // getSeed() walks the entries of each cell between
+        // consecutive offsets, which shall then be sorted
+        for (size_t c=0; ok && (c<numCells); c++)
+            ok=(_cellStart[c]<=_cellStart[c+1]) && (_cellStart[c+1]<=numEntries);
+    }
+
+    fclose(f);
+
+    if (!ok)
+    {
+        yError("iKinSeedMap: invalid file %s",fileName.c_str());
+        return false;
+    }
+
+    N=_N;
+    cellSize=_cellSize;
+    for (int i=0; i<3; i++)
+    {
+        origin[i]=_origin[i];
+        dims[i]=_dims[i];
+    }
+
+    cellStart.swap(_cellStart);
+    entries.swap(_entries);
+
+    return true;
+}
+
+
+/************************************************************************/
+double iKinSeedMap::distance(const Vector &xd, const Vector &x,
+                             const double orientationWeight)
+{
+    yAssert((xd.length()>=3) && (x.length()>=3));
+
+    double d=0.0;
+    for (int i=0; i<3; i++)
+        d+=(xd[i]-x[i])*(xd[i]-x[i]);
+
+    if ((xd.length()>=7) && (x.length()>=7))
+    {
+        Matrix Rd=axis2dcm(xd.subVector(3,6));
+        Matrix R=axis2dcm(x.subVector(3,6));
+
+        double rd[9],r[9];
+        for (int i=0; i<3; i++)
+        {
+            for (int j=0; j<3; j++)
+            {
+                rd[3*i+j]=Rd(i,j);
+                r[3*i+j]=R(i,j);
+            }
+        }
+
+        d+=orientationWeight*orientationError(rd,r);
+    }
+
+    return d;
+}
+
+
+/************************************************************************/
+bool iKinSeedMap::getSeed(const Vector &xd, Vector &q,
+                          const double orientationWeight) const
+{
+    if (isEmpty() || (xd.length()<3))
+        return false;
+
+    bool useOrien=(xd.length()>=7);
+    double rd[9];
+    if (useOrien)
+    {
+        Matrix Rd=axis2dcm(xd.subVector(3,6));
+        for (int i=0; i<3; i++)
+            for (int j=0; j<3; j++)
+                rd[3*i+j]=Rd(i,j);
+    }
+
+    // locate the cell of the target, tolerating one cell outside
+    // the grid as long as its neighbourhood overlaps the grid
+    int cell[3];
+    for (int i=0; i<3; i++)
+    {
+        cell[i]=(int)floor((xd[i]-origin[i])/cellSize);
+        if ((cell[i]<-1) || (cell[i]>dims[i]))
+            return false;
+    }
+
+    size_t s=stride();
+    const float *best=NULL;
+    double bestDist=std::numeric_limits<double>::max();
+    double r[9];
+
+    for (int i=std::max(cell[0]-1,0); i<=std::min(cell[0]+1,dims[0]-1); i++)
+    {
+        for (int j=std::max(cell[1]-1,0); j<=std::min(cell[1]+1,dims[1]-1); j++)
+        {
+            for (int k=std::max(cell[2]-1,0); k<=std::min(cell[2]+1,dims[2]-1); k++)
+            {
+                size_t c=((size_t)i*dims[1]+j)*dims[2]+k;
+                for (unsigned int e=cellStart[c]; e<cellStart[c+1]; e++)
+                {
+                    const float *entry=&entries[e*s];
+
+                    double d=0.0;
+                    for (int l=0; l<3; l++)
+                        d+=(xd[l]-entry[l])*(xd[l]-entry[l]);
+
+                    if (useOrien)
+                    {
+                        for (int l=0; l<9; l++)
+                            r[l]=entry[3+l];
+
+                        d+=orientationWeight*orientationError(rd,r);
+                    }
+
+                    if (d<bestDist)
+                    {
+                        bestDist=d;
+                        best=entry;
+                    }
+                }
+            }
+        }
+    }
+
+    if (best==NULL)
+        return false;
+
+    q.resize(N);
+    for (unsigned int i=0; i<N; i++)
+        q[i]=best[12+i];
+
+    return true;
+}
+
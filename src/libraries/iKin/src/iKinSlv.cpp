@@ -16,6 +16,8 @@
 #include <yarp/os/Network.h>
 #include <yarp/os/Time.h>
 
+#include <IpReturnCodes.hpp>
+
 #include <iCub/iKin/iKinVocabs.h>
 #include <iCub/iKin/iKinSlv.h>
 
@@ -36,6 +38,14 @@ using namespace iCub::ctrl;
 using namespace iCub::iKin;
 
 
+/************************************************************************/
+static inline bool isSolved(const int exit_code)
+{
+    return ((exit_code==Ipopt::Solve_Succeeded) ||
+            (exit_code==Ipopt::Solved_To_Acceptable_Level));
+}
+
+
 /************************************************************************/
 bool RpcProcessor::read(ConnectionReader &connection)
 {
@@ -285,6 +295,13 @@ CartesianSolver::CartesianSolver(const string &_slvName) :
     inPort=NULL;
     outPort=NULL;
 
+    msJob=0;
+    msPending=0;
+    msWinner=-1;
+    msFirst=false;
+    msHalt=false;
+    msQuit=false;
+
     // open rpc port
     rpcPort=new Port;
     cmdProcessor=new RpcProcessor(this);
@@ -1406,6 +1423,27 @@ bool CartesianSolver::open(Searchable &options)
     // enable scaling
     slv->setUserScaling(true,100.0,100.0,100.0);
 
+    // keep the reply latency bounded under streaming targets
+    if (options.check("warmStart"))
+        if (options.find("warmStart").asVocab32()==IKINSLV_VOCAB_VAL_ON)
+            slv->setWarmStart(true);
+
+    slv->setMaxWallTime(options.check("maxWallTime",Value(0.0)).asFloat64());
+
+    // load the map of initial guesses, if any
+    if (options.check("seedMap"))
+    {
+        string seedFile=options.find("seedMap").asString();
+        if (seedMap.load(seedFile))
+        {
+            if (seedMap.getN()!=prt->chn->getDOF())
+                yWarning("%s: seed map %s does not match the current DOF; it will be used only with %u DOF",
+                         slvName.c_str(),seedFile.c_str(),seedMap.getN());
+        }
+        else
+            yWarning("%s: unable to load seed map %s",slvName.c_str(),seedFile.c_str());
+    }
+
     // enforce linear inequalities constraints, if any
     if (prt->cns!=NULL)
     {
@@ -1418,6 +1456,11 @@ bool CartesianSolver::open(Searchable &options)
         slv->getLIC().update(NULL);
     }
 
+    // spawn the workers for parallel multi-start, if required
+    msFirst=(options.check("multiStartPolicy",Value("best")).asString()=="first");
+    startMultiStart(std::max(options.check("multiStart",Value(0)).asInt32(),0),
+                    tol,constr_tol,maxIter);
+
     // set up 2nd task
     xd_2ndTask.resize(3,0.0);
     w_2ndTask.resize(3,0.0);
@@ -1511,11 +1554,273 @@ void CartesianSolver::prepareJointsRestTask()
 }
 
 
+/************************************************************************/
+Vector CartesianSolver::getInitialGuess(const Vector &xd)
+{
+    iKinChain &chn=*prt->chn;
+    Vector q0=chn.getAng();
+
+    // the map holds configurations of a given DOF set
+    Vector seed;
+    if ((seedMap.getN()!=chn.getDOF()) || !seedMap.getSeed(xd,seed))
+        return q0;
+
+    Vector x0=chn.EndEffPose();
+    Vector xSeed=chn.EndEffPose(seed);
+    chn.setAng(q0);
+
+    return (iKinSeedMap::distance(xd,xSeed)<iKinSeedMap::distance(xd,x0)?seed:q0);
+}
+
+
+/************************************************************************/
+void CartesianSolver::startMultiStart(const unsigned int num, const double tol,
+                                      const double constr_tol, const int maxIter)
+{
+    for (unsigned int i=0; i<num; i++)
+    {
+        MultiStartWorker *w=new MultiStartWorker;
+        w->lmb=new iKinLimb(*prt->lmb);
+        w->slv=new iKinIpOptMin(*w->lmb->asChain(),ctrlPose,tol,constr_tol,maxIter);
+        w->slv->setUserScaling(true,100.0,100.0,100.0);
+        w->lic=slv->getLIC().duplicate();
+        w->slv->attachLIC(*w->lic);
+        w->exit_code=-1;
+        w->thr=std::thread(&CartesianSolver::multiStartLoop,this,w);
+
+        msWorkers.push_back(w);
+    }
+
+    if (num>0)
+        yInfo("%s: multi-start enabled with %u additional instances (%s policy)",
+              slvName.c_str(),num,msFirst?"first":"best");
+}
+
+
+/************************************************************************/
+void CartesianSolver::stopMultiStart()
+{
+    {
+        lock_guard<mutex> lck(mtx_ms);
+        msQuit=msHalt=true;
+    }
+    cv_msStart.notify_all();
+
+    for (size_t i=0; i<msWorkers.size(); i++)
+    {
+        MultiStartWorker *w=msWorkers[i];
+        if (w->thr.joinable())
+            w->thr.join();
+
+        delete w->slv;
+        delete w->lic;
+        delete w->lmb;
+        delete w;
+    }
+
+    msWorkers.clear();
+}
+
+
+/************************************************************************/
+void CartesianSolver::syncMultiStartWorker(MultiStartWorker &w)
+{
+    iKinChain &chn=*prt->chn;
+    iKinChain &wchn=*w.lmb->asChain();
+
+    // replicate DOF, blocked values and joints bounds
+    for (unsigned int i=0; i<chn.getN(); i++)
+    {
+        if (chn[i].isBlocked())
+        {
+            if (!wchn[i].isBlocked())
+                wchn.blockLink(i,chn[i].getAng());
+            else
+                wchn.setBlockingValue(i,chn[i].getAng());
+        }
+        else if (wchn[i].isBlocked())
+            wchn.releaseLink(i);
+
+        wchn[i].setMin(chn[i].getMin());
+        wchn[i].setMax(chn[i].getMax());
+    }
+
+    wchn.setH0(chn.getH0());
+    wchn.setHN(chn.getHN());
+
+    // replicate the optimizer's settings; setters are invoked only
+    // upon changes as they re-initialize the optimizer
+    if (w.slv->get_ctrlPose()!=slv->get_ctrlPose())
+        w.slv->set_ctrlPose(slv->get_ctrlPose());
+
+    if (w.slv->get_posePriority()!=slv->get_posePriority())
+        w.slv->set_posePriority(slv->get_posePriority());
+
+    w.slv->setMaxWallTime(slv->getMaxWallTime());
+
+    if (w.slv->getTol()!=slv->getTol())
+        w.slv->setTol(slv->getTol());
+
+    if (w.slv->getConstrTol()!=slv->getConstrTol())
+        w.slv->setConstrTol(slv->getConstrTol());
+
+    if (w.slv->getMaxIter()!=slv->getMaxIter())
+        w.slv->setMaxIter(slv->getMaxIter());
+
+    unsigned int n2nd=slv->get2ndTaskChain().getN();
+    if (w.slv->get2ndTaskChain().getN()!=n2nd)
+    {
+        if (n2nd>0)
+            w.slv->specify2ndTaskEndEff(n2nd);
+        else
+            w.slv->get2ndTaskChain().clear();
+    }
+
+    // the copy keeps the dynamic type of the solver's constraints
+    *w.lic=slv->getLIC();
+}
+
+
+/************************************************************************/
+void CartesianSolver::multiStartLoop(MultiStartWorker *w)
+{
+    unsigned int job=0;
+    while (true)
+    {
+        Vector xd,xd_2nd,w_2nd,qd_3rd,w_3rd;
+        double weight2ndTask;
+
+        {
+            unique_lock<mutex> lck(mtx_ms);
+            cv_msStart.wait(lck,[&](){ return (msQuit || (msJob!=job)); });
+            if (msQuit)
+                return;
+
+            job=msJob;
+            xd=msXd;
+            xd_2nd=xd_2ndTask;
+            w_2nd=w_2ndTask;
+            qd_3rd=qd_3rdTask;
+            w_3rd=w_3rdTask;
+            weight2ndTask=(w->slv->get2ndTaskChain().getN()>0?CARTSLV_WEIGHT_2ND_TASK:0.0);
+        }
+
+        w->q=w->slv->solve(w->q0,xd,weight2ndTask,xd_2nd,w_2nd,
+                           CARTSLV_WEIGHT_3RD_TASK,qd_3rd,w_3rd,
+                           &w->exit_code,msHalt);
+
+        {
+            lock_guard<mutex> lck(mtx_ms);
+            if (isSolved(w->exit_code) && (msWinner<0))
+            {
+                for (size_t i=0; i<msWorkers.size(); i++)
+                    if (msWorkers[i]==w)
+                        msWinner=(int)i+1;
+
+                if (msFirst)
+                    msHalt=true;
+            }
+
+            msPending--;
+        }
+        cv_msDone.notify_all();
+    }
+}
+
+
+/************************************************************************/
+Vector CartesianSolver::solveMultiStart(const Vector &q0, Vector &xd,
+                                        const double weight2ndTask)
+{
+    iKinChain &chn=*prt->chn;
+    Vector qCur=chn.getAng();
+
+    // the first worker starts from the current configuration,
+    // unless the main instance already does, and the others
+    // from random configurations within the joints bounds
+    uniform_real_distribution<double> uniform(0.0,1.0);
+    for (size_t i=0; i<msWorkers.size(); i++)
+    {
+        MultiStartWorker &w=*msWorkers[i];
+        syncMultiStartWorker(w);
+
+        if ((i==0) && (norm(q0-qCur)>0.0))
+            w.q0=qCur;
+        else
+        {
+            w.q0.resize(chn.getDOF());
+            for (unsigned int j=0; j<chn.getDOF(); j++)
+                w.q0[j]=chn(j).getMin()+(chn(j).getMax()-chn(j).getMin())*uniform(msRand);
+        }
+    }
+
+    {
+        lock_guard<mutex> lck(mtx_ms);
+        msXd=xd;
+        msPending=(unsigned int)msWorkers.size();
+        msWinner=-1;
+        msHalt=false;
+        msJob++;
+    }
+    cv_msStart.notify_all();
+
+    int exit_code;
+    Vector q=slv->solve(q0,xd,weight2ndTask,xd_2ndTask,w_2ndTask,
+                        CARTSLV_WEIGHT_3RD_TASK,qd_3rdTask,w_3rdTask,
+                        &exit_code,msHalt,clb);
+
+    {
+        unique_lock<mutex> lck(mtx_ms);
+        if (isSolved(exit_code) && (msWinner<0))
+        {
+            msWinner=0;
+            if (msFirst)
+                msHalt=true;
+        }
+
+        cv_msDone.wait(lck,[&](){ return (msPending==0); });
+    }
+
+    if (msFirst && (msWinner>0))
+        return msWorkers[msWinner-1]->q;
+    else if (msFirst && (msWinner==0))
+        return q;
+
+    // pick the closest solution to the target, giving
+    // priority to the instances that converged
+    Vector xd_=(slv->get_ctrlPose()==IKINCTRL_POSE_XYZ?xd.subVector(0,2):xd);
+    Vector qBest=q;
+    bool solvedBest=isSolved(exit_code);
+    double distBest=iKinSeedMap::distance(xd_,chn.EndEffPose(q));
+
+    for (size_t i=0; i<msWorkers.size(); i++)
+    {
+        MultiStartWorker &w=*msWorkers[i];
+        bool solved=isSolved(w.exit_code);
+        double dist=iKinSeedMap::distance(xd_,w.lmb->EndEffPose(w.q));
+
+        if ((solved && !solvedBest) || ((solved==solvedBest) && (dist<distBest)))
+        {
+            qBest=w.q;
+            solvedBest=solved;
+            distBest=dist;
+        }
+    }
+
+    return qBest;
+}
+
+
 /************************************************************************/
 Vector CartesianSolver::solve(Vector &xd)
 {
-    return slv->solve(prt->chn->getAng(),xd,
-                      slv->get2ndTaskChain().getN()>0?CARTSLV_WEIGHT_2ND_TASK:0.0,xd_2ndTask,w_2ndTask,
+    Vector q0=getInitialGuess(slv->get_ctrlPose()==IKINCTRL_POSE_XYZ?xd.subVector(0,2):xd);
+    double weight2ndTask=(slv->get2ndTaskChain().getN()>0?CARTSLV_WEIGHT_2ND_TASK:0.0);
+
+    if (msWorkers.size()>0)
+        return solveMultiStart(q0,xd,weight2ndTask);
+
+    return slv->solve(q0,xd,weight2ndTask,xd_2ndTask,w_2ndTask,
                       CARTSLV_WEIGHT_3RD_TASK,qd_3rdTask,w_3rdTask,
                       NULL,NULL,clb);
 }
@@ -1555,6 +1860,8 @@ void CartesianSolver::close()
         outPort=NULL;
     }
 
+    stopMultiStart();
+
     delete slv;
     delete clb;
     slv=NULL;
@@ -26,6 +26,8 @@
 
 #include "EoProtocol.h"
 #include <vector>
+#include <functional>
+#include <future>
 #include <yarp/os/Searchable.h>
 
 
@@ -73,11 +75,15 @@ namespace eth {
         virtual bool getRemoteValue(const eOprotID32_t id32, void *value, const double timeout = 0.100, const unsigned int retries = 0) = 0;
 
         virtual bool getRemoteValues(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.500) = 0;
+
+        virtual std::future<bool> getRemoteValuesAsync(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.500, const std::function<void(bool)> &onreply = nullptr) = 0;
        
         virtual bool setRemoteValue(const eOprotID32_t id32, void *value) = 0;
 
         virtual bool setcheckRemoteValue(const eOprotID32_t id32, void *value, const unsigned int retries = 10, const double waitbeforecheck = 0.001, const double timeout = 0.050) = 0;
 
+        virtual bool setcheckRemoteValues(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries = 10, const double waitbeforecheck = 0.001, const double timeout = 0.050) = 0;
+
         virtual bool getLocalValue(const eOprotID32_t id32, void *value) = 0;
 
         virtual bool setLocalValue(eOprotID32_t id32, const void *value, bool overrideROprotection = false) = 0;
@@ -442,6 +442,29 @@ bool eth::EthBoards::execute(void (*action)(eth::AbstractEthResource* res, void*
 }
 
 
+bool eth::EthBoards::lockRX(eOipv4addr_t ipv4, bool on)
+{
+    uint8_t index = 0;
+    eo_common_ipv4addr_to_decimal(ipv4, NULL, NULL, NULL, &index);
+    index --;
+    if(index>=maxEthBoards)
+    {
+        return false;
+    }
+
+    if(on)
+    {
+        rxLocks[index].lock();
+    }
+    else
+    {
+        rxLocks[index].unlock();
+    }
+
+    return true;
+}
+
+
 bool eth::EthBoards::execute(eOipv4addr_t ipv4, void (*action)(eth::AbstractEthResource* res, void* p), void* par)
 {
     if(NULL == action)
@@ -28,6 +28,8 @@
 #include "EoProtocol.h"
 #include <abstractEthResource.h>
 
+#include <mutex>
+
 namespace eth {
 
     // -- class EthBoards
@@ -36,6 +38,7 @@ namespace eth {
     // -- services of EthResource to transmit or receive.
     // -- it is responsibility of the object which owns EthBoards (it is ethManager) to protect the class EthBoards vs concurrent use.
     // -- examples of concurrent use are: transmit or receive using an ethresource and ... attempting to create or destroy a resource.
+    // -- for reception the protection is per board: see lockRX().
 
     typedef struct
     {
@@ -76,6 +79,10 @@ namespace eth {
         // executes an action on the ethResource having a specific ipv4.
         bool execute(eOipv4addr_t ipv4, void (*action)(eth::AbstractEthResource* res, void* p), void* par);
 
+        // locks the board with a given ipv4, also if it has no resource yet. whoever parses the packets of the board
+        // must hold it, and so must whoever adds or removes its resource or interfaces. it is false if ipv4 is not valid.
+        bool lockRX(eOipv4addr_t ipv4, bool on);
+
 
     private:
 
@@ -101,6 +108,7 @@ namespace eth {
 
         int sizeofLUT;
         ethboardProperties_t LUT[EthBoards::maxEthBoards];
+        std::mutex rxLocks[EthBoards::maxEthBoards];
 
     private:
 
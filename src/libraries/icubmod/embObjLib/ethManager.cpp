@@ -91,6 +91,9 @@ TheEthManager::TheEthManager()
     // it is a singleton. the constructor is private.
     communicationIsInitted = false;
     UDP_socket  = NULL;
+    sender = NULL;
+    receiver = NULL;
+    rxPool = NULL;
 
     // the container of ethernet boards: resources and attached interfaces
     ethBoards = new(eth::EthBoards);
@@ -138,6 +141,7 @@ TheEthManager::~TheEthManager()
 
         delete sender;
         delete receiver;
+        delete rxPool;
 
         lock(false);
     }
@@ -220,7 +224,7 @@ void ethEvalTXropframe(eth::AbstractEthResource *r, void* p)
         return;
     }
 
-    TheEthManager *ethman = reinterpret_cast<TheEthManager*>(p);
+    EthSender *sender = reinterpret_cast<EthSender*>(p);
 
 #if 0
     uint16_t numofbytes = 0;
@@ -232,7 +236,7 @@ void ethEvalTXropframe(eth::AbstractEthResource *r, void* p)
     {
         eOipv4addressing_t ipv4addressing;
         r->getIPv4addressing(ipv4addressing);
-        ethman->sendPacket(data2send, static_cast<size_t>(numofbytes), ipv4addressing);
+        sender->queue(data2send, static_cast<size_t>(numofbytes), ipv4addressing);
     }
 #else
 
@@ -243,7 +247,7 @@ void ethEvalTXropframe(eth::AbstractEthResource *r, void* p)
 
     if(nullptr != data2send)
     {
-        ethman->sendPacket(data2send, numofbytes, ipv4addressing);
+        sender->queue(data2send, numofbytes, ipv4addressing);
     }
 
 #endif
@@ -254,7 +258,9 @@ bool TheEthManager::Transmission(void)
 {
     lockTX(true);
 
-    ethBoards->execute(ethEvalTXropframe, this);
+    // the packets of all the boards are queued and sent together
+    ethBoards->execute(ethEvalTXropframe, sender);
+    sender->flush();
 
     lockTX(false);
 
@@ -268,13 +274,19 @@ void ethEvalPresence(eth::AbstractEthResource *r, void* p)
     {
         return;
     }
+
+    // if a worker of the EthReceptionPool is parsing a packet of this board, it is also ticking its presence
+    eth::EthBoards *ethboards = reinterpret_cast<eth::EthBoards*>(p);
+    eOipv4addr_t ipv4 = r->getProperties().ipv4addressing.addr;
+    ethboards->lockRX(ipv4, true);
     r->Check();
+    ethboards->lockRX(ipv4, false);
 }
 
 
 bool TheEthManager::CheckPresence(void)
 {
-    ethBoards->execute(ethEvalPresence, this);
+    ethBoards->execute(ethEvalPresence, ethBoards);
     return true;
 }
 
@@ -318,7 +330,7 @@ bool TheEthManager::initCommunication(yarp::os::Searchable &cfgtotal)
     embBoardsConnected = pc104data.embBoardsConnected;
 
     // localaddress
-    if(false == createCommunicationObjects(tmpaddress, txrate, rxrate) )
+    if(false == createCommunicationObjects(tmpaddress, txrate, rxrate, pc104data.rxblocking, pc104data.rxcore, pc104data.rxworkers) )
     {
         yError () << "TheEthManager::initCommunication() cannot create communication objects";
         return false;
@@ -358,6 +370,8 @@ eth::AbstractEthResource *TheEthManager::requestResource2(IethResource *interfac
     // i want to lock the use of resources managed by ethBoards to avoid that we attempt to use for TX a ethres not completely initted
 
     lockTXRX(true);
+    // the receiver does not use rxSem: we also stop the parsing of the packets of this board
+    ethBoards->lockRX(ipv4addr, true);
 
     // i do an attempt to get the resource.
     eth::AbstractEthResource *rr = ethBoards->get_resource(ipv4addr);
@@ -389,6 +403,8 @@ eth::AbstractEthResource *TheEthManager::requestResource2(IethResource *interfac
             }
 
             rr = NULL;
+            ethBoards->lockRX(ipv4addr, false);
+            lockTXRX(false);
             return NULL;
         }
 
@@ -399,6 +415,7 @@ eth::AbstractEthResource *TheEthManager::requestResource2(IethResource *interfac
     ethBoards->add(rr, interface);
 
 
+    ethBoards->lockRX(ipv4addr, false);
     lockTXRX(false);
 
     return(rr);
@@ -484,6 +501,8 @@ int TheEthManager::releaseResource2(eth::AbstractEthResource* ethresource, IethR
 
     // now we change internal data structure of ethBoards, thus .. must disable tx and rx
     lockTXRX(true);
+    eOipv4addr_t ipv4addr = rr->getProperties().ipv4addressing.addr;
+    ethBoards->lockRX(ipv4addr, true);
 
     // remove the interface
     ethBoards->rem(rr, type);
@@ -501,6 +520,7 @@ int TheEthManager::releaseResource2(eth::AbstractEthResource* ethresource, IethR
         ret = -1;
     }
 
+    ethBoards->lockRX(ipv4addr, false);
     lockTXRX(false);
 
 
@@ -516,6 +536,18 @@ const eOipv4addressing_t& TheEthManager::getLocalIPV4addressing(void)
 }
 
 
+double TheEthManager::getTXperiod(void)
+{
+    // EthSender is created only when the first board is opened: until then we use its default rate
+    if(NULL == sender)
+    {
+        return 0.001 * eth::EthSender::EthSenderDefaultRate;
+    }
+
+    return sender->getPeriod();
+}
+
+
 IethResource* TheEthManager::getInterface(eOipv4addr_t ipv4, eOprotID32_t id32)
 {
     IethResource *interfacePointer = ethBoards->get_interface(ipv4, id32);
@@ -531,7 +563,7 @@ double TheEthManager::getLifeTime(void)
 
 
 
-bool TheEthManager::createCommunicationObjects(const eOipv4addressing_t &localaddress, int txrate, int rxrate)
+bool TheEthManager::createCommunicationObjects(const eOipv4addressing_t &localaddress, int txrate, int rxrate, bool rxblocking, int rxcore, int rxworkers)
 {
     lock(true);
 
@@ -566,9 +598,15 @@ bool TheEthManager::createCommunicationObjects(const eOipv4addressing_t &localad
             }
             sender = new eth::EthSender(txrate);
             receiver = new eth::EthReceiver(rxrate);
+            if(rxworkers > 0)
+            {
+                rxPool = new eth::EthReceptionPool(this, rxworkers);
+                rxPool->start();
+            }
 
             sender->config(UDP_socket, this);
             receiver->config(UDP_socket, this);
+            receiver->setBlockingMode(rxblocking, rxcore);
 
             /* Start the threads sending to and receiving messages from the boards.
              * It will execute the threadInit and pass its return value to the following calls
@@ -624,8 +662,15 @@ bool TheEthManager::stopCommunicationThreads()
     }
     if(receiver->isRunning())
     {
+        // PeriodicThread::stop() waits for run() to return: onStop() makes a receiver in blocking mode leave its loop
+        receiver->onStop();
         receiver->stop();
     }
+    if(NULL != rxPool)
+    {
+        // the receiver does not push anymore: we can stop the workers
+        rxPool->stop();
+    }
     return ret;
 }
 
@@ -663,7 +708,22 @@ ACE_INET_Addr TheEthManager::toaceinet(const eOipv4addressing_t &ipv4addressing)
 
 bool TheEthManager::Reception(eOipv4addr_t from, uint64_t* data, ssize_t size)
 {
-    lockRX(true);
+    if(NULL != rxPool)
+    {
+        return rxPool->push(from, data, size);
+    }
+
+    return ParseReception(from, data, size);
+}
+
+
+bool TheEthManager::ParseReception(eOipv4addr_t from, uint64_t* data, ssize_t size)
+{
+    // the packets of different boards may be parsed in parallel, but the resource of this one cannot change meanwhile
+    if(false == ethBoards->lockRX(from, true))
+    {
+        return true;
+    }
 
     eth::AbstractEthResource* r = ethBoards->get_resource(from);
 
@@ -683,7 +743,7 @@ bool TheEthManager::Reception(eOipv4addr_t from, uint64_t* data, ssize_t size)
     //    yError() << "TheEthManager::Reception cannot get a ethres associated to address" << address;
     }
 
-    lockRX(false);
+    ethBoards->lockRX(from, false);
 
 
     return(true);
@@ -739,20 +799,6 @@ bool TheEthManager::lockTX(bool on)
 }
 
 
-bool TheEthManager::lockRX(bool on)
-{
-    if(on)
-    {
-        rxSem.lock();
-    }
-    else
-    {
-        rxSem.unlock();
-    }
-
-    return true;
-}
-
 bool TheEthManager::lockTXRX(bool on)
 {
     if(on)
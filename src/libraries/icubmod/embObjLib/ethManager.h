@@ -70,6 +70,7 @@ using namespace std;
 #include <ethBoards.h>
 #include <ethSender.h>
 #include <ethReceiver.h>
+#include <ethReceptionPool.h>
 
 
 // -- class TheEthManager
@@ -119,12 +120,18 @@ namespace eth {
 
         const eOipv4addressing_t& getLocalIPV4addressing(void);
 
+        // the period in seconds between two transmissions of EthSender
+        double getTXperiod(void);
+
         bool Transmission(void);
 
         bool CheckPresence(void);
 
         bool Reception(eOipv4addr_t from, uint64_t* data, ssize_t size);
 
+        // it parses a packet holding the lock of its board only. it is called by Reception() or by the EthReceptionPool
+        bool ParseReception(eOipv4addr_t from, uint64_t* data, ssize_t size);
+
         eth::AbstractEthResource* getEthResource(eOipv4addr_t ipv4);
 
         IethResource* getInterface(eOipv4addr_t ipv4, eOprotID32_t id32);
@@ -144,7 +151,7 @@ namespace eth {
 
         bool isCommunicationInitted(void);
 
-        bool createCommunicationObjects(const eOipv4addressing_t &localaddress, int txrate, int rxrate);
+        bool createCommunicationObjects(const eOipv4addressing_t &localaddress, int txrate, int rxrate, bool rxblocking, int rxcore, int rxworkers);
 
         bool initCommunication(yarp::os::Searchable &cfgtotal);
 
@@ -153,7 +160,6 @@ namespace eth {
         bool lock(bool on);
 
         bool lockTX(bool on);
-        bool lockRX(bool on);
         bool lockTXRX(bool on);
 
 
@@ -164,6 +170,7 @@ namespace eth {
         // this semaphore is used to ....
         static std::mutex managerSem;
         // the following two semaphore are used separately or together to stop tx and rx if a change is done on ethboards (in startup and shutdown phases)
+        // reception does not use rxSem: it holds the lock of the board it parses (see EthBoards::lockRX()) which is also taken when the board changes
         static std::mutex txSem;
         static std::mutex rxSem;
 
@@ -179,6 +186,7 @@ namespace eth {
         // periodic threads which use methods of class TheEthManager to transmit / receive + the udp socket
         eth::EthSender* sender;
         eth::EthReceiver* receiver;
+        eth::EthReceptionPool* rxPool;     // it is NULL if the packets are parsed by the receiver itself
         ACE_SOCK_Dgram* UDP_socket;
         bool embBoardsConnected;
 
@@ -62,6 +62,9 @@ bool eth::parser::print(const pc104Data &pc104data)
     yDebug() << "PC104/PC104IpAddress:PC104IpPort = " << pc104data.addressingstring;
     yDebug() << "PC104/PC104TXrate = " << pc104data.txrate;
     yDebug() << "PC104/PC104RXrate = " << pc104data.rxrate;
+    yDebug() << "PC104/PC104RXblocking = " << pc104data.rxblocking;
+    yDebug() << "PC104/PC104RXcore = " << pc104data.rxcore;
+    yDebug() << "PC104/PC104RXworkers = " << pc104data.rxworkers;
 
     return true;
 }
@@ -173,6 +176,27 @@ bool eth::parser::read(yarp::os::Searchable &cfgtotal, pc104Data &pc104data)
         yWarning () << "eth::parser::read() cannot find ETH/PC104RXrate. thus using default value" << pc104data.rxrate;
     }
 
+    // rxblocking, rxcore and rxworkers are optional: by default the rx thread polls the socket every rxrate ms on any core
+    // and it also parses the packets
+    if(cfgtotal.findGroup("PC104").check("PC104RXblocking"))
+    {
+        pc104data.rxblocking = cfgtotal.findGroup("PC104").find("PC104RXblocking").asBool();
+    }
+
+    if(cfgtotal.findGroup("PC104").check("PC104RXcore"))
+    {
+        pc104data.rxcore = cfgtotal.findGroup("PC104").find("PC104RXcore").asInt32();
+    }
+
+    if(cfgtotal.findGroup("PC104").check("PC104RXworkers"))
+    {
+        int value = cfgtotal.findGroup("PC104").find("PC104RXworkers").asInt32();
+        if(value > 0)
+        {
+            pc104data.rxworkers = value;
+        }
+    }
+
     // now i print all the found values
 
     //print(pc104data);
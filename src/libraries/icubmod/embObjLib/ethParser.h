@@ -100,17 +100,22 @@ namespace eth { namespace parser {
         eOipv4addressing_t localaddressing;
         std::uint16_t  txrate;
         std::uint16_t rxrate;
+        bool rxblocking;        // the rx thread waits on the socket instead of polling it every rxrate ms
+        int rxcore;             // if >= 0, the rx thread is pinned to this cpu core
+        int rxworkers;          // if > 0, the received packets are parsed by this number of threads and not by the rx thread
         std::string addressingstring;
         void reset() {
             embBoardsConnected = true;
             localaddressing.addr = eo_common_ipv4addr(10, 0, 1, 104); localaddressing.port = 12345;
             txrate = 1; rxrate = 5;
+            rxblocking = false; rxcore = -1; rxworkers = 0;
             addressingstring = "10.0.1.104:12345";
         }
         void setdefault() {
             embBoardsConnected = true;
             localaddressing.addr = eo_common_ipv4addr(10, 0, 1, 104); localaddressing.port = 12345;
             txrate = 1; rxrate = 5;
+            rxblocking = false; rxcore = -1; rxworkers = 0;
             addressingstring = "10.0.1.104:12345";
         }
     };
@@ -44,11 +44,69 @@ using yarp::os::Log;
 #include "ethManager.h"
 #include "ethResource.h"
 
+#include <chrono>
+
+#if defined(__unix__)
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cstring>
+#include <errno.h>
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - pimpl: private implementation (see scott meyers: item 22 of effective modern c++, item 31 of effective c++
 // --------------------------------------------------------------------------------------------------------------------
 
+#if defined(__linux__)
+
+// the ring of packets is allocated once and recvmmsg() writes directly inside it, so that a single
+// system call retrieves what all the boards have sent since the previous cycle.
+struct eth::EthReceiver::Batch
+{
+    enum { maxPackets = 64 };
+
+    struct mmsghdr      msgs[maxPackets];
+    struct iovec        iovecs[maxPackets];
+    struct sockaddr_in  senders[maxPackets];
+    uint64_t            data[maxPackets][eth::TheEthManager::maxRXpacketsize/8];   // 8-byte aligned as the buffer used by recv()
+
+    Batch()
+    {
+        memset(msgs, 0, sizeof(msgs));
+        for(int i=0; i<maxPackets; i++)
+        {
+            iovecs[i].iov_base = data[i];
+            iovecs[i].iov_len = eth::TheEthManager::maxRXpacketsize;
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &senders[i];
+        }
+    }
+};
+
+static eOipv4addr_t toipv4addr(const struct sockaddr_in &sender)
+{
+    // s_addr is in network order, hence its bytes are already ip1, ip2, ip3, ip4
+    const uint8_t *ip = reinterpret_cast<const uint8_t*>(&sender.sin_addr.s_addr);
+    return eo_common_ipv4addr(ip[0], ip[1], ip[2], ip[3]);
+}
+
+#else
+
+struct eth::EthReceiver::Batch
+{
+};
+
+#endif
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -65,6 +123,16 @@ using namespace eth;
 EthReceiver::EthReceiver(int raterx): PeriodicThread((double)raterx/1000.0)
 {
     rateofthread = raterx;
+    recv_socket = NULL;
+    ethManager = NULL;
+    blocking = false;
+    cpucore = -1;
+    stopping = false;
+#if defined(__linux__)
+    batch = new Batch;
+#else
+    batch = NULL;
+#endif
     yDebug() << "EthReceiver is a PeriodicThread with rxrate =" << rateofthread << "ms";
     // ok, and now i get it from xml file ... if i find it.
 
@@ -88,14 +156,15 @@ EthReceiver::EthReceiver(int raterx): PeriodicThread((double)raterx/1000.0)
 
 void EthReceiver::onStop()
 {
-    // in here i send a small packet to ... myself ?
+    stopping = true;
+    // in here i send a small packet to ... myself ? yes: in blocking mode it wakes up the thread waiting on the socket
     uint8_t tmp = 0;
     ethManager->sendPacket( &tmp, 1, ethManager->getLocalIPV4addressing());
 }
 
 EthReceiver::~EthReceiver()
 {
-
+    delete batch;
 }
 
 bool EthReceiver::config(ACE_SOCK_Dgram *pSocket, TheEthManager* _ethManager)
@@ -136,6 +205,28 @@ bool EthReceiver::config(ACE_SOCK_Dgram *pSocket, TheEthManager* _ethManager)
 }
 
 
+void EthReceiver::setBlockingMode(bool on, int core)
+{
+#if defined(__unix__)
+    blocking = on;
+#else
+    if(on)
+    {
+        yWarning() << "EthReceiver::setBlockingMode(): blocking mode is available only on unix systems, the socket is polled every" << rateofthread << "ms";
+    }
+#endif
+    cpucore = core;
+    if(blocking)
+    {
+        yDebug() << "EthReceiver waits on its socket and checks the presence of the boards every" << rateofthread << "ms";
+    }
+    if(cpucore >= 0)
+    {
+        yDebug() << "EthReceiver is pinned to core" << cpucore;
+    }
+}
+
+
 bool EthReceiver::threadInit()
 {
     yTrace() << "Do some initialization here if needed";
@@ -151,6 +242,24 @@ bool EthReceiver::threadInit()
     pthread_setschedparam(pthread_self(), SCHED_FIFO, &thread_param);
 #endif
 
+#if defined(__linux__)
+    // -1 is the default and means that no core was requested
+    if((-1 != cpucore) && ((cpucore < 0) || (cpucore >= CPU_SETSIZE)))
+    {
+        yError() << "EthReceiver::threadInit() the core" << cpucore << "is out of range [0," << CPU_SETSIZE << "), thus the thread is not pinned to any core";
+    }
+    else if(cpucore >= 0)
+    {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpucore, &cpuset);
+        if(0 != pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset))
+        {
+            yWarning() << "EthReceiver::threadInit() cannot pin the thread to core" << cpucore;
+        }
+    }
+#endif
+
     return true;
 }
 
@@ -164,20 +273,15 @@ uint64_t getRopFrameAge(char *pck)
 
 void EthReceiver::run()
 {
-    ssize_t       incoming_msg_size = 0;
-    ACE_INET_Addr sender_addr;
-    uint64_t      incoming_msg_data[TheEthManager::maxRXpacketsize/8];   // 8-byte aligned local buffer for incoming packet: it must be able to accomodate max size of packet
-    const ssize_t incoming_msg_capacity = TheEthManager::maxRXpacketsize;
+    if(blocking)
+    {
+        runBlocking();
+        return;
+    }
 
 #ifdef NETWORK_PERFORMANCE_BENCHMARK
     m_perEvtVerifier.tick(yarp::os::Time::now());
 #endif
-    
-    
-    int flags = 0;
-#ifndef WIN32
-    flags |= MSG_DONTWAIT;
-#endif
 
     static uint8_t earlyexit_prev = 0;
     static uint8_t earlyexit_prevprev = 0;
@@ -193,15 +297,82 @@ void EthReceiver::run()
 
 
     earlyexit_prevprev = earlyexit_prev;    // save previous early exit
-    earlyexit_prev = 0;                     // consider no early exit this time
 
-    for(int i=0; i<maxUDPpackets; i++)
+    bool drained = (NULL != batch) ? receiveBatched(maxUDPpackets) : receiveOneByOne(maxUDPpackets);
+    earlyexit_prev = drained ? 1 : 0;
+
+    // execute the check on presence of all eth boards.
+    ethManager->CheckPresence();
+}
+
+
+void EthReceiver::runBlocking()
+{
+#if defined(__unix__)
+    // it runs once for the whole life of the thread: it leaves only when onStop() is called, which also sends a packet
+    // to our socket so that poll() returns immediately.
+    struct pollfd pfd;
+    pfd.fd = recv_socket->get_handle();
+    pfd.events = POLLIN;
+
+    const std::chrono::milliseconds presenceperiod(rateofthread);
+    std::chrono::steady_clock::time_point lastcheck = std::chrono::steady_clock::now();
+
+    while(!stopping)
+    {
+        pfd.revents = 0;
+        int ret = poll(&pfd, 1, rateofthread);
+        if((ret < 0) && (EINTR != errno))
+        {
+            yError() << "EthReceiver::runBlocking(): poll() fails with errno" << errno;
+            break;
+        }
+
+        if((ret > 0) && (0 != (pfd.revents & POLLIN)))
+        {
+            // we parse whatever is queued. the boards send at most one packet each per cycle, so a few of them are enough
+            // not to delay the check on presence below.
+            int maxpackets = 2 + ethManager->getNumberOfResources();
+            if(NULL != batch)
+            {
+                receiveBatched(maxpackets);
+            }
+            else
+            {
+                receiveOneByOne(maxpackets);
+            }
+        }
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(now - lastcheck >= presenceperiod)
+        {
+            // execute the check on presence of all eth boards.
+            ethManager->CheckPresence();
+            lastcheck = now;
+        }
+    }
+#endif
+}
+
+
+bool EthReceiver::receiveOneByOne(int maxpackets)
+{
+    ssize_t       incoming_msg_size = 0;
+    ACE_INET_Addr sender_addr;
+    uint64_t      incoming_msg_data[TheEthManager::maxRXpacketsize/8];   // 8-byte aligned local buffer for incoming packet: it must be able to accomodate max size of packet
+    const ssize_t incoming_msg_capacity = TheEthManager::maxRXpacketsize;
+
+    int flags = 0;
+#ifndef WIN32
+    flags |= MSG_DONTWAIT;
+#endif
+
+    for(int i=0; i<maxpackets; i++)
     {
         incoming_msg_size = recv_socket->recv((void *) incoming_msg_data, incoming_msg_capacity, sender_addr, flags);
         if(incoming_msg_size <= 0)
         { // marco.accame: i prefer using <= 0.
-            earlyexit_prev = 1; // yes, we have an early exit
-            break; // we break and do not return because we want to be sure to execute what is after the for() loop
+            return true; // yes, we have an early exit
         }
 
         // we have a packet ... we give it to the ethmanager for it parsing
@@ -209,8 +380,56 @@ void EthReceiver::run()
         ethManager->Reception(ethManager->toipv4addr(sender_addr), incoming_msg_data, incoming_msg_size);
     }
 
-    // execute the check on presence of all eth boards.
-    ethManager->CheckPresence();
+    return false;
+}
+
+
+bool EthReceiver::receiveBatched(int maxpackets)
+{
+#if defined(__linux__)
+    ACE_HANDLE sockfd = recv_socket->get_handle();
+
+    while(maxpackets > 0)
+    {
+        unsigned int n2read = (maxpackets < Batch::maxPackets) ? maxpackets : Batch::maxPackets;
+        for(unsigned int i=0; i<n2read; i++)
+        {   // the kernel overwrites it with the size of the sender address
+            batch->msgs[i].msg_hdr.msg_namelen = sizeof(batch->senders[i]);
+        }
+
+        // with MSG_DONTWAIT it returns the packets already queued in the socket, without waiting for the others
+        int nread = recvmmsg(sockfd, batch->msgs, n2read, MSG_DONTWAIT, NULL);
+        if(nread < 0)
+        {
+            if(ENOSYS == errno)
+            {   // the kernel does not support it: we use recv() from now on
+                yWarning() << "EthReceiver::receiveBatched(): recvmmsg() is not available, using recv() for each packet";
+                delete batch;
+                batch = NULL;
+                return receiveOneByOne(maxpackets);
+            }
+            return true;
+        }
+
+        for(int i=0; i<nread; i++)
+        {
+            if(batch->msgs[i].msg_len > 0)
+            {
+                ethManager->Reception(toipv4addr(batch->senders[i]), batch->data[i], batch->msgs[i].msg_len);
+            }
+        }
+
+        if(nread < static_cast<int>(n2read))
+        {
+            return true;
+        }
+        maxpackets -= nread;
+    }
+
+    return false;
+#else
+    return receiveOneByOne(maxpackets);
+#endif
 }
 
 
@@ -26,6 +26,7 @@
 // -- class EthReceiver
 // -- it is a rate thread created by singleton TheEthManager.
 // -- it regularly wakes up to see if a packet is in its listening socket and it parses that with methods made available by TheEthManager.
+// -- in blocking mode it instead waits on the socket and parses every packet as soon as it arrives.
 
 //#include <ethManager.h>
 
@@ -33,6 +34,8 @@
 
 #include <yarp/os/PeriodicThread.h>
 
+#include <atomic>
+
 
 #ifdef NETWORK_PERFORMANCE_BENCHMARK 
 #include <./tools/include/PeriodicEventsVerifier.h>
@@ -51,10 +54,21 @@ namespace eth {
         ACE_SOCK_Dgram *recv_socket;
         eth::TheEthManager *ethManager;
         double statPrintInterval;
+        // preallocated packets filled by a single recvmmsg() call. it is nullptr if recvmmsg() is not available
+        struct Batch;
+        Batch *batch;
+        bool blocking;
+        int cpucore;
+        std::atomic<bool> stopping;
 #ifdef NETWORK_PERFORMANCE_BENCHMARK 
         Tools::Emb_PeriodicEventVerifier m_perEvtVerifier;
 #endif
 
+        // both of them return true if the socket was drained before reading maxpackets packets
+        bool receiveBatched(int maxpackets);
+        bool receiveOneByOne(int maxpackets);
+        void runBlocking();
+
     public:
 
         enum { EthReceiverDefaultRate = 5, EthReceiverMaxRate = 20 };
@@ -62,6 +76,10 @@ namespace eth {
         EthReceiver(int rxrate);
         ~EthReceiver();
         bool config(ACE_SOCK_Dgram *pSocket, eth::TheEthManager* _ethManager);
+        // to be called before start(). in blocking mode run() never returns until stop(): it waits on the socket and
+        // rxrate is used only as the timeout after which the presence of the boards is checked anyway.
+        // if core >= 0 the thread is also pinned to that cpu core.
+        void setBlockingMode(bool on, int core = -1);
         bool threadInit();
         void run();
         void onStop();
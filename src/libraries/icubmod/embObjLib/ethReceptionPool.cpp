@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "ethReceptionPool.h"
+
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <cstring>
+
+#include <yarp/os/Log.h>
+#include <yarp/os/LogStream.h>
+
+#include "ethManager.h"
+
+#if defined(__unix__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - the class
+// --------------------------------------------------------------------------------------------------------------------
+
+
+// - class eth::EthReceptionPool
+
+using namespace eth;
+
+static_assert(static_cast<int>(EthReceptionPool::maxPacketSize) == static_cast<int>(TheEthManager::maxRXpacketsize), "EthReceptionPool must hold any received packet");
+
+
+EthReceptionPool::EthReceptionPool(TheEthManager *_ethManager, int numofworkers)
+{
+    ethManager = _ethManager;
+
+    if(numofworkers > maxWorkers)
+    {
+        yWarning() << "EthReceptionPool can have at most" << maxWorkers << "workers, not" << numofworkers;
+        numofworkers = maxWorkers;
+    }
+
+    for(int i=0; i<numofworkers; i++)
+    {
+        Worker *w = new Worker;
+        w->head = 0;
+        w->count = 0;
+        w->stopping = false;
+        workers.push_back(w);
+    }
+
+    yDebug() << "EthReceptionPool parses the received packets with" << workers.size() << "workers";
+}
+
+
+EthReceptionPool::~EthReceptionPool()
+{
+    stop();
+    for(size_t i=0; i<workers.size(); i++)
+    {
+        delete workers[i];
+    }
+}
+
+
+int EthReceptionPool::numberOfWorkers() const
+{
+    return static_cast<int>(workers.size());
+}
+
+
+bool EthReceptionPool::start()
+{
+    for(size_t i=0; i<workers.size(); i++)
+    {
+        Worker *w = workers[i];
+        w->stopping = false;
+        w->thread = std::thread(&EthReceptionPool::work, this, w);
+
+#if defined(__unix__)
+        // same policy and priority of EthReceiver, otherwise the receiver would always preempt them
+        struct sched_param thread_param;
+        thread_param.sched_priority = sched_get_priority_max(SCHED_FIFO)/2; // = 49
+        pthread_setschedparam(w->thread.native_handle(), SCHED_FIFO, &thread_param);
+#endif
+    }
+
+    return true;
+}
+
+
+void EthReceptionPool::stop()
+{
+    for(size_t i=0; i<workers.size(); i++)
+    {
+        Worker *w = workers[i];
+        {
+            std::lock_guard<std::mutex> lck(w->mtx);
+            w->stopping = true;
+        }
+        w->notempty.notify_one();
+        w->notfull.notify_all();
+    }
+
+    for(size_t i=0; i<workers.size(); i++)
+    {
+        if(workers[i]->thread.joinable())
+        {
+            workers[i]->thread.join();
+        }
+    }
+}
+
+
+bool EthReceptionPool::push(eOipv4addr_t from, const uint64_t *data, ssize_t size)
+{
+    if((size <= 0) || (size > maxPacketSize) || workers.empty())
+    {
+        return false;
+    }
+
+    // the board is identified by the last byte of its address, as in EthBoards
+    uint8_t ip4 = 0;
+    eo_common_ipv4addr_to_decimal(from, NULL, NULL, NULL, &ip4);
+    Worker *w = workers[ip4 % workers.size()];
+
+    std::unique_lock<std::mutex> lck(w->mtx);
+    w->notfull.wait(lck, [w]{ return w->stopping || (w->count < queueCapacity); });
+    if(w->stopping)
+    {
+        return false;
+    }
+
+    Packet &p = w->ring[(w->head + w->count) % queueCapacity];
+    p.from = from;
+    p.size = size;
+    memcpy(p.data, data, size);
+    w->count++;
+    lck.unlock();
+
+    w->notempty.notify_one();
+    return true;
+}
+
+
+void EthReceptionPool::work(Worker *w)
+{
+    std::unique_lock<std::mutex> lck(w->mtx);
+
+    for(;;)
+    {
+        w->notempty.wait(lck, [w]{ return w->stopping || (w->count > 0); });
+        if(w->stopping)
+        {
+            return;
+        }
+
+        // the slot at head is not touched by push() until count is decremented, so we parse it without holding the lock
+        Packet &p = w->ring[w->head];
+        lck.unlock();
+
+        ethManager->ParseReception(p.from, p.data, p.size);
+
+        lck.lock();
+        w->head = (w->head + 1) % queueCapacity;
+        w->count--;
+        w->notfull.notify_one();
+    }
+}
+
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
+
+
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+// - include guard ----------------------------------------------------------------------------------------------------
+
+#ifndef _ETHRECEPTIONPOOL_H_
+#define _ETHRECEPTIONPOOL_H_
+
+// -- class EthReceptionPool
+// -- it is an optional pool of threads owned by TheEthManager which parses the packets received by EthReceiver.
+// -- the packets of a board always go to the same worker, so that they are parsed in order of arrival, whereas
+// -- the packets of different boards may be parsed in parallel.
+
+#include "EoCommon.h"
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace eth {
+
+    class TheEthManager;
+
+    class EthReceptionPool
+    {
+    public:
+
+        enum { maxWorkers = 8, queueCapacity = 64, maxPacketSize = 1496 };
+
+        EthReceptionPool(TheEthManager *_ethManager, int numofworkers);
+        ~EthReceptionPool();
+
+        bool start();
+        void stop();
+
+        int numberOfWorkers() const;
+
+        // copies the packet in the queue of the worker of the board. it waits if the queue is full.
+        bool push(eOipv4addr_t from, const uint64_t *data, ssize_t size);
+
+    private:
+
+        struct Packet
+        {
+            eOipv4addr_t from;
+            ssize_t size;
+            uint64_t data[maxPacketSize/8];
+        };
+
+        struct Worker
+        {
+            std::thread thread;
+            std::mutex mtx;
+            std::condition_variable notempty;
+            std::condition_variable notfull;
+            Packet ring[queueCapacity];
+            size_t head;        // next packet to parse
+            size_t count;       // packets in the ring
+            bool stopping;
+        };
+
+        TheEthManager *ethManager;
+        std::vector<Worker*> workers;
+
+        void work(Worker *w);
+    };
+
+} // namespace eth
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
+
+
@@ -768,6 +768,13 @@ bool EthResource::getRemoteValues(const std::vector<eOprotID32_t> &id32s, const
 }
 
 
+std::future<bool> EthResource::getRemoteValuesAsync(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout, const std::function<void(bool)> &onreply)
+{
+    theNVmanager& nvman = theNVmanager::getInstance();
+    return nvman.askasync(&transceiver, id32s, values, timeout, onreply);
+}
+
+
 bool EthResource::setRemoteValue(const eOprotID32_t id32, void *value)
 {
     theNVmanager& nvman = theNVmanager::getInstance();
@@ -780,6 +787,12 @@ bool EthResource::setcheckRemoteValue(const eOprotID32_t id32, void *value, cons
     return nvman.setcheck(properties.ipv4addr, id32, value, retries, waitbeforecheck, timeout);
 }
 
+bool EthResource::setcheckRemoteValues(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries, const double waitbeforecheck, const double timeout)
+{
+    theNVmanager& nvman = theNVmanager::getInstance();
+    return nvman.setcheck(&transceiver, id32s, values, retries, waitbeforecheck, timeout);
+}
+
 bool EthResource::CANPrintHandler(eOmn_info_basic_t *infobasic)
 {
     char str[256];
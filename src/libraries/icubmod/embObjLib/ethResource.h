@@ -65,12 +65,18 @@ namespace eth {
 
         bool getRemoteValues(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.500);
 
+        // it does not wait the replies: see theNVmanager::askasync()
+        std::future<bool> getRemoteValuesAsync(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.500, const std::function<void(bool)> &onreply = nullptr);
+
         // FAKE: it just returns true or ... does the same
         bool setRemoteValue(const eOprotID32_t id32, void *value);
 
         // FAKE: it just returns true.
         bool setcheckRemoteValue(const eOprotID32_t id32, void *value, const unsigned int retries = 10, const double waitbeforecheck = 0.001, const double timeout = 0.050);
 
+        // as setcheckRemoteValue() but all the values are set and verified together
+        bool setcheckRemoteValues(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries = 10, const double waitbeforecheck = 0.001, const double timeout = 0.050);
+
         // FAKE: it just returns true.
         bool getLocalValue(const eOprotID32_t id32, void *value);
 
@@ -40,11 +40,56 @@ using yarp::os::Log;
 
 #include "ethManager.h"
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <cstring>
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - pimpl: private implementation (see scott meyers: item 22 of effective modern c++, item 31 of effective c++
 // --------------------------------------------------------------------------------------------------------------------
 
+#if defined(__linux__)
+
+// the packets are not copied: iovecs point to the ropframes inside each EthResource, which TheEthManager keeps
+// unchanged until flush() as it holds its tx lock for the whole Transmission().
+struct eth::EthSender::Batch
+{
+    enum { maxPackets = 64 };
+
+    struct mmsghdr      msgs[maxPackets];
+    struct iovec        iovecs[maxPackets];
+    struct sockaddr_in  destinations[maxPackets];
+    unsigned int        size;
+
+    Batch()
+    {
+        memset(msgs, 0, sizeof(msgs));
+        memset(destinations, 0, sizeof(destinations));
+        for(int i=0; i<maxPackets; i++)
+        {
+            destinations[i].sin_family = AF_INET;
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &destinations[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(destinations[i]);
+        }
+        size = 0;
+    }
+};
+
+#else
+
+struct eth::EthSender::Batch
+{
+};
+
+#endif
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -62,6 +107,14 @@ using namespace eth;
 EthSender::EthSender(int txrate) : PeriodicThread((double)txrate/1000.0)
 {
     rateofthread = txrate;
+    p_sendData = NULL;
+    send_socket = NULL;
+    ethManager = NULL;
+#if defined(__linux__)
+    batch = new Batch;
+#else
+    batch = NULL;
+#endif
     yDebug() << "EthSender is a PeriodicThread with txrate =" << rateofthread << "ms";
     yTrace();
 
@@ -77,7 +130,7 @@ EthSender::EthSender(int txrate) : PeriodicThread((double)txrate/1000.0)
 
 EthSender::~EthSender()
 {
-
+    delete batch;
 }
 
 bool EthSender::config(ACE_SOCK_Dgram *pSocket, TheEthManager* _ethManager)
@@ -108,6 +161,73 @@ bool EthSender::threadInit()
 }
 
 
+bool EthSender::queue(const void *udpframe, size_t len, const eOipv4addressing_t &toaddressing)
+{
+    if(NULL == batch)
+    {
+        return (ethManager->sendPacket(udpframe, len, toaddressing) >= 0);
+    }
+
+#if defined(__linux__)
+    if(Batch::maxPackets == batch->size)
+    {
+        flush();
+    }
+
+    uint8_t ip1, ip2, ip3, ip4;
+    eo_common_ipv4addr_to_decimal(toaddressing.addr, &ip1, &ip2, &ip3, &ip4);
+
+    unsigned int i = batch->size++;
+    batch->destinations[i].sin_port = htons(toaddressing.port);
+    batch->destinations[i].sin_addr.s_addr = htonl((ip1 << 24) | (ip2 << 16) | (ip3 << 8) | (ip4));
+    batch->iovecs[i].iov_base = const_cast<void*>(udpframe);
+    batch->iovecs[i].iov_len = len;
+#endif
+
+    return true;
+}
+
+
+void EthSender::flush()
+{
+#if defined(__linux__)
+    if((NULL == batch) || (0 == batch->size))
+    {
+        return;
+    }
+
+    ACE_HANDLE sockfd = send_socket->get_handle();
+    unsigned int sent = 0;
+    while(sent < batch->size)
+    {
+        int n = sendmmsg(sockfd, &batch->msgs[sent], batch->size - sent, 0);
+        if(n > 0)
+        {
+            sent += n;
+        }
+        else if(ENOSYS == errno)
+        {   // the kernel does not support it: we send the rest one by one and we use send() from now on
+            yWarning() << "EthSender::flush(): sendmmsg() is not available, using send() for each packet";
+            for(; sent < batch->size; sent++)
+            {
+                ACE_INET_Addr inetaddr(&batch->destinations[sent], sizeof(batch->destinations[sent]));
+                send_socket->send(batch->iovecs[sent].iov_base, batch->iovecs[sent].iov_len, inetaddr);
+            }
+            delete batch;
+            batch = NULL;
+            return;
+        }
+        else
+        {   // as a failing send() would do, we drop only the packet that cannot be sent
+            sent++;
+        }
+    }
+
+    batch->size = 0;
+#endif
+}
+
+
 
 void EthSender::run()
 {
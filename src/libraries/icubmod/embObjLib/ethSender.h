@@ -33,6 +33,8 @@
 
 #include <yarp/os/PeriodicThread.h>
 
+#include "EoCommon.h"
+
 #ifdef NETWORK_PERFORMANCE_BENCHMARK 
 #include <./tools/include/PeriodicEventsVerifier.h>
 #endif
@@ -50,6 +52,9 @@ namespace eth {
         uint8_t *p_sendData;
         TheEthManager *ethManager;
         ACE_SOCK_Dgram *send_socket;
+        // packets queued during a Transmission() and sent by a single sendmmsg(). it is nullptr if sendmmsg() is not available
+        struct Batch;
+        Batch *batch;
 
 #ifdef NETWORK_PERFORMANCE_BENCHMARK 
         Tools::Emb_PeriodicEventVerifier m_perEvtVerifier;
@@ -66,6 +71,11 @@ namespace eth {
         bool config(ACE_SOCK_Dgram *pSocket, TheEthManager* _ethManager);
         bool threadInit();
 
+        // used by TheEthManager::Transmission(). the packet must stay valid until flush()
+        bool queue(const void *udpframe, size_t len, const eOipv4addressing_t &toaddressing);
+        // sends all the queued packets
+        void flush();
+
     };
 
 } // namespace eth
@@ -237,6 +237,17 @@ bool FakeEthResource::getRemoteValues(const std::vector<eOprotID32_t> &id32s, co
     return true;
 }
 
+std::future<bool> FakeEthResource::getRemoteValuesAsync(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout, const std::function<void(bool)> &onreply)
+{
+    if(onreply)
+    {
+        onreply(true);
+    }
+    std::promise<bool> replied;
+    replied.set_value(true);
+    return replied.get_future();
+}
+
 
 
 bool FakeEthResource::setRemoteValue(const eOprotID32_t id32, void *value)
@@ -249,6 +260,11 @@ bool FakeEthResource::setcheckRemoteValue(const eOprotID32_t id32, void *value,
     return true;
 }
 
+bool FakeEthResource::setcheckRemoteValues(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries, const double waitbeforecheck, const double timeout)
+{
+    return true;
+}
+
 
 
 bool FakeEthResource::CANPrintHandler(eOmn_info_basic_t *infobasic)
@@ -57,10 +57,14 @@ namespace eth {
 
         bool getRemoteValues(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.500);
 
+        std::future<bool> getRemoteValuesAsync(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.500, const std::function<void(bool)> &onreply = nullptr);
+
         bool setRemoteValue(const eOprotID32_t id32, void *value);
 
         bool setcheckRemoteValue(const eOprotID32_t id32, void *value, const unsigned int retries = 10, const double waitbeforecheck = 0.001, const double timeout = 0.050);
 
+        bool setcheckRemoteValues(const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries = 10, const double waitbeforecheck = 0.001, const double timeout = 0.050);
+
         bool getLocalValue(const eOprotID32_t id32,  void *value);
 
         bool setLocalValue(const eOprotID32_t id32,  const void *value, bool overrideROprotection = false);
@@ -38,6 +38,8 @@
 #include <condition_variable>
 #include <chrono>
 #include <map>
+#include <deque>
+#include <thread>
 #include <cstring>
 
 #include "EoProtocol.h"
@@ -69,6 +71,14 @@ struct eth::theNVmanager::Impl
         ACE_thread_t            owner {0};
         double                  timeofwait {0};
         double                  timeofpost {0};
+        // used only by askasync(): the transaction is completed by the dispatcher thread and not by a waiting caller
+        bool                    async {false};
+        eth::HostTransceiver*   transceiver {nullptr};
+        std::vector<eOprotID32_t> id32s {};
+        std::vector<void*>      values {};
+        std::function<void(bool)> onreply {};
+        std::promise<bool>      promise {};
+        std::chrono::steady_clock::time_point deadline {};
 
         askTransaction() :
             expectedrops(0), receivedrops(0), _ipv4(0), _id32(0), signature(eo_rop_SIGNATUREdummy), owner(0), timeofwait(0), timeofpost(0)
@@ -109,13 +119,15 @@ struct eth::theNVmanager::Impl
             timeofwait = SystemClock::nowSystem();
             const int timeout_millis = static_cast<int>(1000.0 * timeout);
             std::unique_lock<std::mutex> lck(mtx_semaphore);
-            bool r = (cv_semaphore.wait_for(lck, std::chrono::milliseconds(timeout_millis)) == cv_status::no_timeout);
+            // the predicate covers the replies which arrive before we start to wait
+            bool r = cv_semaphore.wait_for(lck, std::chrono::milliseconds(timeout_millis), [this]{ return receivedrops >= expectedrops; });
             numofrxrops = receivedrops;
             return r;
         }
 
         bool post()
         {
+            std::lock_guard<std::mutex> lck(mtx_semaphore);
             receivedrops++;
             if(receivedrops == expectedrops)
             {
@@ -124,6 +136,12 @@ struct eth::theNVmanager::Impl
             }
             return true;
         }
+
+        bool completed()
+        {
+            std::lock_guard<std::mutex> lck(mtx_semaphore);
+            return (receivedrops >= expectedrops);
+        }
     };
 
 
@@ -134,6 +152,14 @@ struct eth::theNVmanager::Impl
         std::multimap<std::uint64_t, askTransaction*> themap {};
         std::uint32_t sequence {0};
         std::uint32_t filler {0};
+        // the async transactions which have received all their replies. they are already out of themap
+        std::deque<askTransaction*> completed {};
+        std::condition_variable dispatch {};
+        bool dispatcherstarted {false};
+        // the async transactions whose onreply() must be called, with their result. they are served by the caller threads
+        std::deque<std::pair<askTransaction*, bool>> callbacks {};
+        std::condition_variable callback {};
+        size_t idlecallers {0};
 
         Data() { reset(); }
         void reset()
@@ -199,7 +225,16 @@ struct eth::theNVmanager::Impl
                 return false;
             }
 
-            (*it).second->post();
+            askTransaction *transaction = (*it).second;
+            transaction->post();
+
+            if((true == transaction->async) && (true == transaction->completed()))
+            {
+                // nobody waits for it: we pass it to the dispatcher thread
+                themap.erase(it);
+                completed.push_back(transaction);
+                dispatch.notify_one();
+            }
 
             return true;
         }
@@ -299,6 +334,17 @@ struct eth::theNVmanager::Impl
 
     bool ask(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout);
 
+    std::future<bool> askasync(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout, const std::function<void(bool)> &onreply);
+    bool setcheck(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries, double waitbeforecheck, double timeout);
+
+    // the thread which completes the async transactions, either when all their replies have arrived or when they expire
+    void dispatcher();
+    void finalise(askTransaction *transaction, const bool replied);
+    void resolve(askTransaction *transaction, const bool ok);
+    // the threads which call onreply() of the async transactions on behalf of the dispatcher
+    void handover(askTransaction *transaction, const bool ok);
+    void caller();
+
     bool check(eth::HostTransceiver *t, const eOprotID32_t id32, const void *value, const double timeout, const unsigned int retries);
 
     bool signatureisvalid(const std::uint32_t signature);
@@ -992,6 +1038,325 @@ bool eth::theNVmanager::Impl::ask(eth::HostTransceiver *t, const std::vector<eOp
 }
 
 
+std::future<bool> eth::theNVmanager::Impl::askasync(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout, const std::function<void(bool)> &onreply)
+{
+    askTransaction* transaction = new askTransaction;
+    std::future<bool> future = transaction->promise.get_future();
+    transaction->onreply = onreply;
+
+    if(false == validparameters(t, id32s, values))
+    {
+        resolve(transaction, false);
+        return future;
+    }
+
+    // 1. prepare the transaction. the dispatcher thread will complete it
+
+    transaction->async = true;
+    transaction->transceiver = t;
+    transaction->id32s = id32s;
+    transaction->values = values;
+    transaction->deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(static_cast<std::int64_t>(1000000.0 * timeout));
+
+    std::uint32_t assignedsignature = 0;
+
+    data.lock();
+
+    data.insert(transaction, t->getIPv4(), id32s, assignedsignature);
+
+    if(false == data.dispatcherstarted)
+    {
+        // it lives as long as theNVmanager, hence as long as the process
+        std::thread(&eth::theNVmanager::Impl::dispatcher, this).detach();
+        data.dispatcherstarted = true;
+    }
+
+    data.unlock();
+
+    // the dispatcher may have to wake up earlier to manage the deadline of this transaction
+    data.dispatch.notify_one();
+
+    // 2. send a request to all the id32s
+
+    for(int i=0; i<id32s.size(); i++)
+    {
+        if(false == t->addROPask(id32s[i], assignedsignature))
+        {
+            const AbstractEthResource::Properties & props = getboardproperties(t);
+            yError() << "theNVmanager::Impl::askasync() fails t->addROPask() to BOARD" << props.boardnameString << "IP" << props.ipv4addrString << "for nv" << getid32string(id32s[i]);
+
+            // remove the transaction, unless the dispatcher has already expired it
+            data.lock();
+            std::multimap<std::uint64_t, askTransaction*>::iterator it = data.themap.find(static_cast<std::uint64_t>(assignedsignature));
+            bool stillhere = (data.themap.end() != it);
+            if(stillhere)
+            {
+                data.themap.erase(it);
+            }
+            data.unlock();
+
+            if(stillhere)
+            {
+                resolve(transaction, false);
+            }
+
+            return future;
+        }
+    }
+
+    // 3. the caller does not wait
+    return future;
+}
+
+
+void eth::theNVmanager::Impl::dispatcher()
+{
+    std::unique_lock<std::mutex> lck(data.locker);
+
+    for(;;)
+    {
+        std::vector<askTransaction*> replied;
+        std::vector<askTransaction*> expired;
+
+        replied.assign(data.completed.begin(), data.completed.end());
+        data.completed.clear();
+
+        // the async transactions still in the map are waiting for replies. we remove the expired ones
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point wakeup = now + std::chrono::seconds(1);
+        std::multimap<std::uint64_t, askTransaction*>::iterator it = data.themap.begin();
+        while(data.themap.end() != it)
+        {
+            askTransaction *transaction = (*it).second;
+            if((true == transaction->async) && (transaction->deadline <= now))
+            {
+                expired.push_back(transaction);
+                it = data.themap.erase(it);
+            }
+            else
+            {
+                if((true == transaction->async) && (transaction->deadline < wakeup))
+                {
+                    wakeup = transaction->deadline;
+                }
+                it++;
+            }
+        }
+
+        if(replied.empty() && expired.empty())
+        {
+            data.dispatch.wait_until(lck, wakeup);
+            continue;
+        }
+
+        // finalise() hands the callbacks over to the caller threads under the same lock, hence we release it
+        lck.unlock();
+
+        for(size_t i=0; i<replied.size(); i++)
+        {
+            finalise(replied[i], true);
+        }
+
+        for(size_t i=0; i<expired.size(); i++)
+        {
+            finalise(expired[i], false);
+        }
+
+        lck.lock();
+    }
+}
+
+
+void eth::theNVmanager::Impl::finalise(askTransaction *transaction, const bool replied)
+{
+    eth::HostTransceiver *t = transaction->transceiver;
+    bool ok = replied;
+
+    if(false == replied)
+    {
+        // it is out of the map, hence no more replies can reach it
+        const AbstractEthResource::Properties & props = getboardproperties(t);
+        yError() << "theNVmanager::Impl::askasync() had a timeout for BOARD" << props.boardnameString << "IP" << props.ipv4addrString << "w/ multiple NVs. Received only" << transaction->receivedrops << "out of" << transaction->id32s.size();
+    }
+    else
+    {
+        // we can retrieve the values now
+        for(size_t i=0; i<transaction->id32s.size(); i++)
+        {
+            if(false == t->read(transaction->id32s[i], transaction->values[i]))
+            {
+                const AbstractEthResource::Properties & props = getboardproperties(t);
+                yError() << "theNVmanager::Impl::askasync() fails t->read() for BOARD" << props.boardnameString << "IP" << props.ipv4addrString << "and nv" << getid32string(transaction->id32s[i]);
+                ok = false;
+            }
+        }
+    }
+
+    if(transaction->onreply)
+    {
+        handover(transaction, ok);
+    }
+    else
+    {
+        resolve(transaction, ok);
+    }
+}
+
+
+void eth::theNVmanager::Impl::resolve(askTransaction *transaction, const bool ok)
+{
+    // the callback goes first, so that who waits on the future finds its effects
+    if(transaction->onreply)
+    {
+        transaction->onreply(ok);
+    }
+    transaction->promise.set_value(ok);
+    delete transaction;
+}
+
+
+void eth::theNVmanager::Impl::handover(askTransaction *transaction, const bool ok)
+{
+    // onreply() may be slow or may wait for other async transactions, which only the dispatcher can complete. hence it
+    // runs in a caller thread. we start a new one whenever they are all busy, so that a blocked onreply() never stops the others
+    std::lock_guard<std::mutex> lck(data.locker);
+
+    data.callbacks.push_back(std::make_pair(transaction, ok));
+
+    if(data.idlecallers < data.callbacks.size())
+    {
+        // it lives as long as theNVmanager, as the dispatcher. it counts as idle until it takes its first transaction
+        std::thread(&eth::theNVmanager::Impl::caller, this).detach();
+        data.idlecallers++;
+    }
+
+    data.callback.notify_one();
+}
+
+
+void eth::theNVmanager::Impl::caller()
+{
+    std::unique_lock<std::mutex> lck(data.locker);
+
+    for(;;)
+    {
+        data.callback.wait(lck, [this] { return (false == data.callbacks.empty()); });
+
+        std::pair<askTransaction*, bool> item = data.callbacks.front();
+        data.callbacks.pop_front();
+        data.idlecallers--;
+
+        lck.unlock();
+        resolve(item.first, item.second);
+        lck.lock();
+
+        data.idlecallers++;
+    }
+}
+
+
+bool eth::theNVmanager::Impl::setcheck(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries, double waitbeforecheck, double timeout)
+{
+    if(false == validparameters(t, id32s, values))
+    {
+        return false;
+    }
+
+    // the remote board must fit the replies of a request into its own packets, hence we dont load in the transceiver
+    // more than this amount of bytes per transmission. we use the smallest size of packet and wait one transmission
+    // period of EthSender before we load more.
+    const size_t maxbytesperpacket = eth::HostTransceiver::defMaxSizeOfTXpacket / 2;
+    const double txperiod = eth::TheEthManager::instance()->getTXperiod();
+
+    std::vector<std::vector<std::uint8_t>> readback(id32s.size());
+    std::vector<size_t> pending(id32s.size());
+    for(size_t i=0; i<id32s.size(); i++)
+    {
+        readback[i].resize(sizeofnv(id32s[i]));
+        pending[i] = i;
+    }
+
+    unsigned int attempt = 0;
+    unsigned int maxattempts = retries + 1;
+
+    for(attempt=0; (attempt<maxattempts) && (false == pending.empty()); attempt++)
+    {
+        size_t loaded = 0;
+        for(size_t k=0; k<pending.size(); k++)
+        {
+            size_t i = pending[k];
+            if((loaded > 0) && (loaded + readback[i].size() > maxbytesperpacket))
+            {
+                SystemClock::delaySystem(txperiod);
+                loaded = 0;
+            }
+            loaded += readback[i].size();
+
+            if(false == set(t, id32s[i], values[i]))
+            {
+                const AbstractEthResource::Properties & props = getboardproperties(t);
+                yWarning() << "theNVmanager::Impl::setcheck(vector<>) had an error while calling set() in BOARD" << props.boardnameString << "with IP" << props.ipv4addrString << "at attempt #" << attempt+1;
+            }
+        }
+
+        // ok, now i wait some time before asking the values back for verification
+        SystemClock::delaySystem(waitbeforecheck);
+
+        // one transaction per variable: a lost reply costs the retry of its variable only
+        std::vector<std::future<bool>> replies(pending.size());
+        loaded = 0;
+        for(size_t k=0; k<pending.size(); k++)
+        {
+            size_t i = pending[k];
+            if((loaded > 0) && (loaded + readback[i].size() > maxbytesperpacket))
+            {
+                SystemClock::delaySystem(txperiod);
+                loaded = 0;
+            }
+            loaded += readback[i].size();
+
+            replies[k] = askasync(t, {id32s[i]}, {readback[i].data()}, timeout, nullptr);
+        }
+
+        std::vector<size_t> notverified;
+        for(size_t k=0; k<pending.size(); k++)
+        {
+            size_t i = pending[k];
+            if((false == replies[k].get()) || (0 != std::memcmp(values[i], readback[i].data(), readback[i].size())))
+            {
+                notverified.push_back(i);
+            }
+        }
+
+        if(false == notverified.empty())
+        {
+            const AbstractEthResource::Properties & props = getboardproperties(t);
+            yWarning() << "theNVmanager::Impl::setcheck(vector<>) could not verify" << notverified.size() << "out of" << pending.size() << "NVs in BOARD" << props.boardnameString << "with IP" << props.ipv4addrString << "at attempt #" << attempt+1;
+        }
+
+        pending.swap(notverified);
+    }
+
+    if(false == pending.empty())
+    {
+        const AbstractEthResource::Properties & props = getboardproperties(t);
+        for(size_t k=0; k<pending.size(); k++)
+        {
+            yError() << "FATAL: theNVmanager::Impl::setcheck(vector<>) could not set and verify ID" << getid32string(id32s[pending[k]]) << "in BOARD" << props.boardnameString << "with IP" << props.ipv4addrString << " even after " << attempt << "attempts";
+        }
+        return false;
+    }
+
+    if(attempt > 1)
+    {
+        const AbstractEthResource::Properties & props = getboardproperties(t);
+        yWarning() << "theNVmanager::Impl::setcheck(vector<>) has set and verified" << id32s.size() << "NVs in BOARD" << props.boardnameString << "with IP" << props.ipv4addrString << "at attempt #" << attempt;
+    }
+
+    return true;
+}
+
+
 bool eth::theNVmanager::Impl::set(eth::HostTransceiver *t, const eOprotID32_t id32, const void *value)
 {
 
@@ -1183,6 +1548,28 @@ bool eth::theNVmanager::ask(eth::HostTransceiver *t, const std::vector<eOprotID3
     return pImpl->ask(t, id32s, values, timeout);
 }
 
+std::future<bool> eth::theNVmanager::askasync(const eOprotIP_t ipv4, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout, const std::function<void(bool)> &onreply)
+{
+    eth::HostTransceiver *t = pImpl->transceiver(ipv4);
+    return pImpl->askasync(t, id32s, values, timeout, onreply);
+}
+
+std::future<bool> eth::theNVmanager::askasync(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout, const std::function<void(bool)> &onreply)
+{
+    return pImpl->askasync(t, id32s, values, timeout, onreply);
+}
+
+bool eth::theNVmanager::setcheck(const eOprotIP_t ipv4, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries, double waitbeforecheck, double timeout)
+{
+    eth::HostTransceiver *t = pImpl->transceiver(ipv4);
+    return pImpl->setcheck(t, id32s, values, retries, waitbeforecheck, timeout);
+}
+
+bool eth::theNVmanager::setcheck(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries, double waitbeforecheck, double timeout)
+{
+    return pImpl->setcheck(t, id32s, values, retries, waitbeforecheck, timeout);
+}
+
 bool eth::theNVmanager::set(eth::HostTransceiver *t, const eOprotID32_t id32, const void *value)
 {
     return pImpl->set(t, id32, value);
@@ -26,6 +26,8 @@
 
 #include <vector>
 #include <cstdint>
+#include <functional>
+#include <future>
 
 #include "EoProtocol.h"
 #include <hostTransceiver.hpp>
@@ -97,6 +99,20 @@ namespace eth {
         bool ask(const eOprotIP_t ipv4, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.5);
         bool ask(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.5);
 
+        // asynchronous version of the above: it sends the ask<> ROPs and returns at once, so that the caller can keep many requests
+        // outstanding on the same board and on different boards. when all the replies have arrived, an internal thread copies them
+        // into values, calls onreply(true) and makes the returned future ready with true. if they do not arrive within timeout,
+        // it does the same with false. the board and the memory pointed by values must stay valid until the future is ready.
+        // onreply() is called by another internal thread, so it may take its time and may use theNVmanager, also waiting for
+        // the futures of other askasync() or calling setcheck() of many variables, without delaying the other transactions.
+        std::future<bool> askasync(const eOprotIP_t ipv4, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.5, const std::function<void(bool)> &onreply = nullptr);
+        std::future<bool> askasync(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const double timeout = 0.5, const std::function<void(bool)> &onreply = nullptr);
+
+        // as setcheck() but for many network variables of the same board: it sets them all, waits waitbeforecheck once and asks them
+        // all back with askasync(). at the next attempt it sets and checks again only the variables which were not verified.
+        bool setcheck(const eOprotIP_t ipv4, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries = 10, double waitbeforecheck = 0.001, double timeout = 0.5);
+        bool setcheck(eth::HostTransceiver *t, const std::vector<eOprotID32_t> &id32s, const std::vector<void*> &values, const unsigned int retries = 10, double waitbeforecheck = 0.001, double timeout = 0.5);
+
 
         // tobedone: i want to group several requests before i start to wait.
         // i need:
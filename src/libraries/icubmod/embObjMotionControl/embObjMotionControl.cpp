@@ -98,6 +98,7 @@ bool embObjMotionControl::alloc(int nj)
     _axisMap = allocAndCheck<int>(nj);
 
     _encodersStamp = allocAndCheck<double>(nj);
+    _statusSnapshot.resize(nj);
     _gearbox_M2J = allocAndCheck<double>(nj);
     _gearbox_E2J = allocAndCheck<double>(nj);
     _deadzone = allocAndCheck<double>(nj);
@@ -1296,6 +1297,13 @@ bool embObjMotionControl::init()
 
 
 
+    // the configurations of joints and motors are sent all together and then verified all together,
+    // rather than one at a time, so that we wait the round trip to the board only once
+    std::vector<eOprotID32_t> cfgid32s;
+    std::vector<void*> cfgvalues;
+    std::vector<eOmc_joint_config_t> jconfigs(_njoints);
+    std::vector<eOmc_motor_config_t> motorconfigs(_njoints);
+
     //////////////////////////////////////////
     // invia la configurazione dei GIUNTI   //
     //////////////////////////////////////////
@@ -1304,7 +1312,7 @@ bool embObjMotionControl::init()
         int fisico = _axisMap[logico];
         protid = eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_joint, fisico, eoprot_tag_mc_joint_config);
 
-        eOmc_joint_config_t jconfig = {0};
+        eOmc_joint_config_t &jconfig = jconfigs[logico];
         memset(&jconfig, 0, sizeof(eOmc_joint_config_t));
         yarp::dev::Pid tmp; 
         tmp = _measureConverter->convert_pid_to_machine(yarp::dev::VOCAB_PIDTYPE_POSITION,_trj_pids[logico].pid, fisico);
@@ -1358,18 +1366,8 @@ bool embObjMotionControl::init()
         jconfig.kalman_params.R = _kalman_params[logico].R;
         jconfig.kalman_params.P0 = _kalman_params[logico].P0;
 
-        if(false == res->setcheckRemoteValue(protid, &jconfig, 10, 0.010, 0.050))
-        {
-            yError() << "FATAL: embObjMotionControl::init() had an error while calling setcheckRemoteValue() for joint config fisico #" << fisico << "in "<< getBoardInfo();
-            return false;
-        }
-        else
-        {
-            if(behFlags.verbosewhenok)
-            {
-                yDebug() << "embObjMotionControl::init() correctly configured joint config fisico #" << fisico << "in "<< getBoardInfo();
-            }
-        }
+        cfgid32s.push_back(protid);
+        cfgvalues.push_back(&jconfig);
     }
 
 
@@ -1383,7 +1381,8 @@ bool embObjMotionControl::init()
         int fisico = _axisMap[logico];
 
         protid = eoprot_ID_get(eoprot_endpoint_motioncontrol, eoprot_entity_mc_motor, fisico, eoprot_tag_mc_motor_config);
-        eOmc_motor_config_t motor_cfg = {0};
+        eOmc_motor_config_t &motor_cfg = motorconfigs[logico];
+        memset(&motor_cfg, 0, sizeof(eOmc_motor_config_t));
         motor_cfg.maxvelocityofmotor = 0;//_maxMotorVelocity[logico]; //unused yet!
         motor_cfg.currentLimits.nominalCurrent = _currentLimits[logico].nominalCurrent;
         motor_cfg.currentLimits.overloadCurrent = _currentLimits[logico].overloadCurrent;
@@ -1411,17 +1410,20 @@ bool embObjMotionControl::init()
         tmp = _measureConverter->convert_pid_to_machine(yarp::dev::VOCAB_PIDTYPE_VELOCITY, _spd_pids[logico].pid, fisico);
         copyPid_iCub2eo(&tmp, &motor_cfg.pidspeed);
 
-        if (false == res->setcheckRemoteValue(protid, &motor_cfg, 10, 0.010, 0.050))
-        {
-            yError() << "FATAL: embObjMotionControl::init() had an error while calling setcheckRemoteValue() for motor config fisico #" << fisico << "in "<< getBoardInfo();
-            return false;
-        }
-        else
+        cfgid32s.push_back(protid);
+        cfgvalues.push_back(&motor_cfg);
+    }
+
+    if(false == res->setcheckRemoteValues(cfgid32s, cfgvalues, 10, 0.010, 0.050))
+    {
+        yError() << "FATAL: embObjMotionControl::init() had an error while calling setcheckRemoteValues() for joint and motor configs in "<< getBoardInfo();
+        return false;
+    }
+    else
+    {
+        if(behFlags.verbosewhenok)
         {
-            if (behFlags.verbosewhenok)
-            {
-                yDebug() << "embObjMotionControl::init() correctly configured motor config fisico #" << fisico << "in "<< getBoardInfo();
-            }
+            yDebug() << "embObjMotionControl::init() correctly configured" << _njoints << "joint configs and" << _njoints << "motor configs in "<< getBoardInfo();
         }
     }
 
@@ -1511,7 +1513,7 @@ eth::iethresType_t embObjMotionControl::type()
 bool embObjMotionControl::update(eOprotID32_t id32, double timestamp, void *rxdata)
 {
     // use this function to update the values cached in the class using data received by the remote boards via the network callbacks
-    // in embObjMotionControl it is updated only the timestamp of the encoders, thuus i dont used rxdata
+    // in embObjMotionControl it is updated the timestamp of the encoders and, for the joint status core, the snapshot of the measures
     size_t joint = eoprot_ID2index(id32);
 
     // rxdata = rxdata;
@@ -1526,8 +1528,24 @@ bool embObjMotionControl::update(eOprotID32_t id32, double timestamp, void *rxda
 
     if(true == initialised())
     {   // do it only if we already have opened the device
-        std::lock_guard<std::mutex> lck(_mutex);
-        _encodersStamp[joint] = timestamp;
+        {
+            std::lock_guard<std::mutex> lck(_mutex);
+            _encodersStamp[joint] = timestamp;
+        }
+
+        // the regular joint status core also goes into the snapshot read by the bulk getters.
+        // we are its only writer because the packets of a board are parsed one at a time.
+        if((eoprot_tag_mc_joint_status_core == eoprot_ID2tag(id32)) && (NULL != rxdata))
+        {
+            const eOmc_joint_status_core_t *core = reinterpret_cast<const eOmc_joint_status_core_t*>(rxdata);
+            eomc::JointStatusSnapshot::Measures m;
+            m.position = (double) core->measures.meas_position;
+            m.velocity = (double) core->measures.meas_velocity;
+            m.acceleration = (double) core->measures.meas_acceleration;
+            m.torque = (double) core->measures.meas_torque;
+            m.stamp = timestamp;
+            _statusSnapshot.publish(joint, m);
+        }
     }
 
 
@@ -2759,6 +2777,11 @@ bool embObjMotionControl::getEncoderRaw(int j, double *value)
 
 bool embObjMotionControl::getEncodersRaw(double *encs)
 {
+    if(_statusSnapshot.read(encs, NULL, NULL, NULL, NULL))
+    {
+        return true;
+    }
+
     bool ret = true;
     for(int j=0; j< _njoints; j++)
     {
@@ -2784,6 +2807,11 @@ bool embObjMotionControl::getEncoderSpeedRaw(int j, double *sp)
 
 bool embObjMotionControl::getEncoderSpeedsRaw(double *spds)
 {
+    if(_statusSnapshot.read(NULL, spds, NULL, NULL, NULL))
+    {
+        return true;
+    }
+
     bool ret = true;
     for(int j=0; j< _njoints; j++)
     {
@@ -2807,6 +2835,11 @@ bool embObjMotionControl::getEncoderAccelerationRaw(int j, double *acc)
 
 bool embObjMotionControl::getEncoderAccelerationsRaw(double *accs)
 {
+    if(_statusSnapshot.read(NULL, NULL, accs, NULL, NULL))
+    {
+        return true;
+    }
+
     bool ret = true;
     for(int j=0; j< _njoints; j++)
     {
@@ -2819,6 +2852,12 @@ bool embObjMotionControl::getEncoderAccelerationsRaw(double *accs)
 
 bool embObjMotionControl::getEncodersTimedRaw(double *encs, double *stamps)
 {
+    // positions and stamps from the same copy, so that each stamp refers to its position
+    if(_statusSnapshot.read(encs, NULL, NULL, NULL, stamps))
+    {
+        return true;
+    }
+
     bool ret = getEncodersRaw(encs);
     std::lock_guard<std::mutex> lck(_mutex);
     for(int i=0; i<_njoints; i++)
@@ -3809,6 +3848,13 @@ bool embObjMotionControl::getTorqueRaw(int j, double *t)
 
 bool embObjMotionControl::getTorquesRaw(double *t)
 {
+    if(_statusSnapshot.read(NULL, NULL, NULL, t, NULL))
+    {
+        for(int j=0; j<_njoints; j++)
+            t[j] = (double) _measureConverter->trqS2N(t[j], j);
+        return true;
+    }
+
     bool ret = true;
     for(int j=0; j<_njoints; j++)
         ret = ret && getTorqueRaw(j, &t[j]);
@@ -53,6 +53,7 @@ using namespace std;
 #include "serviceParser.h"
 #include "eomcParser.h"
 #include "measuresConverter.h"
+#include "jointStatusSnapshot.h"
 
 #include "mcEventDownsampler.h"
 
@@ -261,6 +262,7 @@ private:
     double  *_ref_positions;    // used for direct position control.
     double  *_ref_accs;         // for velocity control, in position min jerk eq is used.
     double  *_encodersStamp;                    /** keep information about acquisition time for encoders read */
+    eomc::JointStatusSnapshot _statusSnapshot;  /** measures of all joints as last received, read by the bulk getters without locks */
     bool  *checking_motiondone;                 /* flag telling if I'm already waiting for motion done */
     #define MAX_POSITION_MOVE_INTERVAL 0.080
     double *_last_position_move_time;           /** time stamp for last received position move command*/    
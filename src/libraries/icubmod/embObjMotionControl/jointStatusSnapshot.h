@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+// - include guard ----------------------------------------------------------------------------------------------------
+
+#ifndef _JOINTSTATUSSNAPSHOT_H_
+#define _JOINTSTATUSSNAPSHOT_H_
+
+// -- class JointStatusSnapshot
+// -- it keeps a copy of the measures of all the joints of a board, as received in their eOmc_joint_status_core_t.
+// -- the rx path of the board is its only writer and calls publish() for every received joint status. the bulk
+// -- getters of embObjMotionControl call read() and get the values of all joints in one consistent copy without
+// -- taking any lock. it is a seqlock: the writer makes the sequence odd while it copies and the readers retry
+// -- if the sequence was odd or has changed during their copy, so a reader never delays the rx path.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace yarp {
+    namespace dev  {
+        namespace eomc {
+
+    class JointStatusSnapshot
+    {
+    public:
+
+        struct Measures
+        {
+            double position;
+            double velocity;
+            double acceleration;
+            double torque;          // raw, as in meas_torque
+            double stamp;
+        };
+
+        JointStatusSnapshot() : sequence(0), missing(0), complete(false) {}
+
+        // to be called before the rx path starts to publish
+        void resize(int numofjoints)
+        {
+            std::vector<Slot> tmp(numofjoints);
+            slots.swap(tmp);
+            published.assign(numofjoints, false);
+            missing = numofjoints;
+            sequence.store(0, std::memory_order_relaxed);
+            complete.store(false, std::memory_order_release);
+        }
+
+        int size() const
+        {
+            return static_cast<int>(slots.size());
+        }
+
+        // writer side, called only by the rx path of the board
+        void publish(int j, const Measures &m)
+        {
+            if((j < 0) || (j >= static_cast<int>(slots.size())))
+            {
+                return;
+            }
+
+            uint32_t s = sequence.load(std::memory_order_relaxed);
+            sequence.store(s+1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            Slot &slot = slots[j];
+            slot.position.store(m.position, std::memory_order_relaxed);
+            slot.velocity.store(m.velocity, std::memory_order_relaxed);
+            slot.acceleration.store(m.acceleration, std::memory_order_relaxed);
+            slot.torque.store(m.torque, std::memory_order_relaxed);
+            slot.stamp.store(m.stamp, std::memory_order_relaxed);
+
+            sequence.store(s+2, std::memory_order_release);
+
+            if(false == published[j])
+            {
+                published[j] = true;
+                if(0 == --missing)
+                {
+                    complete.store(true, std::memory_order_release);
+                }
+            }
+        }
+
+        // reader side, safe to call from any thread. every non NULL array receives size() values.
+        // it returns false, and copies nothing, until every joint has been published at least once.
+        bool read(double *positions, double *velocities, double *accelerations, double *torques, double *stamps) const
+        {
+            if(false == complete.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            const int n = static_cast<int>(slots.size());
+            uint32_t s1 = 0;
+            uint32_t s2 = 0;
+            do
+            {
+                s1 = sequence.load(std::memory_order_acquire);
+                if(s1 & 1)
+                {
+                    continue;
+                }
+
+                for(int j=0; j<n; j++)
+                {
+                    const Slot &slot = slots[j];
+                    if(NULL != positions)       { positions[j] = slot.position.load(std::memory_order_relaxed); }
+                    if(NULL != velocities)      { velocities[j] = slot.velocity.load(std::memory_order_relaxed); }
+                    if(NULL != accelerations)   { accelerations[j] = slot.acceleration.load(std::memory_order_relaxed); }
+                    if(NULL != torques)         { torques[j] = slot.torque.load(std::memory_order_relaxed); }
+                    if(NULL != stamps)          { stamps[j] = slot.stamp.load(std::memory_order_relaxed); }
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                s2 = sequence.load(std::memory_order_relaxed);
+            } while((s1 & 1) || (s1 != s2));
+
+            return true;
+        }
+
+    private:
+
+        struct Slot
+        {
+            std::atomic<double> position {0};
+            std::atomic<double> velocity {0};
+            std::atomic<double> acceleration {0};
+            std::atomic<double> torque {0};
+            std::atomic<double> stamp {0};
+        };
+
+        std::vector<Slot> slots;
+        std::atomic<uint32_t> sequence;
+
+        // used only by the writer, to know when every joint has been published once
+        std::vector<bool> published;
+        int missing;
+        std::atomic<bool> complete;
+    };
+
+        } // namespace eomc
+    } // namespace dev
+} // namespace yarp
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
+
+
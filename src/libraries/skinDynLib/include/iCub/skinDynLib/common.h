@@ -249,6 +249,49 @@ yarp::sig::Matrix matrixFromBottle(const yarp::os::Bottle b, int in, const int r
 **/
 void      matrixIntoBottle(const yarp::sig::Matrix m, yarp::os::Bottle &b);
 
+/**
+* Tags opening the packed binary representation of dynContactList and
+* skinContactList (see dynContactList::setPackedFormat()).
+**/
+static const int PACKED_DYN_CONTACT_LIST_TAG  = 0x6C636470;  // "pdcl"
+static const int PACKED_SKIN_CONTACT_LIST_TAG = 0x6C637370;  // "pscl"
+
+/**
+* Appends an unsigned integer to a buffer as 2 or 4 little-endian bytes.
+* @param buf the buffer to be filled
+* @param v   the value to append
+**/
+void packUInt16(std::vector<unsigned char> &buf, const unsigned int v);
+void packUInt32(std::vector<unsigned char> &buf, const unsigned int v);
+
+/**
+* Appends a real value to a buffer as a little-endian IEEE-754 float32.
+* @param buf the buffer to be filled
+* @param v   the value to append
+**/
+void packFloat32(std::vector<unsigned char> &buf, const double v);
+
+/**
+* Appends an unsigned integer to a buffer as a varint, i.e. 7 bits per byte
+* starting from the least significant ones, the MSB flagging a following byte.
+* @param buf the buffer to be filled
+* @param v   the value to append
+**/
+void packVarUInt(std::vector<unsigned char> &buf, unsigned long long v);
+
+/**
+* Counterparts of the pack functions: each one reads a value starting
+* from p and moves p past it.
+* @param p   pointer to the first byte to read
+* @param end pointer past the last available byte
+* @param v   the value read
+* @return    false if the buffer ends before the value is complete
+**/
+bool unpackUInt16(const unsigned char *&p, const unsigned char *end, unsigned int &v);
+bool unpackUInt32(const unsigned char *&p, const unsigned char *end, unsigned int &v);
+bool unpackFloat32(const unsigned char *&p, const unsigned char *end, double &v);
+bool unpackVarUInt(const unsigned char *&p, const unsigned char *end, unsigned long long &v);
+
 /**
 * @ingroup skinDynLib 
 * Returns a list of indexes corresponding to the values of vec that are equal to val.
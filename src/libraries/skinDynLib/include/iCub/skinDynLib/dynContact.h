@@ -308,6 +308,22 @@ public:
     */
     virtual bool write(yarp::os::ConnectionWriter& connection) const override;
 
+    /**
+    * Append this contact to a buffer using the packed binary format used by
+    * dynContactList, that is (little-endian):
+    * - uint32 contactId, uint16 bodyPart, uint16 linkNumber
+    * - 9 float32, i.e. CoP, force and moment
+    * @param buf the buffer the contact is appended to
+    */
+    virtual void packInto(std::vector<unsigned char> &buf) const;
+    /**
+    * Read this contact from a buffer filled by packInto().
+    * @param p pointer to the first byte to read, moved past the contact
+    * @param end pointer past the last available byte
+    * @return true iff a dynContact was read correctly
+    */
+    virtual bool unpackFrom(const unsigned char *&p, const unsigned char *end);
+
     
     /**
      * Convert this contact into a string. Useful to print some information.
@@ -42,7 +42,12 @@ namespace skinDynLib
 class dynContactList : public std::vector<dynContact>, public yarp::os::Portable
 {
 protected:
-    
+    // if true write() uses the packed binary format
+    bool packedFormat;
+
+    bool readPacked(yarp::os::ConnectionReader& connection);
+    bool writePacked(yarp::os::ConnectionWriter& connection) const;
+
 public:
     //~~~~~~~~~~~~~~~~~~~~~~
     //   CONSTRUCTORS
@@ -54,6 +59,24 @@ public:
     //~~~~~~~~~~~~~~~~~~~~~~~~~
     //   SERIALIZATION methods
     //~~~~~~~~~~~~~~~~~~~~~~~~~
+    /**
+    * Select the format used by write(). The default format is a Bottle-compatible
+    * list of lists, whereas the packed format stores the list as:
+    * - int32 PACKED_DYN_CONTACT_LIST_TAG, int32 number of contacts, int32 number of bytes
+    * - a block with the contacts one after the other (see dynContact::packInto())
+    * Reals are sent as float32, so the packed format trades precision for
+    * payload size and (de)serialization speed. read() detects the format
+    * on its own, and the list is always written in the default format
+    * on text-mode connections.
+    * @param packed true to select the packed format
+    */
+    void setPackedFormat(bool packed) { packedFormat = packed; }
+
+    /**
+    * @return true iff write() uses the packed binary format
+    */
+    bool isPackedFormat() const { return packedFormat; }
+
     /*
     * Read dynContactList from a connection.
     * return true iff a dynContactList was read correctly
@@ -255,6 +255,26 @@ public:
     */
     virtual bool write(yarp::os::ConnectionWriter& connection) const override;
 
+    /**
+    * Append this skinContact to a buffer using the packed binary format used by
+    * skinContactList, that is the dynContact fields (see dynContact::packInto())
+    * followed by (little-endian):
+    * - uint16 skinPart
+    * - 7 float32, i.e. geometric center, normal direction and pressure
+    * - varint N followed by the N active taxel ids, each one stored as the
+    *   zigzag varint of its difference from the previous id
+    * @param buf the buffer the contact is appended to
+    */
+    virtual void packInto(std::vector<unsigned char> &buf) const override;
+
+    /**
+    * Read this skinContact from a buffer filled by packInto().
+    * @param p pointer to the first byte to read, moved past the contact
+    * @param end pointer past the last available byte
+    * @return true iff a skinContact was read correctly
+    */
+    virtual bool unpackFrom(const unsigned char *&p, const unsigned char *end) override;
+
     /**
     * Convert this skinContact to a vector. The size of the vector is 21 plus
     * the number of active taxels. The vector contains this data, in this order:
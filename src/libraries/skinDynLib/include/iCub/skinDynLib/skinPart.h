@@ -170,6 +170,20 @@ class skinPart : public skinPartBase
     std::map<int, std::list<unsigned int> > repr2TaxelList;
 
   protected:
+    // uniform grid over the taxel positions (link frame) in compressed form:
+    // the indexes (within taxels) of the taxels of cell c lie within
+    // indexTaxels[indexCellStart[c]..indexCellStart[c+1]), whereas
+    // indexPos stores the 3 coordinates of each taxel
+    double                    indexCellSize;
+    double                    indexOrigin[3];
+    int                       indexDims[3];
+    std::vector<unsigned int> indexCellStart;
+    std::vector<unsigned int> indexTaxels;
+    std::vector<double>       indexPos;
+
+    void visitIndexCell(int x, int y, int z, const double *p,
+                        int &nearest, double &minDist2);
+
     /**
      * Populates the skinPart by reading from a file - old convention.
      * Spatial Sampling will be forced to "taxel"
@@ -228,6 +242,31 @@ class skinPart : public skinPartBase
      */
     bool initRepresentativeTaxels();
 
+    /**
+     * Builds the spatial index used by getNearestTaxel() and getTaxelsWithinRadius().
+     * It is built by setTaxelPosesFromFile(), but it has to be built again whenever
+     * the taxels or their positions are changed afterwards.
+     * @param _cellSize is the size of the cells of the index in meters; it is
+     *                  enlarged if the cells would outnumber the taxels too much
+     */
+    void buildTaxelIndex(double _cellSize=0.01);
+
+    /**
+     * Finds the taxel closest to a point.
+     * @param _point is the point, expressed in the link reference frame
+     * @param _maxDist if positive, taxels farther than this distance are ignored
+     * @return the index within taxels of the closest taxel, -1 if there is none
+     */
+    int getNearestTaxel(const yarp::sig::Vector &_point, double _maxDist=-1.0);
+
+    /**
+     * Finds the taxels lying within a sphere.
+     * @param _point is the center of the sphere, expressed in the link reference frame
+     * @param _radius is the radius of the sphere
+     * @return the indexes within taxels of the taxels in the sphere, sorted in ascending order
+     */
+    std::vector<int> getTaxelsWithinRadius(const yarp::sig::Vector &_point, double _radius);
+
     /**
      * gets the size of the taxel vector (it differs from skinPartBase::getSize())
      * @return the size of the taxel vector
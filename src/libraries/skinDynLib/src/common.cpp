@@ -8,6 +8,8 @@
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <cstring>
+#include <cstdint>
 #include "iCub/skinDynLib/common.h"
 
 using namespace std;
@@ -132,3 +134,82 @@ void iCub::skinDynLib::matrixIntoBottle(const yarp::sig::Matrix m, yarp::os::Bot
         b.addFloat64(v[i]);
     }
 }
+
+void iCub::skinDynLib::packUInt16(std::vector<unsigned char> &buf, const unsigned int v)
+{
+    buf.push_back((unsigned char)(v&0xff));
+    buf.push_back((unsigned char)((v>>8)&0xff));
+}
+
+void iCub::skinDynLib::packUInt32(std::vector<unsigned char> &buf, const unsigned int v)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        buf.push_back((unsigned char)((v>>(8*i))&0xff));
+    }
+}
+
+void iCub::skinDynLib::packFloat32(std::vector<unsigned char> &buf, const double v)
+{
+    float f=(float)v;
+    uint32_t u;
+    memcpy(&u,&f,sizeof(u));
+    packUInt32(buf,u);
+}
+
+void iCub::skinDynLib::packVarUInt(std::vector<unsigned char> &buf, unsigned long long v)
+{
+    while (v >= 0x80)
+    {
+        buf.push_back((unsigned char)(v|0x80));
+        v>>=7;
+    }
+    buf.push_back((unsigned char)v);
+}
+
+bool iCub::skinDynLib::unpackUInt16(const unsigned char *&p, const unsigned char *end, unsigned int &v)
+{
+    if (end-p < 2)
+        return false;
+
+    v=(unsigned int)p[0] | ((unsigned int)p[1]<<8);
+    p+=2;
+    return true;
+}
+
+bool iCub::skinDynLib::unpackUInt32(const unsigned char *&p, const unsigned char *end, unsigned int &v)
+{
+    if (end-p < 4)
+        return false;
+
+    v=(unsigned int)p[0] | ((unsigned int)p[1]<<8) |
+      ((unsigned int)p[2]<<16) | ((unsigned int)p[3]<<24);
+    p+=4;
+    return true;
+}
+
+bool iCub::skinDynLib::unpackFloat32(const unsigned char *&p, const unsigned char *end, double &v)
+{
+    unsigned int u;
+    if (!unpackUInt32(p,end,u))
+        return false;
+
+    uint32_t u32=u;
+    float f;
+    memcpy(&f,&u32,sizeof(f));
+    v=f;
+    return true;
+}
+
+bool iCub::skinDynLib::unpackVarUInt(const unsigned char *&p, const unsigned char *end, unsigned long long &v)
+{
+    v=0;
+    for (int shift = 0; (p < end) && (shift < 64); shift+=7)
+    {
+        unsigned char b=*p++;
+        v|=(unsigned long long)(b&0x7f)<<shift;
+        if (!(b&0x80))
+            return true;
+    }
+    return false;
+}
@@ -260,6 +260,29 @@ bool dynContact::read(ConnectionReader& connection){
     return !connection.isError();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void dynContact::packInto(vector<unsigned char> &buf) const{
+    packUInt32(buf, (unsigned int)contactId);
+    packUInt16(buf, bodyPart);
+    packUInt16(buf, linkNumber);
+    for(int i=0;i<3;i++) packFloat32(buf, CoP[i]);
+    for(int i=0;i<3;i++) packFloat32(buf, F[i]);
+    for(int i=0;i<3;i++) packFloat32(buf, Mu[i]);
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool dynContact::unpackFrom(const unsigned char *&p, const unsigned char *end){
+    unsigned int id, bp, link;
+    if(!unpackUInt32(p, end, id) || !unpackUInt16(p, end, bp) || !unpackUInt16(p, end, link))
+        return false;
+    contactId   = id;
+    bodyPart    = (BodyPart)bp;
+    linkNumber  = link;
+    for(int i=0;i<3;i++) if(!unpackFloat32(p, end, CoP[i])) return false;
+    for(int i=0;i<3;i++) if(!unpackFloat32(p, end, F[i])) return false;
+    setForce(F);
+    for(int i=0;i<3;i++) if(!unpackFloat32(p, end, Mu[i])) return false;
+    return true;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 string dynContact::toString(int precision) const{
     stringstream res;
     res<< "Contact id: "<< contactId<< ", Body part: "<< BodyPart_s[bodyPart]<< ", link: "<< linkNumber<< ", CoP: "<< 
@@ -21,10 +21,10 @@ using namespace iCub::skinDynLib;
 
 
 dynContactList::dynContactList()
-:vector<dynContact>(){}
+:vector<dynContact>(), packedFormat(false){}
 
 dynContactList::dynContactList(const size_type &n, const dynContact& value)
-:vector<dynContact>(n, value){}
+:vector<dynContact>(n, value), packedFormat(false){}
 
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -34,7 +34,10 @@ bool dynContactList::read(ConnectionReader& connection)
 {
     // A dynContactList is represented as a list of list
     // where each list is a skinContact
-    if(connection.expectInt32()!=BOTTLE_TAG_LIST)
+    int tag = connection.expectInt32();
+    if(tag==PACKED_DYN_CONTACT_LIST_TAG)
+        return readPacked(connection);
+    if(tag!=BOTTLE_TAG_LIST)
         return false;
 
     int listLength = connection.expectInt32();
@@ -54,6 +57,9 @@ bool dynContactList::write(ConnectionWriter& connection) const
 {
     // A dynContactList is represented as a list of list
     // where each list is a skinContact
+    if(packedFormat && !connection.isTextMode())
+        return writePacked(connection);
+
     connection.appendInt32(BOTTLE_TAG_LIST);
     connection.appendInt32(size());
 
@@ -64,6 +70,46 @@ bool dynContactList::write(ConnectionWriter& connection) const
     return !connection.isError();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool dynContactList::readPacked(ConnectionReader& connection)
+{
+    // the tag has already been consumed by read()
+    int listLength = connection.expectInt32();
+    int nBytes = connection.expectInt32();
+    if(listLength<0 || nBytes<0 || connection.isError())
+        return false;
+    if((size_t)nBytes>connection.getSize())
+        return false;
+
+    vector<unsigned char> buf(nBytes);
+    if(nBytes>0 && !connection.expectBlock((char*)buf.data(), nBytes))
+        return false;
+
+    if(listLength!=size())
+        resize(listLength);
+
+    const unsigned char *p = buf.data();
+    const unsigned char *bufEnd = p+nBytes;
+    for(iterator it=begin(); it!=end(); it++)
+        if(!it->unpackFrom(p, bufEnd))
+            return false;
+
+    return (p==bufEnd) && !connection.isError();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool dynContactList::writePacked(ConnectionWriter& connection) const
+{
+    vector<unsigned char> buf;
+    for(auto it=begin(); it!=end(); it++)
+        it->packInto(buf);
+
+    connection.appendInt32(PACKED_DYN_CONTACT_LIST_TAG);
+    connection.appendInt32(size());
+    connection.appendInt32(buf.size());
+    connection.appendBlock((const char*)buf.data(), buf.size());
+
+    return !connection.isError();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 string dynContactList::toString(const int &precision) const{
     stringstream ss;
     for(const_iterator it=begin();it!=end();it++)
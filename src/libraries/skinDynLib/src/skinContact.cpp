@@ -217,6 +217,54 @@ bool skinContact::read(ConnectionReader& connection){
     return !connection.isError();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+void skinContact::packInto(vector<unsigned char> &buf) const{
+    dynContact::packInto(buf);
+    packUInt16(buf, skinPart);
+    for(int i=0;i<3;i++) packFloat32(buf, geoCenter[i]);
+    for(int i=0;i<3;i++) packFloat32(buf, normalDir[i]);
+    packFloat32(buf, pressure);
+    // taxel ids are mostly sorted and close to each other,
+    // so their deltas take a single byte most of the time
+    packVarUInt(buf, activeTaxels);
+    long long prev = 0;
+    for(unsigned int i=0;i<activeTaxels;i++)
+    {
+        long long delta = (long long)taxelList[i] - prev;
+        packVarUInt(buf, ((unsigned long long)delta<<1) ^ (unsigned long long)(delta>>63));
+        prev = taxelList[i];
+    }
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool skinContact::unpackFrom(const unsigned char *&p, const unsigned char *end){
+    if(!dynContact::unpackFrom(p, end))
+        return false;
+    unsigned int sp;
+    if(!unpackUInt16(p, end, sp))
+        return false;
+    skinPart = (SkinPart)sp;
+    for(int i=0;i<3;i++) if(!unpackFloat32(p, end, geoCenter[i])) return false;
+    for(int i=0;i<3;i++) if(!unpackFloat32(p, end, normalDir[i])) return false;
+    if(!unpackFloat32(p, end, pressure))
+        return false;
+
+    // every taxel id takes at least one byte
+    unsigned long long n;
+    if(!unpackVarUInt(p, end, n) || n>(unsigned long long)(end-p))
+        return false;
+    activeTaxels = (unsigned int)n;
+    taxelList.resize(activeTaxels);
+    long long prev = 0;
+    for(unsigned int i=0;i<activeTaxels;i++)
+    {
+        unsigned long long zz;
+        if(!unpackVarUInt(p, end, zz))
+            return false;
+        prev += (long long)(zz>>1) ^ -(long long)(zz&1);
+        taxelList[i] = (unsigned int)prev;
+    }
+    return true;
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 Vector skinContact::toVector() const{
     Vector v(activeTaxels+21);
     unsigned int index = 0;
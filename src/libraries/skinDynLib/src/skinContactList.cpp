@@ -25,10 +25,10 @@ using namespace iCub::skinDynLib;
 //   CONSTRUCTORS
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 skinContactList::skinContactList()
-:vector<skinContact>(){}
+:vector<skinContact>(), packedFormat(false){}
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 skinContactList::skinContactList(const size_type &n, const skinContact& value)
-:vector<skinContact>(n, value){}
+:vector<skinContact>(n, value), packedFormat(false){}
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 skinContactList skinContactList::filterBodyPart(const BodyPart &bp)
 {
@@ -61,7 +61,10 @@ bool skinContactList::read(ConnectionReader& connection)
 {
     // A skinContactList is represented as a list of list
     // where each list is a skinContact
-    if(connection.expectInt32()!=BOTTLE_TAG_LIST)
+    int tag = connection.expectInt32();
+    if(tag==PACKED_SKIN_CONTACT_LIST_TAG)
+        return readPacked(connection);
+    if(tag!=BOTTLE_TAG_LIST)
         return false;
 
     int listLength = connection.expectInt32();
@@ -81,6 +84,9 @@ bool skinContactList::write(ConnectionWriter& connection) const
 {
     // A skinContactList is represented as a list of list
     // where each list is a skinContact
+    if(packedFormat && !connection.isTextMode())
+        return writePacked(connection);
+
     connection.appendInt32(BOTTLE_TAG_LIST);
     connection.appendInt32(size());
 
@@ -91,9 +97,50 @@ bool skinContactList::write(ConnectionWriter& connection) const
     return !connection.isError();
 }
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool skinContactList::readPacked(ConnectionReader& connection)
+{
+    // the tag has already been consumed by read()
+    int listLength = connection.expectInt32();
+    int nBytes = connection.expectInt32();
+    if(listLength<0 || nBytes<0 || connection.isError())
+        return false;
+    if((size_t)nBytes>connection.getSize())
+        return false;
+
+    vector<unsigned char> buf(nBytes);
+    if(nBytes>0 && !connection.expectBlock((char*)buf.data(), nBytes))
+        return false;
+
+    if(listLength!=size())
+        resize(listLength);
+
+    const unsigned char *p = buf.data();
+    const unsigned char *bufEnd = p+nBytes;
+    for(iterator it=begin(); it!=end(); it++)
+        if(!it->unpackFrom(p, bufEnd))
+            return false;
+
+    return (p==bufEnd) && !connection.isError();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+bool skinContactList::writePacked(ConnectionWriter& connection) const
+{
+    vector<unsigned char> buf;
+    for(auto it=begin(); it!=end(); it++)
+        it->packInto(buf);
+
+    connection.appendInt32(PACKED_SKIN_CONTACT_LIST_TAG);
+    connection.appendInt32(size());
+    connection.appendInt32(buf.size());
+    connection.appendBlock((const char*)buf.data(), buf.size());
+
+    return !connection.isError();
+}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 dynContactList skinContactList::toDynContactList() const
 {
     dynContactList res(this->size());
+    res.setPackedFormat(packedFormat);
     const_iterator itSkin = begin();
     for(dynContactList::iterator itDyn=res.begin(); itDyn!=res.end(); itDyn++)
     {
@@ -1,5 +1,9 @@
 #include "iCub/skinDynLib/skinPart.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace yarp::math;
 using namespace iCub::skinDynLib;
 
@@ -79,10 +83,12 @@ using namespace iCub::skinDynLib;
     skinPart::skinPart()
     {
         spatial_sampling = "taxel";        
+        buildTaxelIndex();
     }
 
     skinPart::skinPart(const std::string &_filePath)
     {
+        buildTaxelIndex();
         setTaxelPosesFromFile(_filePath);
     }
 
@@ -111,6 +117,7 @@ using namespace iCub::skinDynLib;
         {
             taxels.push_back(new Taxel(*(*it)));
         }
+        buildTaxelIndex(_sp.indexCellSize);
 
         return *this;
     }
@@ -206,6 +213,7 @@ using namespace iCub::skinDynLib;
                 taxels.push_back(new Taxel(taxelPos,taxelNrm,i-1));
             }
         }
+        buildTaxelIndex();
 
         // Let's read the mapping of the taxels onto the center of their triangle
         // even if the spatial_sampling variable is "taxel"
@@ -278,6 +286,7 @@ using namespace iCub::skinDynLib;
             else
                 setSize(getSize()+1);
         }
+        buildTaxelIndex();
 
         return mapTaxelsOntoThemselves() && initRepresentativeTaxels();
     }
@@ -327,6 +336,214 @@ using namespace iCub::skinDynLib;
         return true;
     }
 
+    // cell coordinate of a value along axis j, clamped so as to fit an int
+    // even for points lying very far from the grid
+    static int indexCell(double v, double origin, double cellSize)
+    {
+        double c=std::floor((v-origin)/cellSize);
+        return (int)std::max(-1e8,std::min(1e8,c));
+    }
+
+    void skinPart::buildTaxelIndex(double _cellSize)
+    {
+        std::lock_guard<std::recursive_mutex> rlg(recursive_mtx);
+        size_t n=taxels.size();
+        indexCellSize=(_cellSize>0.0 ? _cellSize : 0.01);
+        indexPos.resize(3*n);
+
+        double hi[3];
+        for (int j=0; j<3; j++)
+        {
+            indexOrigin[j]=0.0;
+            indexDims[j]=0;
+            hi[j]=0.0;
+        }
+
+        // taxels with non-finite positions cannot be found by any query,
+        // hence they are left out of the bounds and of the index
+        std::vector<bool> indexed(n,false);
+        size_t numIndexed=0;
+        for (size_t i=0; i<n; i++)
+        {
+            yarp::sig::Vector pos=taxels[i]->getPosition();
+            for (int j=0; j<3; j++)
+                indexPos[3*i+j]=pos[j];
+            if (!std::isfinite(pos[0]) || !std::isfinite(pos[1]) || !std::isfinite(pos[2]))
+                continue;
+
+            for (int j=0; j<3; j++)
+            {
+                if ((numIndexed==0) || (pos[j]<indexOrigin[j]))
+                    indexOrigin[j]=pos[j];
+                if ((numIndexed==0) || (pos[j]>hi[j]))
+                    hi[j]=pos[j];
+            }
+            indexed[i]=true;
+            numIndexed++;
+        }
+
+        indexTaxels.clear();
+        indexCellStart.assign(1,0);
+        if (numIndexed==0)
+            return;
+
+        // keep the number of cells comparable with the number of taxels;
+        // the doubling is bounded so that extents too wide to be
+        // represented end up in a single cell
+        double maxCells=std::max(64.0,8.0*numIndexed);
+        bool fits=false;
+        for (int k=0; (k<64) && !fits; k++)
+        {
+            double numCells=1.0;
+            for (int j=0; j<3; j++)
+                numCells*=std::floor((hi[j]-indexOrigin[j])/indexCellSize)+1.0;
+            if (numCells<=maxCells)
+                fits=true;
+            else
+                indexCellSize*=2.0;
+        }
+
+        for (int j=0; j<3; j++)
+            indexDims[j]=(fits ? std::min(indexCell(hi[j],indexOrigin[j],indexCellSize),(int)maxCells)+1 : 1);
+
+        // counting sort of the taxels by cell
+        std::vector<unsigned int> cellOf(n);
+        indexCellStart.assign((size_t)indexDims[0]*indexDims[1]*indexDims[2]+1,0);
+        for (size_t i=0; i<n; i++)
+        {
+            if (!indexed[i])
+                continue;
+
+            int c[3];
+            for (int j=0; j<3; j++)
+                c[j]=std::max(0,std::min(indexDims[j]-1,indexCell(indexPos[3*i+j],indexOrigin[j],indexCellSize)));
+            cellOf[i]=(c[0]*indexDims[1]+c[1])*indexDims[2]+c[2];
+            indexCellStart[cellOf[i]+1]++;
+        }
+
+        for (size_t c=1; c<indexCellStart.size(); c++)
+            indexCellStart[c]+=indexCellStart[c-1];
+
+        std::vector<unsigned int> fill(indexCellStart.begin(),indexCellStart.end()-1);
+        indexTaxels.resize(numIndexed);
+        for (size_t i=0; i<n; i++)
+            if (indexed[i])
+                indexTaxels[fill[cellOf[i]]++]=(unsigned int)i;
+    }
+
+    void skinPart::visitIndexCell(int x, int y, int z, const double *p,
+                                  int &nearest, double &minDist2)
+    {
+        unsigned int c=(x*indexDims[1]+y)*indexDims[2]+z;
+        for (unsigned int k=indexCellStart[c]; k<indexCellStart[c+1]; k++)
+        {
+            int i=indexTaxels[k];
+            const double *q=&indexPos[3*i];
+            double d2=(p[0]-q[0])*(p[0]-q[0])+(p[1]-q[1])*(p[1]-q[1])+(p[2]-q[2])*(p[2]-q[2]);
+            // ties are resolved in favor of the lowest index
+            if ((d2<minDist2) || ((d2==minDist2) && ((nearest<0) || (i<nearest))))
+            {
+                minDist2=d2;
+                nearest=i;
+            }
+        }
+    }
+
+    int skinPart::getNearestTaxel(const yarp::sig::Vector &_point, double _maxDist)
+    {
+        std::lock_guard<std::recursive_mutex> rlg(recursive_mtx);
+        if (indexTaxels.empty() || (_point.length()<3))
+            return -1;
+
+        const double *p=_point.data();
+        int c[3];
+        int firstRing=0, lastRing=0;
+        for (int j=0; j<3; j++)
+        {
+            c[j]=indexCell(p[j],indexOrigin[j],indexCellSize);
+            firstRing=std::max(firstRing,std::max(-c[j],c[j]-(indexDims[j]-1)));
+            lastRing=std::max(lastRing,std::max(c[j],(indexDims[j]-1)-c[j]));
+        }
+
+        // cells of ring r lie farther than (r-1)*indexCellSize
+        if (_maxDist>0.0)
+            lastRing=std::min(lastRing,(int)std::min(1e8,std::ceil(_maxDist/indexCellSize))+1);
+
+        int nearest=-1;
+        double minDist2=(_maxDist>0.0 ? _maxDist*_maxDist : std::numeric_limits<double>::max());
+
+        // visit the shells of cells around c in ascending order of distance
+        for (int r=firstRing; r<=lastRing; r++)
+        {
+            int x0=std::max(0,c[0]-r), x1=std::min(indexDims[0]-1,c[0]+r);
+            int y0=std::max(0,c[1]-r), y1=std::min(indexDims[1]-1,c[1]+r);
+            int z0=std::max(0,c[2]-r), z1=std::min(indexDims[2]-1,c[2]+r);
+            for (int x=x0; x<=x1; x++)
+            {
+                for (int y=y0; y<=y1; y++)
+                {
+                    if ((std::abs(x-c[0])==r) || (std::abs(y-c[1])==r))
+                    {
+                        for (int z=z0; z<=z1; z++)
+                            visitIndexCell(x,y,z,p,nearest,minDist2);
+                    }
+                    else
+                    {
+                        if (c[2]-r>=0)
+                            visitIndexCell(x,y,c[2]-r,p,nearest,minDist2);
+                        if ((r>0) && (c[2]+r<indexDims[2]))
+                            visitIndexCell(x,y,c[2]+r,p,nearest,minDist2);
+                    }
+                }
+            }
+
+            // the next shells lie at least r*indexCellSize away
+            if ((nearest>=0) && (minDist2<(r*indexCellSize)*(r*indexCellSize)))
+                break;
+        }
+
+        return nearest;
+    }
+
+    std::vector<int> skinPart::getTaxelsWithinRadius(const yarp::sig::Vector &_point, double _radius)
+    {
+        std::lock_guard<std::recursive_mutex> rlg(recursive_mtx);
+        std::vector<int> res;
+        if (indexTaxels.empty() || (_point.length()<3) || (_radius<0.0))
+            return res;
+
+        const double *p=_point.data();
+        int lo[3], hi[3];
+        for (int j=0; j<3; j++)
+        {
+            lo[j]=std::max(0,indexCell(p[j]-_radius,indexOrigin[j],indexCellSize));
+            hi[j]=std::min(indexDims[j]-1,indexCell(p[j]+_radius,indexOrigin[j],indexCellSize));
+            if (lo[j]>hi[j])
+                return res;
+        }
+
+        double r2=_radius*_radius;
+        for (int x=lo[0]; x<=hi[0]; x++)
+        {
+            for (int y=lo[1]; y<=hi[1]; y++)
+            {
+                unsigned int c0=(x*indexDims[1]+y)*indexDims[2]+lo[2];
+                unsigned int c1=c0+(hi[2]-lo[2])+1;
+                for (unsigned int k=indexCellStart[c0]; k<indexCellStart[c1]; k++)
+                {
+                    int i=indexTaxels[k];
+                    const double *q=&indexPos[3*i];
+                    double d2=(p[0]-q[0])*(p[0]-q[0])+(p[1]-q[1])*(p[1]-q[1])+(p[2]-q[2])*(p[2]-q[2]);
+                    if (d2<=r2)
+                        res.push_back(i);
+                }
+            }
+        }
+
+        std::sort(res.begin(),res.end());
+        return res;
+    }
+
     int skinPart::getTaxelsSize()
     {
          return taxels.size();
@@ -344,6 +561,7 @@ using namespace iCub::skinDynLib;
             taxels.pop_back();
         }
         taxels.clear();
+        buildTaxelIndex();
     }
 
     void skinPart::print(int verbosity)
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#ifndef __COMP_KERNEL_H__
+#define __COMP_KERNEL_H__
+
+namespace iCub{
+
+namespace skinManager{
+
+// Coefficients of the compensation of a single taxel, see compensateTaxels().
+struct CompensationCoeffs{
+    double rawOffset, rawSign;      // raw data are mapped to rawOffset+rawSign*raw
+    double addThr;                  // value added to the touch thresholds
+    double smoothNew, smoothOld;    // weights of the new and old values in the smooth filter
+    double touchGain, noTouchGain;  // drift compensation gains with and without touch
+    double binTouch, binNoTouch;    // output values of the binarization filter
+    bool binarize;
+};
+
+// Compensates all the taxels of a skin part in a single pass and returns the number of
+// negative baselines. The options are turned into coefficients and selections rather
+// than branches and the arrays are declared not to overlap, so that the compiler can
+// vectorize the loop.
+inline unsigned int compensateTaxels(const CompensationCoeffs &k, const unsigned int n,
+                                     const double * __restrict raw, const double * __restrict thr,
+                                     double * __restrict base, double * __restrict comp,
+                                     double * __restrict compOld, double * __restrict compFilt,
+                                     double * __restrict out, unsigned char * __restrict touch,
+                                     unsigned char * __restrict subTouch, unsigned char * __restrict touchFilt,
+                                     const double maxSkin){
+    const double rawOffset=k.rawOffset, rawSign=k.rawSign, addThr=k.addThr;
+    const double smoothNew=k.smoothNew, smoothOld=k.smoothOld;
+    const double touchGain=k.touchGain, noTouchGain=k.noTouchGain;
+    const double binTouch=k.binTouch, binNoTouch=k.binNoTouch;
+    const bool binarize=k.binarize;
+    unsigned int negativeBaselines = 0;
+
+    for(unsigned int i=0; i<n; i++){
+        // baseline compensation
+        double d = rawOffset + rawSign*raw[i] - base[i];
+        d = (d<maxSkin ? d : maxSkin);
+        comp[i] = d;     // save the data before applying filtering
+
+        // detect touch (before applying filtering, so the compensation algorithm is not affected by the filters)
+        double th = thr[i] + addThr;
+        unsigned char t = (d > th);
+        touch[i] = t;
+        
+        // detect subtouch
+        subTouch[i] = (d < -thr[i] - addThr);
+        
+        // smooth filter
+        d = smoothNew*d + smoothOld*compOld[i];
+        compOld[i] = d;    // update old value
+        compFilt[i] = d;
+
+        // binarization filter
+        // here we don't use the touch array because, if the smooth filter is on,
+        // we want to use the filtered values
+        unsigned char tf = (d > th);
+        touchFilt[i] = tf;
+        double bin = (tf ? binTouch : binNoTouch);
+        d = (binarize ? bin : d);
+        
+        out[i] = (0.0<d ? d : 0.0); // trim only data to send because you need negative values for update baseline
+
+        // drift compensation (same as Compensator::updateBaseline())
+        double b = base[i] + (t ? touchGain : noTouchGain)*comp[i]/thr[i];
+        base[i] = b;
+        negativeBaselines += (b<0);
+    }
+    return negativeBaselines;
+}
+
+} //namespace iCub
+
+} //namespace skinManager
+
+#endif
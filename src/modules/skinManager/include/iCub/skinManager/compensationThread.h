@@ -44,6 +44,10 @@ using namespace iCub::skinDynLib;
 
 namespace iCub{
 
+namespace ctrl{
+    class ThreadPool;
+}
+
 namespace skinManager{
 
 class CompensationThread : public PeriodicThread
@@ -54,7 +58,8 @@ public:
     /* class methods */
 
     CompensationThread(string name, ResourceFinder* rf, string robotName, double _compensationGain, double _contactCompensationGain,
-        int addThreshold, float minBaseline, bool zeroUpRawData, int period, bool binarization, bool smoothFilter, float smoothFactor);
+        int addThreshold, float minBaseline, bool zeroUpRawData, int period, bool binarization, bool smoothFilter, float smoothFactor,
+        unsigned int portThreads=1);
     bool threadInit();
     void threadRelease();
     void run(); 
@@ -131,6 +136,7 @@ private:
     float smoothFactor;             // intensity of the smooth filter action
     double maxNeighDist;            // max neighbor distance used for computing taxel neighbors
     unsigned int portNum;           // number of input ports (that is the same as the number of output ports)
+    unsigned int portThreads;       // number of threads processing the ports (1 means sequential processing)
 
     vector<Compensator*> compensators;
     vector<bool> compEnable;            // true if the related compensator is enabled, false otherwise
@@ -139,6 +145,10 @@ private:
 
     // SKIN EVENTS
     bool skinEventsOn;
+    bool packedEvents;                      // true if skin events are sent in the packed binary format
+    vector<skinContactList> portContacts;   // contacts detected on each port in the last cycle
+
+    iCub::ctrl::ThreadPool* pool;           // workers processing the ports concurrently (NULL in sequential mode)
 
     /* ports */
     BufferedPort<skinContactList> skinEventsPort;   // skin events output port
@@ -155,6 +165,7 @@ private:
     void sendDebugMsg(string msg);
     void sendErrorMsg(string msg);
     void sendSkinEvents();
+    void processPort(unsigned int i);
 
 };
 
@@ -41,6 +41,7 @@
 #include "iCub/skinDynLib/skinContactList.h"
 #include "iCub/skinDynLib/rpcSkinManager.h"
 #include "iCub/skinDynLib/common.h"
+#include "iCub/skinManager/taxelClustering.h"
 
 using namespace std;
 using namespace yarp::os; 
@@ -71,7 +72,10 @@ private:
     unsigned int linkNum;                       // number of the link
 
     // SKIN CONTACTS
-    vector< list<int> >     neighborsXtaxel;    // list of neighbors for each taxel    
+    vector<unsigned int>    neighStart;         // neighbors of taxel i lie within [neighStart[i],neighStart[i+1]) of neighList
+    vector<unsigned int>    neighList;          // neighbors of all the taxels, stored contiguously
+    bool                    allNeighbors;       // true if every taxel is neighbor with all the other taxels (default)
+    TaxelClustering         clusters;           // groups the active taxels into contacts
     vector<Vector>          taxelPos;           // taxel positions {xPos, yPos, zPos}
     vector<Vector>          taxelOri;           // taxel normals {xOri, yOri, zOri}
     Vector                  taxelPoseConfidence;// taxels pose estimation confidence
@@ -79,9 +83,10 @@ private:
     mutex                   poseSem;            // mutex to access taxel poses
 
     // COMPENSATION
-    vector<bool> touchDetected;                 // true if touch has been detected in the last read of the taxel
-    vector<bool> touchDetectedFilt;             // true if touch has been detected after applying the filtering
-    vector<bool> subTouchDetected;              // true if the taxel value has gone under the baseline (because of touch in neighbouring taxels)
+    // the flags are stored one per byte (rather than in a vector<bool>) so that the compensation loop can be vectorized
+    vector<unsigned char> touchDetected;        // true if touch has been detected in the last read of the taxel
+    vector<unsigned char> touchDetectedFilt;    // true if touch has been detected after applying the filtering
+    vector<unsigned char> subTouchDetected;     // true if the taxel value has gone under the baseline (because of touch in neighbouring taxels)
     Vector rawData;                             // data read from the skin
     Vector touchThresholds;                     // thresholds for discriminating between "touch" and "no touch"
     mutex touchThresholdSem;                    // semaphore for controlling the access to the touchThreshold
@@ -127,6 +132,7 @@ private:
     bool init(string name, string robotName, string outputPortName, string inputPortName);
     bool readInputData(Vector& skin_values);
     void sendInfoMsg(string msg);
+    void checkNegativeBaselines();
     void computeNeighbors();
     void updateNeighbors(unsigned int taxelId);
 
@@ -140,7 +146,7 @@ public:
     void calibrationInit();
     void calibrationDataCollection();
     void calibrationFinish();
-    bool readRawAndWriteCompensatedData();
+    bool readRawAndWriteCompensatedData(bool updateBaselines=false);
     void updateBaseline();
     bool doesBaselineExceed(unsigned int &taxelIndex, double &baseline, double &initialBaseline);
     skinContactList getContacts();
@@ -193,6 +199,10 @@ public:
     BodyPart getBodyPart(){     return bodyPart; }
     unsigned int getLinkNum(){  return linkNum; }
 
+    // the info port is shared by the compensators, which may run concurrently, and by
+    // the CompensationThread owning it: whoever writes on it must hold this mutex
+    static mutex infoPortSem;
+
 };
 
 template <class T>
@@ -103,6 +103,10 @@ The following key-value pairs can be specified as command-line parameters by pre
     \t- y(t) = (1-alpha)*x(t) + alpha*y(t-1)
  - \c smoothFactor \c [0.5] \n
    alpha value of the smoothing filter, in [0, 1] where 0 is no smoothing at all and 1 is the max smoothing possible.
+ - \c portThreads \c [1] \n
+   number of threads used to process the input ports: if greater than 1, the data of each port are read, compensated
+   and searched for contacts concurrently with the other ports (at most one thread per port is used), and the contacts
+   are then merged in a single skin event message.
 .
 An optional section called SKIN_EVENTS may be specified in the configuration file.
 These are the parameters of this section:
@@ -125,6 +129,10 @@ These are the parameters of this section:
     missing calibration procedure for that skin part).
  - \c maxNeighborDist \c 0.015 \n
     maximum distance between two neighbor tactile sensors (in meters).
+ - \c packedEvents \c 0 \n
+    if 1 the skin events are sent in the packed binary format of skinContactList (float32 values and
+    varint-encoded taxel ids, see skinContactList::setPackedFormat()), which is smaller and faster to
+    (de)serialize; readers detect the format on their own, but need a skinDynLib supporting it.
  
 
 \section portsa_sec Ports Accessed
@@ -249,6 +257,7 @@ namespace iCub {
             static const bool ZERO_UP_RAW_DATA_DEFAULT;
             static const bool BINARIZATION_DEFAULT;
             static const std::string RPC_PORT_DEFAULT;
+            static const int PORT_THREADS_DEFAULT;
 
             /* module parameters */
             std::string moduleName;
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#ifndef __TAXEL_CLUSTERING_H__
+#define __TAXEL_CLUSTERING_H__
+
+#include <vector>
+
+namespace iCub{
+
+namespace skinManager{
+
+// Computes the neighbor graph of n taxels in compressed rows: the neighbors of taxel i lie
+// within [start[i],start[i+1]) of list, in increasing id order. Two taxels are neighbors if
+// their distance is not greater than maxDist; pos holds the positions as x,y,z triplets.
+inline void computeNeighborGraph(const double *pos, const unsigned int n, const double maxDist,
+                                 std::vector<unsigned int> &start, std::vector<unsigned int> &list){
+    // collect the pairs of neighbors once, then lay them out per taxel
+    std::vector<unsigned int> pairs;
+    double d2 = maxDist*maxDist;
+    start.assign(n+1, 0);
+    for(unsigned int i=0; i<n; i++){
+        const double *pi = &pos[3*i];
+        for(unsigned int j=i+1; j<n; j++){
+            const double *pj = &pos[3*j];
+            double dx=pi[0]-pj[0], dy=pi[1]-pj[1], dz=pi[2]-pj[2];
+            if( dx*dx+dy*dy+dz*dz <= d2){
+                pairs.push_back(i);
+                pairs.push_back(j);
+                start[i+1]++;
+                start[j+1]++;
+            }
+        }
+    }
+    for(unsigned int i=0; i<n; i++)
+        start[i+1] += start[i];
+    list.resize(start[n]);
+    std::vector<unsigned int> fill(start.begin(), start.end()-1);
+    for(size_t k=0; k<pairs.size(); k+=2){
+        list[fill[pairs[k]]++] = pairs[k+1];
+        list[fill[pairs[k+1]]++] = pairs[k];
+    }
+}
+
+// Groups the active taxels of a skin part into contacts: two active taxels belong to the same
+// contact if they are linked by a path of active neighbors. The contacts are numbered by their
+// lowest taxel id and the taxels of each contact are listed in increasing id order (the former
+// breadth-first merge listed them in the order they joined the contact). The work buffers are
+// kept across the calls, so that the cost scales with the active taxels and their neighbors.
+class TaxelClustering{
+    std::vector<int>            taxelParent;    // union-find forest over the active taxels (-1 for inactive taxels)
+    std::vector<unsigned int>   activeTaxelIds; // ids of the active taxels, in increasing order
+    std::vector<unsigned int>   contactXtaxel;  // contact id of each active taxel
+
+    int findRoot(int taxelId){
+        // path halving: every visited taxel is linked to its grandparent
+        while(taxelParent[taxelId]!=taxelId){
+            taxelParent[taxelId] = taxelParent[taxelParent[taxelId]];
+            taxelId = taxelParent[taxelId];
+        }
+        return taxelId;
+    }
+
+public:
+    std::vector<unsigned int>   contactStart;   // taxels of contact c lie within [contactStart[c],contactStart[c+1]) of taxelsXcontact
+    std::vector<unsigned int>   taxelsXcontact; // taxels of all the contacts, stored contiguously
+
+    // Clusters the n taxels whose active flag is not zero and returns the number of contacts.
+    // If allNeighbors is true every taxel is neighbor with all the other taxels, otherwise the
+    // neighbors are given by the graph in compressed rows (see computeNeighborGraph()).
+    unsigned int cluster(const unsigned char *active, const unsigned int n, const bool allNeighbors,
+                         const std::vector<unsigned int> &neighStart, const std::vector<unsigned int> &neighList){
+        unsigned int contactNum = 0;
+        if(taxelParent.size()!=n){
+            taxelParent.assign(n, -1);
+            contactXtaxel.resize(n);
+        }
+
+        // collect the active taxels; each one starts as a contact on its own
+        activeTaxelIds.clear();
+        for(unsigned int i=0; i<n; i++){
+            if(active[i]){
+                taxelParent[i] = i;
+                activeTaxelIds.push_back(i);
+            }
+        }
+
+        // merge the contacts of active neighbors, keeping the lowest taxel id as root
+        for(size_t k=0; k<activeTaxelIds.size(); k++){
+            int i = activeTaxelIds[k];
+            if(allNeighbors){
+                taxelParent[i] = activeTaxelIds[0];
+                continue;
+            }
+            for(unsigned int m=neighStart[i]; m<neighStart[i+1]; m++){
+                int j = neighList[m];
+                if(taxelParent[j]<0)
+                    continue;
+                int ri = findRoot(i);
+                int rj = findRoot(j);
+                if(ri<rj)
+                    taxelParent[rj] = ri;
+                else if(rj<ri)
+                    taxelParent[ri] = rj;
+            }
+        }
+
+        // number the contacts by their lowest taxel id and group their taxels
+        contactStart.assign(1, 0);
+        for(size_t k=0; k<activeTaxelIds.size(); k++){
+            int i = activeTaxelIds[k];
+            int r = findRoot(i);
+            if(r==i){
+                contactXtaxel[i] = contactNum++;
+                contactStart.push_back(0);
+            }
+            else
+                contactXtaxel[i] = contactXtaxel[r];
+            contactStart[contactXtaxel[i]+1]++;
+        }
+        for(unsigned int c=0; c<contactNum; c++)
+            contactStart[c+1] += contactStart[c];
+        taxelsXcontact.resize(activeTaxelIds.size());
+        for(size_t k=0; k<activeTaxelIds.size(); k++){
+            int i = activeTaxelIds[k];
+            taxelsXcontact[contactStart[contactXtaxel[i]]++] = i;
+            taxelParent[i] = -1;
+        }
+        for(unsigned int c=contactNum; c>0; c--)
+            contactStart[c] = contactStart[c-1];
+        contactStart[0] = 0;
+
+        return contactNum;
+    }
+};
+
+} //namespace skinManager
+
+} //namespace iCub
+
+#endif
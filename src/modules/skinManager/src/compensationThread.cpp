@@ -16,11 +16,13 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
  * Public License for more details
  */
+#include <functional>
 #include <yarp/os/Time.h>
 #include <yarp/math/Math.h>
 #include "math.h"
 #include "memory.h"
 #include "iCub/skinManager/compensationThread.h"
+#include "iCub/ctrl/threadPool.h"
 
 #define FOR_ALL_PORTS(i) for(unsigned int i=0;i<portNum;i++)
 
@@ -31,14 +33,17 @@ using namespace yarp::math;
 using namespace iCub::skinManager;
 
 
+
 CompensationThread::CompensationThread(string name, ResourceFinder* rf, string robotName, double _compensationGain, double _contactCompensationGain, 
                                        int addThreshold, float minBaseline, bool zeroUpRawData, 
-                                       int period, bool binarization, bool smoothFilter, float smoothFactor)
+                                       int period, bool binarization, bool smoothFilter, float smoothFactor,
+                                       unsigned int portThreads)
                                        : 
                                        PeriodicThread((double)period/1000.0), moduleName(name), compensationGain(_compensationGain), 
                                        contactCompensationGain(_contactCompensationGain), 
                                        ADD_THRESHOLD(addThreshold), robotName(robotName), 
-                                       binarization(binarization), smoothFilter(smoothFilter), smoothFactor(smoothFactor)
+                                       binarization(binarization), smoothFilter(smoothFilter), smoothFactor(smoothFactor),
+                                       portThreads(portThreads), pool(NULL)
 {
    this->rf                             = rf;
    this->minBaseline                    = minBaseline;
@@ -135,6 +140,7 @@ bool CompensationThread::threadInit()
 
     // configure the SKIN_EVENT if the corresponding section exists
     skinEventsOn = false;
+    packedEvents = false;
     Bottle &skinEventsConf = rf->findGroup("SKIN_EVENTS");
     if(!skinEventsConf.isNull()){
         yDebug("SKIN_EVENTS section found");
@@ -144,6 +150,10 @@ bool CompensationThread::threadInit()
         else
             skinEventsOn = true;
 
+        packedEvents = skinEventsConf.check("packedEvents", Value(0)).asInt32()!=0;
+        if(packedEvents)
+            yInfo("Skin events sent in packed binary format");
+
         if(skinEventsConf.check("skinParts")){
             Bottle* skinPartList = skinEventsConf.find("skinParts").asList();
             if(skinPartList->size() != portNum){
@@ -190,6 +200,16 @@ bool CompensationThread::threadInit()
     else
         sendDebugMsg("Skin events DISABLED.");
 
+    // process the ports concurrently if requested (no more threads than ports are used)
+    portContacts.resize(portNum);
+    if(portThreads>1 && compensatorCounter>1){
+        unsigned int nThreads = min(portThreads, compensatorCounter);
+        pool = new iCub::ctrl::ThreadPool(nThreads);
+        stringstream msg;
+        msg<< "Processing the ports with "<< nThreads<< " threads.";
+        sendDebugMsg(msg.str());
+    }
+
     initializationFinished = true;
     return true;
 }
@@ -206,15 +226,15 @@ void CompensationThread::run(){
     stateSem.lock();
 
     if( state == compensation){
-        // It reads the raw data, computes the difference between the read values and the baseline 
-        // and outputs these values
-        FOR_ALL_PORTS(i){
-            if(compWorking[i]){
-                if(compensators[i]->readRawAndWriteCompensatedData()){
-                    //If the read succeeded, update the baseline
-                    compensators[i]->updateBaseline();
-                }
-            }
+        // the ports are independent of each other, so they may be processed concurrently;
+        // the contacts are then merged in port order by sendSkinEvents()
+        if(pool){
+            function<void(unsigned int)> job = [this](unsigned int i){ processPort(i); };
+            pool->run(portNum, job);
+        }
+        else{
+            FOR_ALL_PORTS(i)
+                processPort(i);
         }
 
         if(skinEventsOn){
@@ -248,17 +268,28 @@ void CompensationThread::run(){
     checkErrors();
 }
 
+void CompensationThread::processPort(unsigned int i){
+    portContacts[i].clear();
+    if(compWorking[i]){
+        // It reads the raw data, computes the difference between the read values and the baseline 
+        // and outputs these values; if the read succeeds, the baseline is updated in the same pass
+        compensators[i]->readRawAndWriteCompensatedData(true);
+
+        if(skinEventsOn && compEnable[i])
+            portContacts[i] = compensators[i]->getContacts();
+    }
+}
+
 void CompensationThread::sendSkinEvents(){
     skinContactList &skinEvents = skinEventsPort.prepare();
     skinEvents.clear();
+    skinEvents.setPackedFormat(packedEvents);
 
-    skinContactList temp;
     Stamp timestamp;
     FOR_ALL_PORTS(i){
         if(compWorking[i] && compEnable[i]){
-            temp = compensators[i]->getContacts();
             timestamp = compensators[i]->getTimestamp();
-            skinEvents.insert(skinEvents.end(), temp.begin(), temp.end());
+            skinEvents.insert(skinEvents.end(), portContacts[i].begin(), portContacts[i].end());
         }
     }
 #ifdef _DEBUG
@@ -317,6 +348,8 @@ bool CompensationThread::doesBaselineExceed(unsigned int &compInd, unsigned int
 
 void CompensationThread::threadRelease() 
 {
+    delete pool;
+    pool = NULL;
     FOR_ALL_PORTS(i){
         delete compensators[i];
     }
@@ -368,6 +401,7 @@ void CompensationThread::sendMonitorData(){
 void CompensationThread::sendDebugMsg(string msg){
     //printf("\n");
     yDebug("[CompensationThread] %s", msg.c_str());
+    lock_guard<mutex> lck(Compensator::infoPortSem);
     Bottle& b = infoPort.prepare();
     b.clear();
     b.addString(msg.c_str());
@@ -377,6 +411,7 @@ void CompensationThread::sendDebugMsg(string msg){
 void CompensationThread::sendErrorMsg(string msg){
     //printf("\n");
     yError("[CompensationThread] %s", msg.c_str());
+    lock_guard<mutex> lck(Compensator::infoPortSem);
     Bottle& b = infoPort.prepare();
     b.clear();
     b.addString(msg.c_str());
@@ -21,6 +21,7 @@
 #include "math.h"
 #include <algorithm>
 #include "iCub/skinManager/compensator.h"
+#include "iCub/skinManager/compensationKernel.h"
 
 
 using namespace std;
@@ -32,6 +33,7 @@ using namespace iCub::skinDynLib;
 
 const double Compensator::BIN_TOUCH     = 100.0;
 const double Compensator::BIN_NO_TOUCH  = 0.0;
+mutex Compensator::infoPortSem;
 
 Compensator::Compensator(string _name, string _robotName, string outputPortName, string inputPortName, BufferedPort<Bottle>* _infoPort, 
                          double _compensationGain, double _contactCompensationGain, int addThreshold, float _minBaseline, bool _zeroUpRawData, 
@@ -134,11 +136,9 @@ bool Compensator::init(string name, string robotName, string outputPortName, str
     taxelPoseConfidence.resize(skinDim,0.0);
     maxNeighDist = MAX_NEIGHBOR_DISTANCE;
     // by default every taxel is neighbor with all the other taxels
-    list<int> defaultNeighbors(skinDim);
-    int i=0;
-    for(list<int>::iterator it=defaultNeighbors.begin();it!=defaultNeighbors.end();it++, i++) 
-        *it = i;
-    neighborsXtaxel.resize(skinDim, defaultNeighbors);
+    allNeighbors = true;
+    neighStart.assign(skinDim+1, 0);
+    neighList.clear();
 
     // test read to check if the skin is broken (all taxel output is 0)
     if(robotName!="icubSim" && readInputData(compensatedData)){
@@ -334,49 +334,59 @@ bool Compensator::readInputData(Vector& skin_values){
     return true;*/
 }
 
-bool Compensator::readRawAndWriteCompensatedData(){    
+bool Compensator::readRawAndWriteCompensatedData(bool updateBaselines){    
     if(!readInputData(rawData))
         return false;
     
     Vector& compensatedData2Send = compensatedTactileDataPort.prepare();
     compensatedData2Send.resize(skinDim);   // local variable with data to send
     compensatedData.resize(skinDim);        // global variable with data to store
-    
-    double d;
-    for(unsigned int i=0; i<skinDim; i++){
-        // baseline compensation
-        d =  (double)( zeroUpRawData ? rawData(i)-baselines[i] : MAX_SKIN-rawData(i)-baselines[i] );
-        d =   min<double>( MAX_SKIN, d);
-        compensatedData[i] = d;     // save the data before applying filtering
 
-        // detect touch (before applying filtering, so the compensation algorithm is not affected by the filters)
-        touchDetected[i] = (d > touchThresholds[i] + addThreshold);
-        
-        // detect subtouch
-        subTouchDetected[i] = (d < -touchThresholds[i] - addThreshold);
-        
-        // smooth filter
-        if(smoothFilter){
-            lock_guard<mutex> lck(smoothFactorSem);
-            d = (1-smoothFactor)*d + smoothFactor*compensatedDataOld(i);
-            compensatedDataOld(i) = d;    // update old value
-        }
-        compensatedDataFilt[i] = d;
-
-        // binarization filter
-        // here we don't use the touchDetected array because, if the smooth filter is on,
-        // we want to use the filtered values
-        touchDetectedFilt[i] = (d > touchThresholds[i] + addThreshold);
-        if(binarization)
-            d = ( touchDetectedFilt[i] ? BIN_TOUCH : BIN_NO_TOUCH );
-        
-        compensatedData2Send[i] = max<double>(0.0, d); // trim only data to send because you need negative values for update baseline
-    }
+    // when the smooth filter is off the old value has weight 0 (the old values are reset
+    // anyway when the filter is switched on), when the baselines are not updated the gains are 0
+    float sf;
+    {
+        lock_guard<mutex> lck(smoothFactorSem);
+        sf = smoothFactor;
+    }
+    CompensationCoeffs k;
+    k.rawOffset     = (zeroUpRawData ? 0.0 : (double)MAX_SKIN);
+    k.rawSign       = (zeroUpRawData ? 1.0 : -1.0);
+    k.addThr        = addThreshold;
+    k.smoothNew     = (smoothFilter ? (double)(1-sf) : 1.0);
+    k.smoothOld     = (smoothFilter ? (double)sf : 0.0);
+    k.touchGain     = (updateBaselines ? contactCompensationGain*0.02 : 0.0);
+    k.noTouchGain   = (updateBaselines ? compensationGain*0.02 : 0.0);
+    k.binTouch      = BIN_TOUCH;
+    k.binNoTouch    = BIN_NO_TOUCH;
+    k.binarize      = binarization;
+
+    unsigned int negativeBaselines = compensateTaxels(k, skinDim, rawData.data(), touchThresholds.data(),
+        baselines.data(), compensatedData.data(), compensatedDataOld.data(), compensatedDataFilt.data(),
+        compensatedData2Send.data(), touchDetected.data(), subTouchDetected.data(), touchDetectedFilt.data(),
+        MAX_SKIN);
 
     compensatedTactileDataPort.write();
+
+    if(negativeBaselines>0)
+        checkNegativeBaselines();
     return true;
 }
 
+void Compensator::checkNegativeBaselines(){
+    double gain, d;
+    for(unsigned int j=0; j<skinDim; j++){
+        if(baselines[j]<0){
+            d = compensatedData(j);
+            gain = (touchDetected[j] ? contactCompensationGain : compensationGain)*0.02;
+            char temp[300];
+            sprintf(temp, "ERROR-Negative baseline. Port %s; tax %d; baseline %.2f; gain: %.4f; d: %.2f; raw: %.2f; change: %f; touchThr: %.2f", 
+                SkinPart_s[skinPart].c_str(), j, baselines[j], gain, d, rawData[j], gain*d/touchThresholds[j], touchThresholds[j]);
+            sendInfoMsg(temp);
+        }
+    }
+}
+
 void Compensator::updateBaseline(){
     double mean_change = 0, change, gain;
     unsigned int non_touching_taxels = 0;
@@ -462,48 +472,11 @@ bool Compensator::doesBaselineExceed(unsigned int &taxelIndex, double &baseline,
 }
 
 skinContactList Compensator::getContacts(){    
-    vector<int>         contactXtaxel(skinDim, -1);     // contact for each taxel (-1 means no contact)
-    deque<deque<int> >  taxelsXcontact;                 // taxels for each contact
-    int                 contactId = 0;                  // id of the next contact to create
-    int                 neighCont;                      // id of the contact of the current neighbor
+    unsigned int contactNum = 0;                        // number of contacts found
 
     poseSem.lock();
     {
-        for(unsigned int i=0; i<skinDim; i++){
-            if(touchDetectedFilt[i] ){ // && contactXtaxel[i]<0 (second condition should always be true)
-                list<int> *neighbors = &(neighborsXtaxel[i]);
-                //printf("Taxel %d active. Going to check its %d neighbors\n", i, neighbors->size());
-                for(list<int>::iterator it=neighbors->begin(); it!=neighbors->end(); it++){
-                    neighCont = contactXtaxel[(*it)];
-                    if(neighCont >= 0){                                     // ** if neighbor belongs to a contact
-                        if(contactXtaxel[i]<0){                             // ** add taxel to pre-existing contact
-                            contactXtaxel[i] = neighCont;
-                            taxelsXcontact[neighCont].push_back(i);
-                            //printf("Add taxel to pre existing contact %d (neighbor %d)\n", neighCont, (*neighbors)[n]);
-                        }else if(contactXtaxel[i]!=neighCont){              // ** merge 2 contacts
-                            //mergeContacts(contactXtaxel[i], neighCont);
-                            int newId = min(contactXtaxel[i], neighCont);
-                            int oldId = max(contactXtaxel[i], neighCont);
-                            deque<int> tax2move = taxelsXcontact[oldId];
-                            for(deque<int>::iterator it=tax2move.begin(); it!=tax2move.end(); it++){
-                                contactXtaxel[(*it)] = newId;               // assign new contact id
-                                taxelsXcontact[newId].push_back((*it));     // add taxel ids to contact
-                            }
-                            taxelsXcontact[oldId].clear();      // clear the list of taxels belonging to the merged contact
-                            //printf("Merge two contacts: %d and %d\n", oldId, newId);
-                        }
-                    }
-
-                }
-                if(contactXtaxel[i]<0){            // ** if no neighbor belongs to a contact -> create new contact
-                    contactXtaxel[i] = contactId;
-                    taxelsXcontact.resize(contactId+1);
-                    taxelsXcontact[contactId].push_back(i);
-                    contactId++;
-                    //printf("New contact created: %d\n", contactId-1);
-                }
-            }
-        }
+        contactNum = clusters.cluster(touchDetectedFilt.data(), skinDim, allNeighbors, neighStart, neighList);
     }
     poseSem.unlock();
 
@@ -512,9 +485,8 @@ skinContactList Compensator::getContacts(){
     double pressure, pressureCoP, pressureNormal, out;
     int activeTaxels, activeTaxelsGeo;
     vector<unsigned int> taxelList;
-    for( deque<deque<int> >::iterator it=taxelsXcontact.begin(); it!=taxelsXcontact.end(); it++){
-        activeTaxels = it->size();
-        if(activeTaxels==0) continue;
+    for(unsigned int cId=0; cId<contactNum; cId++){
+        activeTaxels = clusters.contactStart[cId+1]-clusters.contactStart[cId];
         
         taxelList.resize(activeTaxels);
         CoP.zero();
@@ -523,7 +495,7 @@ skinContactList Compensator::getContacts(){
         pressure = pressureCoP = pressureNormal = 0.0;
         activeTaxelsGeo = 0;
         int i=0;
-        for( deque<int>::iterator tax=it->begin(); tax!=it->end(); tax++, i++){
+        for(const unsigned int *tax=&clusters.taxelsXcontact[clusters.contactStart[cId]]; i<activeTaxels; tax++, i++){
             out         = max(compensatedDataFilt[(*tax)], 0.0);
             if(norm(taxelPos[(*tax)])!=0.0){  // if the taxel position estimate exists
                 CoP         += taxelPos[(*tax)] * out;
@@ -539,7 +511,7 @@ skinContactList Compensator::getContacts(){
             taxelList[i] = *tax;
         }
         // if this is not the only contact and no taxel in this contact has a position => discard it
-        if(taxelsXcontact.size()>1 && activeTaxelsGeo==0)
+        if(contactNum>1 && activeTaxelsGeo==0)
             continue;
         if(pressureCoP!=0.0)        CoP         /= pressureCoP;
         if(pressureNormal!=0.0)     normal      /= pressureNormal;
@@ -842,27 +814,17 @@ bool Compensator::setTaxelOrientation(unsigned int taxelId, const Vector &orient
     return true;
 }
 void Compensator::computeNeighbors(){
-    neighborsXtaxel.clear();
-    neighborsXtaxel.resize(skinDim, list<int>(0));
-    Vector v;
-    double d2 = maxNeighDist*maxNeighDist;
-    for(unsigned int i=0; i<skinDim; i++){
-        for(unsigned int j=i+1; j<skinDim; j++){
-            //if(taxelPos[i][0]!=0.0 || taxelPos[i][1]!=0.0 || taxelPos[i][2]!=0.0){  // if the taxel exists
-            v = taxelPos[i]-taxelPos[j];
-            if( dot(v,v) <= d2){
-                neighborsXtaxel[i].push_back(j);
-                neighborsXtaxel[j].push_back(i);
-                //printf("Taxels %d (%s) and %d (%s) are neighbors\n", i, taxelPos[i].toString().c_str(), j, taxelPos[j].toString().c_str());
-            }
-            //}
-        }
-    }
+    vector<double> pos(3*skinDim);
+    for(unsigned int i=0; i<skinDim; i++)
+        for(int k=0; k<3; k++)
+            pos[3*i+k] = taxelPos[i][k];
+    computeNeighborGraph(pos.data(), skinDim, maxNeighDist, neighStart, neighList);
+    allNeighbors = false;
 
     int minNeighbors=skinDim, maxNeighbors=0, ns;
     for(unsigned int i=0; i<skinDim; i++){
         //if(taxelPos[i][0]!=0.0 || taxelPos[i][1]!=0.0 || taxelPos[i][2]!=0.0){  // if the taxel exists
-        ns = neighborsXtaxel[i].size();
+        ns = neighStart[i+1]-neighStart[i];
         if(ns>maxNeighbors) maxNeighbors = ns;
         if(ns<minNeighbors) minNeighbors = ns;
     }
@@ -871,26 +833,54 @@ void Compensator::computeNeighbors(){
     sendInfoMsg(ss.str());
 }
 void Compensator::updateNeighbors(unsigned int taxelId){
+    if(allNeighbors){
+        // expand the default graph, so that only the neighbors of taxelId change
+        neighStart.resize(skinDim+1);
+        neighList.resize(skinDim*skinDim);
+        for(unsigned int i=0; i<skinDim; i++){
+            neighStart[i] = i*skinDim;
+            for(unsigned int j=0; j<skinDim; j++)
+                neighList[i*skinDim+j] = j;
+        }
+        neighStart[skinDim] = skinDim*skinDim;
+        allNeighbors = false;
+    }
+
     Vector v;
     double d2 = maxNeighDist*maxNeighDist;
-    // remove all the neighbors of the taxel with id=taxelId
-    neighborsXtaxel[taxelId].clear();
-
+    vector<bool> isNeighbor(skinDim);
     for(unsigned int i=0; i<skinDim; i++){
-        //if(taxelPos[i][0]!=0.0 || taxelPos[i][1]!=0.0 || taxelPos[i][2]!=0.0){  // if the taxel exists
-        // remove taxelId from the neighbor list (if there is)
-        neighborsXtaxel[i].remove(taxelId);
-        // check whether they are neighbors
         v = taxelPos[i]-taxelPos[taxelId];
-        if( dot(v,v) <= d2){
-            neighborsXtaxel[i].push_back(taxelId);
-            neighborsXtaxel[taxelId].push_back(i);
+        isNeighbor[i] = (dot(v,v) <= d2);
+    }
+
+    // rebuild the lists replacing taxelId with its new neighbors
+    vector<unsigned int> newStart(skinDim+1);
+    vector<unsigned int> newList;
+    newList.reserve(neighList.size()+2*skinDim);
+    for(unsigned int i=0; i<skinDim; i++){
+        newStart[i] = newList.size();
+        if(i==taxelId){
+            for(unsigned int j=0; j<skinDim; j++)
+                if(isNeighbor[j])
+                    newList.push_back(j);
+        }
+        else{
+            for(unsigned int n=neighStart[i]; n<neighStart[i+1]; n++)
+                if(neighList[n]!=taxelId)
+                    newList.push_back(neighList[n]);
+            if(isNeighbor[i])
+                newList.push_back(taxelId);
         }
     }
+    newStart[skinDim] = newList.size();
+    neighStart.swap(newStart);
+    neighList.swap(newList);
 }
 
 void Compensator::sendInfoMsg(string msg){
     yInfo("[%s]: %s", getInputPortName().c_str(), msg.c_str());
+    lock_guard<mutex> lck(infoPortSem);
     Bottle& b = infoPort->prepare();
     b.clear();
     b.addString(getInputPortName().c_str());
@@ -43,6 +43,7 @@ const string skinManager::ROBOT_NAME_DEFAULT = "icub";
 const bool skinManager::ZERO_UP_RAW_DATA_DEFAULT = false;
 const bool skinManager::BINARIZATION_DEFAULT = false;
 const string skinManager::RPC_PORT_DEFAULT = "/rpc";
+const int skinManager::PORT_THREADS_DEFAULT = 1;
 
 bool skinManager::configure(yarp::os::ResourceFinder &rf) {    
     /* Process all parameters from both command-line and .ini file */
@@ -74,6 +75,8 @@ bool skinManager::configure(yarp::os::ResourceFinder &rf) {
        "Determine the smoothing intensity (float in [0,1])").asFloat64();
     bool binarization = rf.check("binarization", Value(BINARIZATION_DEFAULT),
             "if true then the binarization is active (bool)").asBool();
+    int portThreads         = rf.check("portThreads", Value(PORT_THREADS_DEFAULT),
+       "Number of threads processing the skin ports concurrently, 1 for sequential processing (positive int)").asInt32();
 
     /*
     * attach a port of the same name as the module (prefixed with a /) to the module
@@ -93,7 +96,7 @@ bool skinManager::configure(yarp::os::ResourceFinder &rf) {
     // Compensator thread
     /* create the thread and pass pointers to the module parameters */
     myThread = new CompensationThread(moduleName, &rf, robotName, compGain, contCompGain, addThreshold, minBaseline, 
-        zeroUpRawData, period, binarization, smoothFilter, smoothFactor);
+        zeroUpRawData, period, binarization, smoothFilter, smoothFactor, (unsigned int)max(portThreads, 1));
     /* now start the thread to do the work */
     if(!myThread->start()) { // this calls threadInit() and it if returns true, it then calls run()
         yError() << "[SkinManager] Could not start the compensator thread.";
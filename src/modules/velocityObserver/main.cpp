@@ -99,6 +99,11 @@ algorithm and a simple moving average filter:
 
 --thrAcc \e D 
 - The same as above but for the second derivative's estimation.
+
+--incremental
+- If specified, the fits are computed from running sums of the
+  buffered data, which is cheaper when many signals are
+  observed (see AWPolyEstimator::setIncrementalMode()).
  
 \section portsa_sec Ports Accessed
 The port the service is listening to.
@@ -221,11 +226,15 @@ private:
 
 public:
     dataCollector(unsigned int NVel, double DVel, BufferedPort<Vector> &_port_vel,
-                  unsigned int NAcc, double DAcc, BufferedPort<Vector> &_port_acc) :
+                  unsigned int NAcc, double DAcc, BufferedPort<Vector> &_port_acc,
+                  bool incremental) :
                   port_vel(_port_vel), port_acc(_port_acc)
     {
         linEst =new AWLinEstimator(NVel,DVel);
         quadEst=new AWQuadEstimator(NAcc,DAcc);
+
+        linEst->setIncrementalMode(incremental);
+        quadEst->setIncrementalMode(incremental);
     }
 
     ~dataCollector()
@@ -257,6 +266,8 @@ public:
         double DVel=rf.check("thrVel",Value(1.0)).asFloat64();
         double DAcc=rf.check("thrAcc",Value(1.0)).asFloat64();
 
+        bool incremental=rf.check("incremental");
+
         if (NVel<2)
         {
             yWarning()<<"lenVel cannot be lower than 2 => N=2 is assumed";
@@ -284,7 +295,7 @@ public:
         port_vel.open(portName+"/vel:o");
         port_acc.open(portName+"/acc:o");
 
-        port_pos=new dataCollector(NVel,DVel,port_vel,NAcc,DAcc,port_acc);
+        port_pos=new dataCollector(NVel,DVel,port_vel,NAcc,DAcc,port_acc,incremental);
         port_pos->useCallback();
         port_pos->open(portName+"/pos:i");
 
@@ -332,6 +343,7 @@ int main(int argc, char *argv[])
         cout<<"\t--thrVel    D: velocity max deviation threshold (default: 1.0)"     << endl;
         cout<<"\t--lenAcc    N: acceleration window's max length (default: 25)"      << endl;
         cout<<"\t--thrAcc    D: acceleration max deviation threshold (default: 1.0)" << endl;
+        cout<<"\t--incremental: fit through running sums of the data"               << endl;
         cout<<endl;
 
         return 0;
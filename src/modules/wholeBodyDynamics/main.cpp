@@ -69,6 +69,10 @@ http://wiki.icub.org/wiki/Force_Control
 --no_legs   
 - this option disables the dynamics computation for the legs joints
 
+--parallel_limbs
+- this option enables the concurrent computation of the independent limbs
+  (arms and legs) within the upper and lower torso nodes
+
 \section portsa_sec Ports Accessed
 The port the service is listening to.
 
@@ -215,6 +219,7 @@ private:
     bool     dummy_ft;
     bool     dump_vel_enabled;
     bool     auto_drift_comp;
+    bool     parallel_limbs;
     bool     default_ee_cont;       // true: when skin detects no contact, the ext contact is supposed at the end effector
                                     // false: ext contact is supposed at the last location where skin detected a contact
 
@@ -255,6 +260,7 @@ public:
         dummy_ft = false;
         dump_vel_enabled = false;
         auto_drift_comp = false;
+        parallel_limbs = false;
         default_ee_cont = false;
     }
 
@@ -338,6 +344,37 @@ public:
                 reply.addString("calib arms");
                 reply.addString("calib legs");
                 reply.addString("calib feet");
+                reply.addString("profile");
+                reply.addString("profile reset");
+                reply.addString("profile dump <file>");
+                return true;
+            }
+            else if (command.get(0).asString()=="profile")
+            {
+                if (!inv_dyn)
+                {
+                    reply.addString("Thread not running");
+                    return true;
+                }
+
+                stageProfiler &profiler = inv_dyn->getProfiler();
+                if (command.get(1).asString()=="reset")
+                {
+                    profiler.reset();
+                    reply.addString("Profile reset");
+                }
+                else if (command.get(1).asString()=="dump")
+                {
+                    string filename = command.get(2).isString() ? command.get(2).asString() : "wholeBodyDynamics_trace.json";
+                    if (profiler.dumpTrace(filename))
+                        reply.addString("Trace written to "+filename);
+                    else
+                        reply.addString("Unable to write "+filename);
+                }
+                else
+                {
+                    profiler.getStatistics(reply);
+                }
                 return true;
             }
             else if (command.get(0).asString()=="calib")
@@ -537,6 +574,12 @@ public:
             yInfo("Enabling automatic drift compensation (experimental)\n");
         }
 
+        if (rf.check("parallel_limbs"))
+        {
+            parallel_limbs = true;
+            yInfo("Solving independent limbs concurrently\n");
+        }
+
         if (rf.check("default_ee_cont"))
         {
             default_ee_cont = true;
@@ -666,6 +709,7 @@ public:
         inv_dyn = new inverseDynamics(rate, dd_left_arm, dd_right_arm, dd_head, dd_left_leg, dd_right_leg, dd_torso, robot_name, local_name, icub_type, autoconnect);
         inv_dyn->com_enabled=com_enabled;
         inv_dyn->auto_drift_comp=auto_drift_comp;
+        inv_dyn->parallel_limbs=parallel_limbs;
         inv_dyn->com_vel_enabled=com_vel_enabled;
         inv_dyn->dummy_ft=dummy_ft;
         inv_dyn->w0_dw0_enabled=w0_dw0_enabled;
@@ -260,6 +260,7 @@ inverseDynamics::inverseDynamics(int _rate, PolyDriver *_ddAL, PolyDriver *_ddAR
     w0_dw0_enabled   = false;
     dumpvel_enabled = false;
     auto_drift_comp = false;
+    parallel_limbs = false;
     add_legs_once = false;
 
     icub      = new iCubWholeBody(icub_type, DYNAMIC, VERBOSE);
@@ -476,6 +477,10 @@ inverseDynamics::inverseDynamics(int _rate, PolyDriver *_ddAL, PolyDriver *_ddAR
 
 bool inverseDynamics::threadInit()
 {
+    if (parallel_limbs)
+        icub->setParallelMode(true);
+    profiler.setBudget(getPeriod());
+
     yInfo("threadInit: waiting for port connections... \n\n");
     if (!dummy_ft)
     {
@@ -540,6 +545,7 @@ void iCubStatus::dump (FILE* f)
 
 void inverseDynamics::run()
 {
+    profiler.beginCycle();
     timestamp.update();
 
     thread_status = STATUS_OK;
@@ -558,6 +564,7 @@ void inverseDynamics::run()
     {
         delay_check = 0;
     }
+    profiler.mark(stageProfiler::STAGE_READ);
 
     //remove the offset from the FT sensors measurements
     F_LArm  = -1.0 * (current_status.ft_arm_left-Offset_LArm);
@@ -594,6 +601,7 @@ void inverseDynamics::run()
         current_status.inertial_w0.zero();
         current_status.inertial_dw0.zero();
     }
+    profiler.mark(stageProfiler::STAGE_OFFSET);
 
     Vector F_up(6, 0.0);
     icub->upperTorso->setInertialMeasure(current_status.inertial_w0,current_status.inertial_dw0,current_status.inertial_d2p0);
@@ -612,6 +620,7 @@ void inverseDynamics::run()
     meanTime += Time::now()-startTime;
     yDebug("Mean uppertorso NE time: %.4f\n", meanTime/getIterations());
 #endif
+    profiler.mark(stageProfiler::STAGE_UPPER_BODY);
 
 //#define DEBUG_KINEMATICS
 #ifdef DEBUG_KINEMATICS
@@ -624,6 +633,7 @@ void inverseDynamics::run()
     icub->attachLowerTorso(F_RLeg,F_LLeg);
     icub->lowerTorso->solveKinematics();
     icub->lowerTorso->solveWrench();
+    profiler.mark(stageProfiler::STAGE_LOWER_BODY);
 
 //#define DEBUG_KINEMATICS
 #ifdef DEBUG_KINEMATICS
@@ -693,6 +703,7 @@ void inverseDynamics::run()
     if (ddLL) writeTorque(LLTorques, 2, port_LLTorques); //leg
     writeTorque(RATorques, 3, port_RWTorques); //wrist
     writeTorque(LATorques, 3, port_LWTorques); //wrist
+    profiler.mark(stageProfiler::STAGE_TORQUES);
 
     Vector com_all(7), com_ll(7), com_rl(7), com_la(7),com_ra(7), com_hd(7), com_to(7), com_lb(7), com_ub(7);
     double mass_all  , mass_ll  , mass_rl  , mass_la  ,mass_ra  , mass_hd,   mass_to, mass_lb, mass_ub;
@@ -776,6 +787,7 @@ void inverseDynamics::run()
         mass_all=mass_ll=mass_rl=mass_la=mass_ra=mass_hd=mass_to=0.0;
         com_all.zero(); com_ll.zero(); com_rl.zero(); com_la.zero(); com_ra.zero(); com_hd.zero(); com_to.zero();
     }
+    profiler.mark(stageProfiler::STAGE_COM);
 
     // DYN/SKIN CONTACTS
     dynContacts = icub->upperTorso->leftSensor->getContactList();
@@ -838,6 +850,7 @@ void inverseDynamics::run()
     if (!skin_lleg_found) {skinContacts.push_back(left_leg_contact);} 
     
 	//*********************************************** add the legs contacts JUST TEMP FIX!! *******************
+    profiler.mark(stageProfiler::STAGE_CONTACTS);
 
     F_ext_cartesian_left_arm = F_ext_cartesian_right_arm = zeros(6);
     F_ext_cartesian_left_leg = F_ext_cartesian_right_leg = zeros(6);
@@ -866,6 +879,7 @@ void inverseDynamics::run()
     F_sns_right_leg = F_RLeg;
     F_sns_left_leg  = F_LLeg;
 #endif
+    profiler.mark(stageProfiler::STAGE_SENSORS);
 
     yarp::sig::Matrix ht   = icub->upperTorso->getHUp()    * icub->upperTorso->up->getH();
     yarp::sig::Matrix ahl  = ht * icub->upperTorso->getHLeft()  * icub->upperTorso->left->getH();
@@ -951,6 +965,8 @@ void inverseDynamics::run()
     for (int i=0; i<3; i++) F_ext_cartesian_right_foot[i] = tmp1[i];
     for (int i=3; i<6; i++) F_ext_cartesian_right_foot[i] = tmp2[i-3];
 
+    profiler.mark(stageProfiler::STAGE_CARTESIAN);
+
     // *** MONITOR DATA ***
     //sendMonitorData();
 
@@ -1005,6 +1021,8 @@ void inverseDynamics::run()
 
     broadcastData<Matrix> (foot_root_mat,                           port_root_position_mat);
     broadcastData<Vector> (foot_root_vec,                           port_root_position_vec);
+    profiler.mark(stageProfiler::STAGE_BROADCAST);
+    profiler.endCycle();
 }
 
 void inverseDynamics::threadRelease()
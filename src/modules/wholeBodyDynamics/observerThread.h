@@ -28,6 +28,8 @@
 #include <iCub/iDyn/iDynBody.h>
 #include <iCub/skinDynLib/skinContactList.h>
 
+#include "stageProfiler.h"
+
 #include <iostream>
 #include <iomanip>
 #include <cstring>
@@ -135,6 +137,7 @@ public:
     bool       w0_dw0_enabled;
     bool       dumpvel_enabled;
     bool       auto_drift_comp;
+    bool       parallel_limbs;
     bool       default_ee_cont;
     bool       add_legs_once;
 
@@ -295,6 +298,9 @@ private:
     //COM Jacobian Matrix
     Matrix com_jac;
 
+    // per-stage latency of run()
+    stageProfiler profiler;
+
     Vector evalVelUp(const Vector &x);
     Vector evalVelLow(const Vector &x);
     Vector eval_domega(const Vector &x);
@@ -329,6 +335,10 @@ public:
     void setZeroJntAngVelAcc();
     void sendMonitorData();
     void sendVelAccData();
+    inline stageProfiler& getProfiler()
+    {
+        return profiler;
+    }
 
 };
 
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#include "stageProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+using namespace yarp::os;
+
+namespace
+{
+    const char* stage_names[stageProfiler::NUM_STAGES] =
+    {
+        "read", "offset", "upper_body", "lower_body", "torques",
+        "com", "contacts", "sensors", "cartesian", "broadcast"
+    };
+
+    // nearest-rank percentile of an already sorted vector
+    double percentile(const vector<double> &sorted, double p)
+    {
+        if (sorted.empty())
+            return 0.0;
+        size_t k = (size_t)(p * (sorted.size() - 1) + 0.5);
+        return sorted[k];
+    }
+
+    void addStatistics(Bottle &reply, const char *name, vector<double> &durations)
+    {
+        sort(durations.begin(), durations.end());
+        double mean = 0.0;
+        for (size_t i = 0; i < durations.size(); i++)
+            mean += durations[i];
+        if (!durations.empty())
+            mean /= durations.size();
+
+        Bottle &b = reply.addList();
+        b.addString(name);
+        b.addFloat64(1000.0 * mean);
+        b.addFloat64(1000.0 * percentile(durations, 0.50));
+        b.addFloat64(1000.0 * percentile(durations, 0.90));
+        b.addFloat64(1000.0 * percentile(durations, 0.99));
+        b.addFloat64(1000.0 * (durations.empty() ? 0.0 : durations.back()));
+    }
+}
+
+stageProfiler::stageProfiler() : origin(chrono::steady_clock::now()), ring(PROFILE_CYCLES), head(0), first(0), budget(0.0)
+{
+}
+
+double stageProfiler::now() const
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - origin).count();
+}
+
+const char* stageProfiler::getStageName(int s)
+{
+    return (s >= 0 && s < NUM_STAGES) ? stage_names[s] : "unknown";
+}
+
+void stageProfiler::beginCycle()
+{
+    cycle &c = ring[head.load(memory_order_relaxed) % PROFILE_CYCLES];
+
+    // as the writer of a seqlock: a snapshot() that reads any of the values
+    // stored below in the reused slot is then bound to see the head that
+    // caused the reuse when it checks head again after its acquire fence
+    atomic_thread_fence(memory_order_release);
+
+    double t = now();
+    c.start.store(t, memory_order_relaxed);
+    for (int s = 0; s < NUM_STAGES; s++)
+        c.end[s].store(t, memory_order_relaxed);
+}
+
+void stageProfiler::mark(stage_enum s)
+{
+    ring[head.load(memory_order_relaxed) % PROFILE_CYCLES].end[s].store(now(), memory_order_relaxed);
+}
+
+void stageProfiler::endCycle()
+{
+    // publish the cycle: readers only look at the slots before head
+    head.store(head.load(memory_order_relaxed) + 1, memory_order_release);
+}
+
+void stageProfiler::reset()
+{
+    first.store(head.load(memory_order_acquire), memory_order_relaxed);
+}
+
+void stageProfiler::setBudget(double seconds)
+{
+    budget.store(seconds, memory_order_relaxed);
+}
+
+vector<stageProfiler::sample> stageProfiler::snapshot() const
+{
+    unsigned long h = head.load(memory_order_acquire);
+    unsigned long from = first.load(memory_order_relaxed);
+    if (h > PROFILE_CYCLES && from < h - PROFILE_CYCLES)
+        from = h - PROFILE_CYCLES;
+
+    vector<sample> samples;
+    samples.reserve(h - from);
+    for (unsigned long i = from; i < h; i++)
+    {
+        const cycle &c = ring[i % PROFILE_CYCLES];
+        sample s;
+        s.start = c.start.load(memory_order_relaxed);
+        for (int k = 0; k < NUM_STAGES; k++)
+            s.end[k] = c.end[k].load(memory_order_relaxed);
+        samples.push_back(s);
+    }
+
+    // the thread kept running while copying: drop the cycles whose slot may
+    // have been reused in the meantime (the oldest ones)
+    atomic_thread_fence(memory_order_acquire);
+    unsigned long h2 = head.load(memory_order_relaxed);
+    if (h2 >= from + PROFILE_CYCLES)
+    {
+        size_t stale = min((size_t)(h2 - from - PROFILE_CYCLES + 1), samples.size());
+        samples.erase(samples.begin(), samples.begin() + stale);
+    }
+    return samples;
+}
+
+void stageProfiler::getStatistics(Bottle &reply) const
+{
+    vector<sample> samples = snapshot();
+    double limit = budget.load(memory_order_relaxed);
+
+    vector<double> durations(samples.size());
+    int over_budget = 0;
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        durations[i] = samples[i].end[NUM_STAGES-1] - samples[i].start;
+        if (limit > 0.0 && durations[i] > limit)
+            over_budget++;
+    }
+
+    reply.addVocab32("many");
+    char header[128];
+    snprintf(header, sizeof(header), "%d cycles, %d over the %.1f ms budget. Columns: stage mean p50 p90 p99 max [ms]",
+             (int)samples.size(), over_budget, 1000.0 * limit);
+    reply.addString(header);
+    addStatistics(reply, "cycle", durations);
+
+    for (int s = 0; s < NUM_STAGES; s++)
+    {
+        for (size_t i = 0; i < samples.size(); i++)
+            durations[i] = samples[i].end[s] - (s == 0 ? samples[i].start : samples[i].end[s-1]);
+        addStatistics(reply, stage_names[s], durations);
+    }
+}
+
+bool stageProfiler::dumpTrace(const string &filename) const
+{
+    vector<sample> samples = snapshot();
+
+    FILE *f = fopen(filename.c_str(), "w");
+    if (!f)
+        return false;
+
+    // Chrome trace event format, loadable in chrome://tracing or Perfetto
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"inverseDynamics\"}}");
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        const sample &c = samples[i];
+        fprintf(f, ",\n{\"name\":\"cycle\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                1e6 * c.start, 1e6 * (c.end[NUM_STAGES-1] - c.start));
+        double t = c.start;
+        for (int s = 0; s < NUM_STAGES; s++)
+        {
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                    stage_names[s], 1e6 * t, 1e6 * (c.end[s] - t));
+            t = c.end[s];
+        }
+    }
+    fprintf(f, "\n]}\n");
+
+    return (fclose(f) == 0);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+
+#ifndef STAGE_PROFILER
+#define STAGE_PROFILER
+
+#include <yarp/os/Bottle.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Per-stage latency recorder for the inverseDynamics thread.
+ *
+ * The thread calls beginCycle() at the start of run(), mark() at the end of
+ * each stage and endCycle() when the cycle is over. Timestamps are taken
+ * from a monotonic clock and written into a ring buffer holding the last
+ * PROFILE_CYCLES cycles. The ring has a single writer and no locks: readers
+ * (the rpc thread) copy it and drop the slots that the writer may have
+ * overwritten meanwhile, so a slow reader never delays the thread.
+ */
+class stageProfiler
+{
+public:
+    enum stage_enum
+    {
+        STAGE_READ=0,       // sensors, encoders and velocity estimation
+        STAGE_OFFSET,       // offset removal and not-moving check
+        STAGE_UPPER_BODY,   // upper torso kinematics, skin contacts and wrenches
+        STAGE_LOWER_BODY,   // lower torso kinematics and wrenches
+        STAGE_TORQUES,      // joint torques extraction and writing
+        STAGE_COM,          // center of mass
+        STAGE_CONTACTS,     // dyn/skin contacts merging
+        STAGE_SENSORS,      // external wrenches at the F/T sensors
+        STAGE_CARTESIAN,    // cartesian wrenches, root and feet
+        STAGE_BROADCAST,    // output ports
+        NUM_STAGES
+    };
+
+    static const int PROFILE_CYCLES = 1024;
+
+    stageProfiler();
+
+    // writer side, called only by the thread
+    void beginCycle();
+    void mark(stage_enum s);
+    void endCycle();
+
+    // reader side, safe to call from any thread
+    void reset();
+    void setBudget(double seconds);
+    void getStatistics(yarp::os::Bottle &reply) const;
+    bool dumpTrace(const std::string &filename) const;
+
+    static const char* getStageName(int s);
+
+private:
+    struct cycle
+    {
+        std::atomic<double> start;
+        std::atomic<double> end[NUM_STAGES];
+    };
+
+    struct sample
+    {
+        double start;
+        double end[NUM_STAGES];
+    };
+
+    std::chrono::steady_clock::time_point origin;
+    std::vector<cycle>    ring;
+    std::atomic<unsigned long> head;        // index of the cycle being written
+    std::atomic<unsigned long> first;       // cycles before this one were reset
+    std::atomic<double>   budget;
+
+    double now() const;
+    std::vector<sample> snapshot() const;
+};
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+/**
+\defgroup iKinSeedMapBuilder iKinSeedMapBuilder
+
+Builds offline the map of initial guesses used by the Cartesian
+solvers of the iCub arms.
+
+\section intro_sec Description
+The joints space of the arm is sampled uniformly and the
+resulting end-effector poses are arranged in a grid, which is
+then stored in a binary file to be passed to the solver through
+the option <i>seedMap</i>.
+
+\section parameters_sec Parameters
+--type \e type
+- The arm type, e.g. right_v2.
+
+--torso
+- If specified, the torso joints are included in the DOF;
+  otherwise they are kept at zero.
+
+--samples \e N
+- The number of sampled configurations (1000000 by default).
+
+--cellSize \e size
+- The size in meters of the grid cell (0.02 by default).
+
+--maxPerCell \e M
+- The maximum number of configurations per cell (16 by default).
+
+--seed \e s
+- The seed of the random number generator.
+
+--file \e name
+- The output file (seed_map.bin by default).
+*/
+
+#include <string>
+
+#include <yarp/os/Log.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/Value.h>
+
+#include <iCub/iKin/iKinFwd.h>
+#include <iCub/iKin/iKinSeed.h>
+
+using namespace std;
+using namespace yarp::os;
+using namespace iCub::iKin;
+
+
+/************************************************************************/
+int main(int argc, char *argv[])
+{
+    ResourceFinder rf;
+    rf.configure(argc,argv);
+
+    string type=rf.check("type",Value("right")).asString();
+    int samples=rf.check("samples",Value(1000000)).asInt32();
+    double cellSize=rf.check("cellSize",Value(0.02)).asFloat64();
+    int maxPerCell=rf.check("maxPerCell",Value(16)).asInt32();
+    int seed=rf.check("seed",Value(0)).asInt32();
+    string file=rf.check("file",Value("seed_map.bin")).asString();
+
+    iCubArm arm(type);
+    iKinChain &chain=*arm.asChain();
+    if (rf.check("torso"))
+        for (unsigned int i=0; i<3; i++)
+            chain.releaseLink(i);
+
+    yInfo("Sampling %d configurations of %s arm with %u DOF",
+          samples,type.c_str(),chain.getDOF());
+
+    iKinSeedMap map;
+    if (!map.build(chain,samples,cellSize,maxPerCell,seed))
+        return 1;
+
+    yInfo("Storing %d configurations in %s",(int)map.size(),file.c_str());
+    return (map.save(file)?0:1);
+}
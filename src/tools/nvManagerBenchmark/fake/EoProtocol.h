@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+// stand-in of the protocol of icub-firmware-shared with only what theNVmanager uses. the id32 of a network
+// variable is (entity << 16) | (index << 8) | tag and its size depends on the parity of the tag only.
+
+#ifndef _NVMANAGERBENCHMARK_EOPROTOCOL_H_
+#define _NVMANAGERBENCHMARK_EOPROTOCOL_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+typedef std::uint32_t eOprotIP_t;
+typedef std::uint32_t eOprotID32_t;
+typedef std::uint32_t eOipv4addr_t;
+
+enum { eo_ropcode_sig = 4, eo_ropcode_say = 5 };
+enum { eo_rop_SIGNATUREdummy = 0xaa000000 };
+enum { eoprot_board_localboard = 0xff };
+enum { eoprot_endpoint_management = 0, eoprot_entity_mn_comm = 0, eoprot_tag_mn_comm_status_managementprotocolversion = 0 };
+
+typedef struct
+{
+    std::uint8_t major;
+    std::uint8_t minor;
+} eoprot_version_t;
+
+inline eOprotID32_t eoprot_ID_get(int endpoint, int entity, int index, int tag)
+{
+    return (static_cast<eOprotID32_t>(endpoint) << 24) | (static_cast<eOprotID32_t>(entity) << 16) |
+           (static_cast<eOprotID32_t>(index) << 8) | static_cast<eOprotID32_t>(tag);
+}
+
+// the even tags are as large as the configuration of a joint, the odd ones as the one of a motor
+inline std::uint16_t eoprot_variable_sizeof_get(int board, eOprotID32_t id32)
+{
+    return (id32 & 1) ? 104 : 212;
+}
+
+inline void eoprot_ID2information(eOprotID32_t id32, char *str, std::size_t size)
+{
+    std::snprintf(str, size, "ID32 = 0x%08x", id32);
+}
+
+inline void eo_common_ipv4addr_to_string(eOipv4addr_t ipv4, char *str, std::size_t size)
+{
+    std::snprintf(str, size, "10.0.1.%u", ipv4 & 0xff);
+}
+
+#endif
+
@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+// stand-in of the management endpoint of icub-firmware-shared: theNVmanager needs nothing more than EoProtocol.h
+
+#ifndef _NVMANAGERBENCHMARK_EOPROTOCOLMN_H_
+#define _NVMANAGERBENCHMARK_EOPROTOCOLMN_H_
+
+#include "EoProtocol.h"
+
+#endif
+
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+// stand-in of the AbstractEthResource of embObjLib: theNVmanager uses only the properties and the transceiver
+
+#ifndef _NVMANAGERBENCHMARK_ABSTRACTETHRESOURCE_H_
+#define _NVMANAGERBENCHMARK_ABSTRACTETHRESOURCE_H_
+
+#include <string>
+
+#include "EoProtocol.h"
+#include <hostTransceiver.hpp>
+
+namespace eth {
+
+    class AbstractEthResource
+    {
+    public:
+        struct Properties
+        {
+            eOipv4addr_t        ipv4addr;
+            std::string         ipv4addrString;
+            std::string         boardnameString;
+        };
+
+        AbstractEthResource(const Properties &props, HostTransceiver *t) : properties(props), transceiver(t) {}
+
+        const Properties & getProperties() { return properties; }
+        HostTransceiver * getTransceiver() { return transceiver; }
+
+    private:
+        Properties properties;
+        HostTransceiver *transceiver;
+    };
+
+} // namespace eth
+
+#endif
+
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+// stand-in of the TheEthManager of embObjLib: it holds the resources of the fake boards and the period of the
+// transmissions which they emulate
+
+#ifndef _NVMANAGERBENCHMARK_ETHMANAGER_H_
+#define _NVMANAGERBENCHMARK_ETHMANAGER_H_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/SystemClock.h>
+
+#include "EoProtocol.h"
+#include <hostTransceiver.hpp>
+#include <abstractEthResource.h>
+
+using namespace yarp::os;
+using namespace std;
+
+// theNVmanager stores the thread which owns a transaction with ACE: we use the ids of the standard library
+typedef std::size_t ACE_thread_t;
+struct ACE_Thread
+{
+    static ACE_thread_t self() { return std::hash<std::thread::id>()(std::this_thread::get_id()); }
+};
+
+namespace eth {
+
+    class TheEthManager
+    {
+    public:
+        static TheEthManager* instance();
+
+        void setTXperiod(const double period) { txperiod = period; }
+        double getTXperiod(void) { return txperiod; }
+
+        void add(eOipv4addr_t ipv4, AbstractEthResource *resource) { resources[ipv4] = resource; }
+        AbstractEthResource* getEthResource(eOipv4addr_t ipv4);
+
+    private:
+        TheEthManager() : txperiod(0.001) {}
+
+        double txperiod;
+        std::map<eOipv4addr_t, AbstractEthResource*> resources;
+    };
+
+} // namespace eth
+
+#endif
+
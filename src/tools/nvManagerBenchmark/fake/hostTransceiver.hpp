@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+// stand-in of the HostTransceiver of embObjLib. the ROPs are passed to a FakeBoard rather than to the UDP packets
+// and the replies of the board are kept in a local cache.
+
+#ifndef _NVMANAGERBENCHMARK_HOSTTRANSCEIVER_H_
+#define _NVMANAGERBENCHMARK_HOSTTRANSCEIVER_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "EoProtocol.h"
+
+namespace eth {
+
+    class AbstractEthResource;
+    class FakeBoard;
+
+    class HostTransceiver
+    {
+    public:
+        enum { maxSizeOfRXpacket = 1496 };
+        enum { defMaxSizeOfROP = 256, defMaxSizeOfTXpacket = 768 };
+
+        HostTransceiver(const eOipv4addr_t ipv4, FakeBoard *board);
+
+        bool isID32supported(eOprotID32_t id32);
+        bool read(eOprotID32_t id32, void *data);
+        bool addROPset(eOprotID32_t id32, const void *data, std::uint32_t signature = eo_rop_SIGNATUREdummy);
+        bool addROPask(eOprotID32_t id32, std::uint32_t signature = eo_rop_SIGNATUREdummy);
+        AbstractEthResource * getResource();
+        eOipv4addr_t getIPv4();
+
+        // the resource and the transceiver refer to each other, hence the resource is given after the construction
+        void setResource(AbstractEthResource *r);
+
+        // used by the FakeBoard to deliver the value of a say<> ROP
+        void write(eOprotID32_t id32, const std::vector<std::uint8_t> &value);
+
+    private:
+        eOipv4addr_t ipv4;
+        AbstractEthResource *resource;
+        FakeBoard *board;
+        std::mutex mtx;
+        std::map<eOprotID32_t, std::vector<std::uint8_t>> cache;
+    };
+
+} // namespace eth
+
+#endif
+
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+#include <chrono>
+#include <cstring>
+
+#include "theNVmanager.h"
+#include "ethManager.h"
+#include "fakeBoard.h"
+
+using namespace eth;
+
+
+// - class HostTransceiver (stand-in)
+
+HostTransceiver::HostTransceiver(const eOipv4addr_t ipv4, FakeBoard *board) :
+    ipv4(ipv4), resource(nullptr), board(board)
+{
+}
+
+void HostTransceiver::setResource(AbstractEthResource *r)
+{
+    resource = r;
+}
+
+bool HostTransceiver::isID32supported(eOprotID32_t id32)
+{
+    return true;
+}
+
+bool HostTransceiver::read(eOprotID32_t id32, void *data)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    std::map<eOprotID32_t, std::vector<std::uint8_t>>::iterator it = cache.find(id32);
+    if(cache.end() == it)
+    {
+        return false;
+    }
+    std::memcpy(data, it->second.data(), it->second.size());
+    return true;
+}
+
+bool HostTransceiver::addROPset(eOprotID32_t id32, const void *data, std::uint32_t signature)
+{
+    board->enqueue(true, id32, data, signature);
+    return true;
+}
+
+bool HostTransceiver::addROPask(eOprotID32_t id32, std::uint32_t signature)
+{
+    board->enqueue(false, id32, nullptr, signature);
+    return true;
+}
+
+AbstractEthResource * HostTransceiver::getResource()
+{
+    return resource;
+}
+
+eOipv4addr_t HostTransceiver::getIPv4()
+{
+    return ipv4;
+}
+
+void HostTransceiver::write(eOprotID32_t id32, const std::vector<std::uint8_t> &value)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    cache[id32] = value;
+}
+
+
+// - class TheEthManager (stand-in)
+
+TheEthManager* TheEthManager::instance()
+{
+    static TheEthManager manager;
+    return &manager;
+}
+
+AbstractEthResource* TheEthManager::getEthResource(eOipv4addr_t ipv4)
+{
+    std::map<eOipv4addr_t, AbstractEthResource*>::iterator it = resources.find(ipv4);
+    return (resources.end() == it) ? nullptr : it->second;
+}
+
+
+// - class FakeBoard
+
+FakeBoard::FakeBoard(const Config &config) :
+    config(config), transceiver(nullptr), gen(config.seed), running(false), droprate(config.droprate), lostreplies(0)
+{
+}
+
+FakeBoard::~FakeBoard()
+{
+    stop();
+}
+
+bool FakeBoard::start(HostTransceiver *t)
+{
+    if(running || (nullptr == t))
+    {
+        return false;
+    }
+    transceiver = t;
+    running = true;
+    thread = std::thread(&FakeBoard::run, this);
+    return true;
+}
+
+void FakeBoard::stop()
+{
+    if(running)
+    {
+        running = false;
+        thread.join();
+    }
+}
+
+void FakeBoard::setDroprate(const double rate)
+{
+    droprate = rate;
+}
+
+unsigned int FakeBoard::getLostReplies()
+{
+    return lostreplies;
+}
+
+std::vector<std::uint8_t> FakeBoard::getValue(const eOprotID32_t id32)
+{
+    std::lock_guard<std::mutex> lck(mtx);
+    std::map<eOprotID32_t, std::vector<std::uint8_t>>::iterator it = values.find(id32);
+    if(values.end() == it)
+    {
+        return std::vector<std::uint8_t>(eoprot_variable_sizeof_get(eoprot_board_localboard, id32), 0);
+    }
+    return it->second;
+}
+
+void FakeBoard::enqueue(const bool set, const eOprotID32_t id32, const void *data, const std::uint32_t signature)
+{
+    Rop rop {set, id32, {}, signature};
+    if(set)
+    {
+        const std::uint8_t *d = static_cast<const std::uint8_t*>(data);
+        rop.data.assign(d, d + eoprot_variable_sizeof_get(eoprot_board_localboard, id32));
+    }
+
+    std::lock_guard<std::mutex> lck(mtx);
+    queued.push_back(std::move(rop));
+}
+
+void FakeBoard::run()
+{
+    typedef std::chrono::steady_clock clock;
+    const clock::duration txperiod = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(config.txperiod));
+    const clock::duration latency = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(config.latency));
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    clock::time_point next = clock::now();
+    while(running)
+    {
+        // the transmission of the host
+        next += txperiod;
+        std::this_thread::sleep_until(next);
+
+        std::deque<Rop> packet;
+        {
+            std::lock_guard<std::mutex> lck(mtx);
+            packet.swap(queued);
+        }
+        if(packet.empty())
+        {
+            continue;
+        }
+
+        // the board receives the packet, parses it and transmits its replies
+        std::this_thread::sleep_for(latency);
+
+        std::size_t replybytes = 0;
+        for(size_t i=0; i<packet.size(); i++)
+        {
+            Rop &rop = packet[i];
+            if(rop.set)
+            {
+                std::lock_guard<std::mutex> lck(mtx);
+                values[rop.id32] = rop.data;
+                continue;
+            }
+
+            std::vector<std::uint8_t> value = getValue(rop.id32);
+            replybytes += value.size();
+            if((replybytes > config.replybytes) || (uniform(gen) < droprate))
+            {
+                lostreplies++;
+                continue;
+            }
+
+            transceiver->write(rop.id32, value);
+            theNVmanager::getInstance().onarrival(theNVmanager::ropCode::say, transceiver->getIPv4(), rop.id32, rop.signature);
+        }
+    }
+}
+
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+#ifndef _NVMANAGERBENCHMARK_FAKEBOARD_H_
+#define _NVMANAGERBENCHMARK_FAKEBOARD_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <hostTransceiver.hpp>
+
+namespace eth {
+
+    // a board which keeps its network variables in memory. every txperiod it takes the ROPs queued by its
+    // HostTransceiver, as EthSender would send them, and after latency it applies the set<> ROPs and replies to
+    // the ask<> ROPs through theNVmanager::onarrival(). the replies which do not fit into replybytes are lost,
+    // as those of a real board which overflow its packet, and a fraction droprate of the others too.
+    class FakeBoard
+    {
+    public:
+        struct Config
+        {
+            double          txperiod {0.001};
+            double          latency {0.0006};
+            double          droprate {0.0};
+            std::size_t     replybytes {HostTransceiver::defMaxSizeOfTXpacket};
+            unsigned int    seed {0};
+        };
+
+        FakeBoard(const Config &config);
+        ~FakeBoard();
+
+        // the transceiver which receives the replies. the board starts to serve the ROPs only after it
+        bool start(HostTransceiver *t);
+        void stop();
+
+        void setDroprate(const double droprate);
+        unsigned int getLostReplies();
+
+        // the value of a network variable as set by the host, or zeros if the host never set it
+        std::vector<std::uint8_t> getValue(const eOprotID32_t id32);
+
+        // used by the HostTransceiver to load the ROPs of the next transmission
+        void enqueue(const bool set, const eOprotID32_t id32, const void *data, const std::uint32_t signature);
+
+    private:
+        struct Rop
+        {
+            bool set;
+            eOprotID32_t id32;
+            std::vector<std::uint8_t> data;
+            std::uint32_t signature;
+        };
+
+        void run();
+
+        Config config;
+        HostTransceiver *transceiver;
+        std::mt19937 gen;
+        std::mutex mtx;
+        std::deque<Rop> queued;
+        std::map<eOprotID32_t, std::vector<std::uint8_t>> values;
+        std::atomic<bool> running;
+        std::atomic<double> droprate;
+        std::atomic<unsigned int> lostreplies;
+        std::thread thread;
+    };
+
+} // namespace eth
+
+#endif
+
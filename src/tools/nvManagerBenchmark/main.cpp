@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+/**
+\defgroup nvManagerBenchmark nvManagerBenchmark
+
+Measures the time theNVmanager takes to configure and read back
+the network variables of several boards, as at the startup and at
+the calibration of the robot.
+
+\section intro_sec Description
+The theNVmanager of embObjLib is built against fake boards, which
+keep their network variables in memory and reply after a given
+latency to the ROPs that the host transmits once per period of
+EthSender. No network and no real board are needed.
+
+The tool sets the configuration of some joints of every board
+and measures:
+- setcheck() of one network variable at a time, as the devices
+  used to do at startup;
+- setcheck() of all the network variables of a board at once;
+- ask() of one network variable at a time;
+- askasync() of all the network variables of all the boards,
+  kept outstanding at the same time.
+
+\section parameters_sec Parameters
+--boards \e N
+- The number of boards (4 by default).
+
+--joints \e M
+- The number of joints of every board, each with two network
+  variables (12 by default).
+
+--txperiod \e T
+- The period of the transmissions of EthSender in seconds (0.001
+  by default).
+
+--latency \e L
+- The time in seconds a board takes to reply (0.0006 by default).
+
+--droprate \e p
+- The fraction of the replies lost by the boards (0 by default).
+
+--waitbeforecheck \e w, --timeout \e t, --retries \e r
+- The arguments passed to setcheck() (0.010, 0.050 and 10 by
+  default).
+*/
+
+#include <cstdio>
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <yarp/os/Log.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/Value.h>
+
+#include "theNVmanager.h"
+#include "ethManager.h"
+#include "fakeBoard.h"
+
+using namespace std;
+using namespace yarp::os;
+using namespace eth;
+
+
+namespace
+{
+    struct Board
+    {
+        FakeBoard *board;
+        AbstractEthResource *resource;
+        HostTransceiver *transceiver;
+    };
+
+    typedef chrono::steady_clock clock;
+
+    double elapsed(const clock::time_point &t0)
+    {
+        return chrono::duration<double>(clock::now()-t0).count();
+    }
+
+    void clearReadback(const vector<vector<uint8_t> > &values, vector<vector<vector<uint8_t> > > &readback)
+    {
+        for (size_t b=0; b<readback.size(); b++)
+        {
+            readback[b].resize(values.size());
+            for (size_t i=0; i<values.size(); i++)
+                readback[b][i].assign(values[i].size(),0);
+        }
+    }
+
+    int countReadback(const vector<vector<uint8_t> > &values, const vector<vector<vector<uint8_t> > > &readback)
+    {
+        int count=0;
+        for (size_t b=0; b<readback.size(); b++)
+            for (size_t i=0; i<values.size(); i++)
+                count+=(readback[b][i]==values[i]);
+        return count;
+    }
+}
+
+
+/************************************************************************/
+int main(int argc, char *argv[])
+{
+    ResourceFinder rf;
+    rf.configure(argc,argv);
+
+    int numBoards=rf.check("boards",Value(4)).asInt32();
+    int numJoints=rf.check("joints",Value(12)).asInt32();
+    double waitbeforecheck=rf.check("waitbeforecheck",Value(0.010)).asFloat64();
+    double timeout=rf.check("timeout",Value(0.050)).asFloat64();
+    int retries=rf.check("retries",Value(10)).asInt32();
+
+    FakeBoard::Config config;
+    config.txperiod=rf.check("txperiod",Value(config.txperiod)).asFloat64();
+    config.latency=rf.check("latency",Value(config.latency)).asFloat64();
+    config.droprate=rf.check("droprate",Value(config.droprate)).asFloat64();
+
+    if ((numBoards<1) || (numJoints<1) || (retries<0) || (config.txperiod<=0.0) || (config.latency<0.0) ||
+        (config.droprate<0.0) || (config.droprate>=1.0))
+    {
+        yError("Invalid parameters");
+        return 1;
+    }
+
+    // the fake boards, registered in the TheEthManager seen by theNVmanager
+    TheEthManager::instance()->setTXperiod(config.txperiod);
+    vector<Board> boards(numBoards);
+    for (int b=0; b<numBoards; b++)
+    {
+        const eOipv4addr_t ipv4=b+1;
+        config.seed=b;
+
+        AbstractEthResource::Properties props;
+        props.ipv4addr=ipv4;
+        props.ipv4addrString="10.0.1."+to_string(ipv4);
+        props.boardnameString="fake"+to_string(ipv4);
+
+        boards[b].board=new FakeBoard(config);
+        boards[b].transceiver=new HostTransceiver(ipv4,boards[b].board);
+        boards[b].resource=new AbstractEthResource(props,boards[b].transceiver);
+        boards[b].transceiver->setResource(boards[b].resource);
+        TheEthManager::instance()->add(ipv4,boards[b].resource);
+        boards[b].board->start(boards[b].transceiver);
+    }
+
+    // the configuration of the joints: two network variables for each of them
+    vector<eOprotID32_t> id32s;
+    for (int j=0; j<numJoints; j++)
+    {
+        id32s.push_back(eoprot_ID_get(1,0,j,2));
+        id32s.push_back(eoprot_ID_get(1,1,j,3));
+    }
+
+    vector<vector<uint8_t> > values(id32s.size());
+    vector<void*> pvalues(id32s.size());
+    for (size_t i=0; i<id32s.size(); i++)
+    {
+        values[i].assign(theNVmanager::getInstance().sizeOfNV(id32s[i]),(uint8_t)(i+1));
+        pvalues[i]=values[i].data();
+    }
+
+    theNVmanager &nvman=theNVmanager::getInstance();
+    printf("%d boards x %zu NVs, txperiod %.4f s, latency %.4f s, droprate %.3f\n",numBoards,id32s.size(),
+           config.txperiod,config.latency,config.droprate);
+
+    // 1. setcheck() of one network variable at a time
+    clock::time_point t0=clock::now();
+    bool ok=true;
+    for (int b=0; b<numBoards; b++)
+        for (size_t i=0; i<id32s.size(); i++)
+            ok&=nvman.setcheck(boards[b].transceiver,id32s[i],pvalues[i],retries,waitbeforecheck,timeout);
+    printf("%-32s %10.1f ms %s\n","setcheck() one NV at a time",1000.0*elapsed(t0),ok?"ok":"FAILED");
+
+    // 2. setcheck() of all the network variables of a board, with new values
+    for (size_t i=0; i<values.size(); i++)
+        for (size_t k=0; k<values[i].size(); k++)
+            values[i][k]^=0x5a;
+
+    t0=clock::now();
+    ok=true;
+    for (int b=0; b<numBoards; b++)
+        ok&=nvman.setcheck(boards[b].transceiver,id32s,pvalues,retries,waitbeforecheck,timeout);
+    double t=elapsed(t0);
+    for (int b=0; b<numBoards; b++)
+        for (size_t i=0; i<id32s.size(); i++)
+            ok&=(boards[b].board->getValue(id32s[i])==values[i]);
+    printf("%-32s %10.1f ms %s\n","setcheck() all NVs of a board",1000.0*t,ok?"ok":"FAILED");
+
+    // 3. ask() of one network variable at a time
+    vector<vector<vector<uint8_t> > > readback(numBoards);
+    clearReadback(values,readback);
+    t0=clock::now();
+    for (int b=0; b<numBoards; b++)
+        for (size_t i=0; i<id32s.size(); i++)
+            nvman.ask(boards[b].transceiver,id32s[i],readback[b][i].data(),timeout);
+    t=elapsed(t0);
+    printf("%-32s %10.1f ms %d/%zu NVs read back\n","ask() one NV at a time",1000.0*t,
+           countReadback(values,readback),numBoards*id32s.size());
+
+    // 4. askasync() of all the network variables of all the boards at once. as setcheck() does, we load
+    // in every transmission only the requests whose replies fit into the packets of the boards
+    const size_t maxbytesperpacket=HostTransceiver::defMaxSizeOfTXpacket/2;
+    vector<future<bool> > futures;
+    clearReadback(values,readback);
+    t0=clock::now();
+    for (size_t first=0; first<id32s.size();)
+    {
+        size_t last=first, loaded=0;
+        while ((last<id32s.size()) && ((last==first) || (loaded+values[last].size()<=maxbytesperpacket)))
+            loaded+=values[last++].size();
+
+        for (int b=0; b<numBoards; b++)
+            for (size_t i=first; i<last; i++)
+                futures.push_back(nvman.askasync(boards[b].transceiver,{id32s[i]},{readback[b][i].data()},timeout));
+
+        first=last;
+        if (first<id32s.size())
+            SystemClock::delaySystem(config.txperiod);
+    }
+    for (size_t k=0; k<futures.size(); k++)
+        futures[k].wait();
+    t=elapsed(t0);
+    printf("%-32s %10.1f ms %d/%zu NVs read back\n","askasync() all NVs of all boards",1000.0*t,
+           countReadback(values,readback),futures.size());
+
+    unsigned int lost=0;
+    for (int b=0; b<numBoards; b++)
+    {
+        boards[b].board->stop();
+        lost+=boards[b].board->getLostReplies();
+    }
+    printf("%u replies lost by the boards\n",lost);
+
+    // theNVmanager lives as long as the process and its threads may still refer to the boards
+    return 0;
+}
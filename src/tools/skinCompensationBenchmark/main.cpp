@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+/**
+\defgroup skinCompensationBenchmark skinCompensationBenchmark
+
+Measures the time skinManager takes to compensate the taxels of a
+whole-body skin.
+
+\section intro_sec Description
+The skin parts are filled with random baselines and thresholds and
+fed with raw data near the baselines, with a few taxels pressed at
+each cycle. Every part is compensated with the fused
+compensateTaxels() kernel and with the previous code, i.e. the
+compensation loop followed by the baseline update. The tool reports
+the time per cycle of each part and of the whole skin, for both.
+
+\section parameters_sec Parameters
+--parts "(n1 n2 ...)"
+- The number of taxels of each skin part. By default the parts of
+  the two hands, forearms and upper arms and of the torso are used
+  ((192 384 768 192 384 768 768), 3456 taxels).
+
+--cycles \e M
+- The number of compensation cycles measured (20000 by default).
+
+--smooth, --binarization, --zeroUp
+- Turn on the smooth filter, the binarization filter and the
+  zero-up raw data of the compensator.
+
+--seed \e s
+- The seed of the random number generator.
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/Log.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/Value.h>
+
+#include <iCub/skinManager/compensationKernel.h>
+
+using namespace std;
+using namespace yarp::os;
+using namespace iCub::skinManager;
+
+namespace
+{
+    const int MAX_SKIN = 255;
+    const double BIN_TOUCH = 100.0;
+    const double BIN_NO_TOUCH = 0.0;
+    const double SMOOTH_FACTOR = 0.7;
+    const double ADD_THRESHOLD = 2.0;
+    const double COMPENSATION_GAIN = 0.05;
+    const double CONTACT_COMPENSATION_GAIN = 0.01;
+
+    // the state of a skin part, with the containers used by Compensator
+    struct Part
+    {
+        vector<double> baselines, thresholds, compensated, compensatedOld, compensatedFilt, output;
+        vector<unsigned char> touch, subTouch, touchFilt;
+        vector<bool> touchBool, subTouchBool, touchFiltBool;
+        vector<vector<double> > raw;
+    };
+}
+
+
+/************************************************************************/
+void initPart(Part &p, const unsigned int n, const bool zeroUp, mt19937 &gen)
+{
+    uniform_real_distribution<double> base(5.0,40.0), thr(0.5,6.0), press(0.0,1.0);
+    normal_distribution<double> noise(0.0,2.0);
+
+    p.baselines.resize(n); p.thresholds.resize(n);
+    for (unsigned int i=0; i<n; i++)
+    {
+        p.baselines[i]=base(gen);
+        p.thresholds[i]=thr(gen);
+    }
+    p.compensated.assign(n,0.0); p.compensatedOld.assign(n,0.0);
+    p.compensatedFilt.assign(n,0.0); p.output.assign(n,0.0);
+    p.touch.assign(n,0); p.subTouch.assign(n,0); p.touchFilt.assign(n,0);
+    p.touchBool.assign(n,false); p.subTouchBool.assign(n,false); p.touchFiltBool.assign(n,false);
+
+    // a few frames of raw data are cycled to keep the branches of the previous code honest
+    p.raw.assign(16,vector<double>(n));
+    for (size_t f=0; f<p.raw.size(); f++)
+    {
+        for (unsigned int i=0; i<n; i++)
+        {
+            double v=p.baselines[i]+noise(gen)+(press(gen)<0.05?40.0:0.0);
+            v=std::max(0.0,std::min((double)MAX_SKIN,v));
+            p.raw[f][i]=(zeroUp?v:MAX_SKIN-v);
+        }
+    }
+}
+
+
+/************************************************************************/
+// Compensator::readRawAndWriteCompensatedData() followed by Compensator::updateBaseline(),
+// as they were before the compensation was fused into compensateTaxels()
+unsigned int previousCompensation(const bool zeroUp, const bool smooth, const bool binarization,
+                                  const vector<double> &raw, Part &p)
+{
+    const unsigned int n=(unsigned int)raw.size();
+    double d;
+    for (unsigned int i=0; i<n; i++)
+    {
+        d=(double)(zeroUp?raw[i]-p.baselines[i]:MAX_SKIN-raw[i]-p.baselines[i]);
+        d=std::min<double>(MAX_SKIN,d);
+        p.compensated[i]=d;
+
+        p.touchBool[i]=(d>p.thresholds[i]+ADD_THRESHOLD);
+        p.subTouchBool[i]=(d<-p.thresholds[i]-ADD_THRESHOLD);
+
+        if (smooth)
+        {
+            d=(1-SMOOTH_FACTOR)*d+SMOOTH_FACTOR*p.compensatedOld[i];
+            p.compensatedOld[i]=d;
+        }
+        p.compensatedFilt[i]=d;
+
+        p.touchFiltBool[i]=(d>p.thresholds[i]+ADD_THRESHOLD);
+        if (binarization)
+            d=(p.touchFiltBool[i]?BIN_TOUCH:BIN_NO_TOUCH);
+
+        p.output[i]=std::max<double>(0.0,d);
+    }
+
+    double gain;
+    unsigned int negativeBaselines=0;
+    for (unsigned int j=0; j<n; j++)
+    {
+        d=p.compensated[j];
+        if (p.touchBool[j])
+            gain=CONTACT_COMPENSATION_GAIN*0.02;
+        else
+            gain=COMPENSATION_GAIN*0.02;
+        p.baselines[j]+=gain*d/p.thresholds[j];
+        if (p.baselines[j]<0)
+            negativeBaselines++;
+    }
+    return negativeBaselines;
+}
+
+
+/************************************************************************/
+bool sameData(const vector<double> &a, const vector<double> &b)
+{
+    // the compiler may contract the two versions into different instructions
+    for (size_t i=0; i<a.size(); i++)
+        if (fabs(a[i]-b[i])>1e-9*std::max(1.0,fabs(a[i])))
+            return false;
+    return true;
+}
+
+
+/************************************************************************/
+int main(int argc, char *argv[])
+{
+    ResourceFinder rf;
+    rf.configure(argc,argv);
+
+    int cycles=rf.check("cycles",Value(20000)).asInt32();
+    int seed=rf.check("seed",Value(0)).asInt32();
+    bool smooth=rf.check("smooth");
+    bool binarization=rf.check("binarization");
+    bool zeroUp=rf.check("zeroUp");
+
+    vector<unsigned int> sizes;
+    if (Bottle *b=rf.find("parts").asList())
+    {
+        for (size_t i=0; i<b->size(); i++)
+            sizes.push_back(b->get(i).asInt32());
+    }
+    else
+        sizes={192,384,768,192,384,768,768};
+
+    if ((cycles<1) || sizes.empty() || (find(sizes.begin(),sizes.end(),0u)!=sizes.end()))
+    {
+        yError("Invalid parameters");
+        return 1;
+    }
+
+    // same coefficients as Compensator::readRawAndWriteCompensatedData(true)
+    CompensationCoeffs k;
+    k.rawOffset=(zeroUp?0.0:(double)MAX_SKIN);
+    k.rawSign=(zeroUp?1.0:-1.0);
+    k.addThr=ADD_THRESHOLD;
+    k.smoothNew=(smooth?1.0-SMOOTH_FACTOR:1.0);
+    k.smoothOld=(smooth?SMOOTH_FACTOR:0.0);
+    k.touchGain=CONTACT_COMPENSATION_GAIN*0.02;
+    k.noTouchGain=COMPENSATION_GAIN*0.02;
+    k.binTouch=BIN_TOUCH;
+    k.binNoTouch=BIN_NO_TOUCH;
+    k.binarize=binarization;
+
+    mt19937 gen(seed);
+    vector<Part> previous(sizes.size()), fused(sizes.size());
+    unsigned int total=0;
+    for (size_t i=0; i<sizes.size(); i++)
+    {
+        mt19937 partGen(gen());
+        mt19937 copyGen=partGen;
+        initPart(previous[i],sizes[i],zeroUp,partGen);
+        initPart(fused[i],sizes[i],zeroUp,copyGen);
+        total+=sizes[i];
+    }
+
+    typedef chrono::steady_clock clock;
+    vector<double> tPrevious(sizes.size(),0.0), tFused(sizes.size(),0.0);
+    unsigned long negatives[2]={0,0};
+    for (int c=0; c<cycles; c++)
+    {
+        for (size_t i=0; i<sizes.size(); i++)
+        {
+            Part &p=previous[i];
+            const vector<double> &raw=p.raw[c%p.raw.size()];
+            clock::time_point t0=clock::now();
+            negatives[0]+=previousCompensation(zeroUp,smooth,binarization,raw,p);
+            clock::time_point t1=clock::now();
+            tPrevious[i]+=chrono::duration<double>(t1-t0).count();
+
+            Part &q=fused[i];
+            const vector<double> &rawq=q.raw[c%q.raw.size()];
+            t0=clock::now();
+            negatives[1]+=compensateTaxels(k,sizes[i],rawq.data(),q.thresholds.data(),q.baselines.data(),
+                                           q.compensated.data(),q.compensatedOld.data(),q.compensatedFilt.data(),
+                                           q.output.data(),q.touch.data(),q.subTouch.data(),q.touchFilt.data(),
+                                           MAX_SKIN);
+            t1=clock::now();
+            tFused[i]+=chrono::duration<double>(t1-t0).count();
+        }
+    }
+
+    // both versions must have produced the same data
+    for (size_t i=0; i<sizes.size(); i++)
+    {
+        if (!sameData(previous[i].output,fused[i].output) || !sameData(previous[i].baselines,fused[i].baselines))
+        {
+            yError("The compensated data of part %zu differ between the two versions",i);
+            return 1;
+        }
+    }
+    if (negatives[0]!=negatives[1])
+    {
+        yError("The number of negative baselines differs between the two versions");
+        return 1;
+    }
+
+    printf("%zu parts, %u taxels, %d cycles, smooth=%d binarization=%d zeroUp=%d\n",sizes.size(),
+           total,cycles,smooth,binarization,zeroUp);
+    printf("%8s %8s %16s %16s %8s\n","part","taxels","previous[us]","fused[us]","speedup");
+    double sumPrevious=0.0, sumFused=0.0;
+    for (size_t i=0; i<sizes.size(); i++)
+    {
+        printf("%8zu %8u %16.3f %16.3f %8.2f\n",i,sizes[i],1e6*tPrevious[i]/cycles,
+               1e6*tFused[i]/cycles,tPrevious[i]/tFused[i]);
+        sumPrevious+=tPrevious[i];
+        sumFused+=tFused[i];
+    }
+    printf("%8s %8u %16.3f %16.3f %8.2f\n","all",total,1e6*sumPrevious/cycles,
+           1e6*sumFused/cycles,sumPrevious/sumFused);
+
+    return 0;
+}
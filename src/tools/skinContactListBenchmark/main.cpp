@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+*/
+
+/**
+\defgroup skinContactListBenchmark skinContactListBenchmark
+
+Measures the encode/decode throughput and the payload size of a
+skinContactList in the default and in the packed format.
+
+\section intro_sec Description
+A list of contacts with random values is written to and read back
+from an in-memory connection, once with the default Bottle-compatible
+format and once with the packed binary format. For each number of
+taxels per contact the tool reports the payload size and the number
+of lists encoded, decoded and encoded+decoded per second.
+
+\section parameters_sec Parameters
+--contacts \e N
+- The number of contacts in the list (10 by default).
+
+--taxels "(n1 n2 ...)"
+- The numbers of active taxels per contact to measure
+  ((4 40 200) by default).
+
+--iterations \e M
+- The number of lists encoded and decoded for each measure (20000
+  by default).
+
+--seed \e s
+- The seed of the random number generator.
+*/
+
+#include <cstdio>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/DummyConnector.h>
+#include <yarp/os/Log.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/Value.h>
+#include <yarp/sig/Vector.h>
+
+#include <iCub/skinDynLib/skinContactList.h>
+
+using namespace std;
+using namespace yarp::os;
+using namespace yarp::sig;
+using namespace iCub::skinDynLib;
+
+
+/************************************************************************/
+skinContactList makeContacts(const int numContacts, const int numTaxels, mt19937 &gen)
+{
+    uniform_real_distribution<double> real(-1.0,1.0);
+    uniform_int_distribution<unsigned int> start(0,700);
+    uniform_int_distribution<unsigned int> step(1,12);
+
+    skinContactList list;
+    for (int i=0; i<numContacts; i++)
+    {
+        Vector CoP(3),geoCenter(3),F(3),Mu(3),normalDir(3);
+        for (int j=0; j<3; j++)
+        {
+            CoP[j]=real(gen);
+            geoCenter[j]=real(gen);
+            F[j]=10.0*real(gen);
+            Mu[j]=real(gen);
+            normalDir[j]=real(gen);
+        }
+
+        // taxel ids are mostly increasing, with an occasional step back
+        vector<unsigned int> taxels;
+        unsigned int id=start(gen);
+        for (int k=0; k<numTaxels; k++)
+        {
+            taxels.push_back(id);
+            id=(k%7==6?id-step(gen)/2:id+step(gen));
+        }
+
+        skinContact c(RIGHT_ARM,SKIN_RIGHT_FOREARM,4,CoP,geoCenter,taxels,20.0*real(gen),normalDir);
+        c.setForceMoment(F,Mu);
+        list.push_back(c);
+    }
+
+    return list;
+}
+
+
+/************************************************************************/
+struct Measure
+{
+    size_t payload;
+    double encodeRate;
+    double decodeRate;
+    double roundTripRate;
+};
+
+
+/************************************************************************/
+bool measure(skinContactList &list, const bool packed, const int iterations, Measure &m)
+{
+    typedef chrono::steady_clock clock;
+    list.setPackedFormat(packed);
+
+    // encode only: the connector is reset at each iteration
+    clock::time_point t0=clock::now();
+    for (int k=0; k<iterations; k++)
+    {
+        DummyConnector connector;
+        if (!list.write(connector.getWriter()))
+            return false;
+    }
+    clock::time_point t1=clock::now();
+    m.encodeRate=iterations/chrono::duration<double>(t1-t0).count();
+
+    // decode only: getReader() rewinds onto the same payload each time
+    DummyConnector connector;
+    if (!list.write(connector.getWriter()))
+        return false;
+    m.payload=connector.getReader().getSize();
+
+    skinContactList received;
+    t0=clock::now();
+    for (int k=0; k<iterations; k++)
+    {
+        if (!received.read(connector.getReader()))
+            return false;
+    }
+    t1=clock::now();
+    m.decodeRate=iterations/chrono::duration<double>(t1-t0).count();
+
+    // encode and decode, as it happens between two modules
+    t0=clock::now();
+    for (int k=0; k<iterations; k++)
+    {
+        DummyConnector rt;
+        if (!list.write(rt.getWriter()) || !received.read(rt.getReader()))
+            return false;
+    }
+    t1=clock::now();
+    m.roundTripRate=iterations/chrono::duration<double>(t1-t0).count();
+
+    return (received.size()==list.size());
+}
+
+
+/************************************************************************/
+int main(int argc, char *argv[])
+{
+    ResourceFinder rf;
+    rf.configure(argc,argv);
+
+    int numContacts=rf.check("contacts",Value(10)).asInt32();
+    int iterations=rf.check("iterations",Value(20000)).asInt32();
+    int seed=rf.check("seed",Value(0)).asInt32();
+
+    vector<int> taxels;
+    if (Bottle *b=rf.find("taxels").asList())
+    {
+        for (size_t i=0; i<b->size(); i++)
+            taxels.push_back(b->get(i).asInt32());
+    }
+    else
+        taxels={4,40,200};
+
+    if ((numContacts<1) || (iterations<1) || taxels.empty())
+    {
+        yError("Invalid parameters");
+        return 1;
+    }
+
+    mt19937 gen(seed);
+
+    printf("%d contacts, %d iterations\n",numContacts,iterations);
+    printf("%8s %8s %12s %14s %14s %14s %12s\n","taxels","format","payload[B]",
+           "encode[1/s]","decode[1/s]","enc+dec[1/s]","enc+dec[MB/s]");
+    for (size_t i=0; i<taxels.size(); i++)
+    {
+        skinContactList list=makeContacts(numContacts,taxels[i],gen);
+        for (int packed=0; packed<2; packed++)
+        {
+            Measure m;
+            if (!measure(list,packed!=0,iterations,m))
+            {
+                yError("Unable to encode/decode the list in the %s format",packed?"packed":"default");
+                return 1;
+            }
+
+            printf("%8d %8s %12zu %14.0f %14.0f %14.0f %12.1f\n",taxels[i],packed?"packed":"default",
+                   m.payload,m.encodeRate,m.decodeRate,m.roundTripRate,m.roundTripRate*m.payload/1e6);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <iCub/ctrl/adaptWinPolyEstimator.h>
+
+using namespace yarp::sig;
+using namespace iCub::ctrl;
+
+namespace
+{
+	// noisy sinusoids with a step on some channels, sampled at ~100 Hz with jitter
+	std::vector<AWPolyElement> makeSignals(unsigned int dim, unsigned int len)
+	{
+		std::mt19937 gen(0);
+		std::normal_distribution<double> noise(0.0, 0.05);
+		std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+
+		std::vector<AWPolyElement> signals;
+		double t = 0.0;
+		for (unsigned int k = 0; k < len; k++)
+		{
+			t += 0.01 * (1.0 + jitter(gen));
+			Vector x(dim);
+			for (unsigned int i = 0; i < dim; i++)
+			{
+				x[i] = 30.0 * sin(2.0 * M_PI * (0.2 + 0.05 * i) * t + i) + noise(gen);
+				if ((i % 3 == 0) && (k > len / 2))
+					x[i] += 10.0;
+			}
+			signals.emplace_back(x, t);
+		}
+
+		return signals;
+	}
+
+	void checkAgreement(AWPolyEstimator &standard, AWPolyEstimator &incremental, double tol)
+	{
+		ASSERT_TRUE(incremental.setIncrementalMode(true));
+
+		const unsigned int dim = 60;
+		std::vector<AWPolyElement> signals = makeSignals(dim, 1000);
+		for (const AWPolyElement &el : signals)
+		{
+			Vector e1 = standard.estimate(el);
+			Vector e2 = incremental.estimate(el);
+			ASSERT_EQ(e1.length(), e2.length());
+
+			Vector w1 = standard.getWinLen();
+			Vector w2 = incremental.getWinLen();
+			for (unsigned int i = 0; i < dim; i++)
+			{
+				EXPECT_NEAR(e1[i], e2[i], tol * (1.0 + fabs(e1[i])));
+				EXPECT_EQ(w1[i], w2[i]);
+			}
+		}
+	}
+}
+
+TEST(AWPolyEstimator, incremental_lin_agreement)
+{
+	AWLinEstimator standard(16, 1.0), incremental(16, 1.0);
+	checkAgreement(standard, incremental, 1e-8);
+}
+
+TEST(AWPolyEstimator, incremental_quad_agreement)
+{
+	AWQuadEstimator standard(25, 1.0), incremental(25, 1.0);
+	checkAgreement(standard, incremental, 1e-6);
+}
+
+TEST(AWPolyEstimator, incremental_order_limit)
+{
+	AWLinEstimator lin(16, 1.0);
+	EXPECT_TRUE(lin.setIncrementalMode(true));
+	EXPECT_TRUE(lin.getIncrementalMode());
+
+	class AWCubicEstimator : public AWPolyEstimator
+	{
+	protected:
+		double getEsteeme() override { return coeff[1]; }
+
+	public:
+		AWCubicEstimator() : AWPolyEstimator(3, 16, 1.0) {}
+	} estimator;
+
+	EXPECT_FALSE(estimator.setIncrementalMode(true));
+	EXPECT_FALSE(estimator.getIncrementalMode());
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <iCub/ctrl/filters.h>
+
+using namespace yarp::sig;
+using namespace iCub::ctrl;
+
+namespace
+{
+	double referenceMedian(const std::deque<double>& window)
+	{
+		std::vector<double> v(window.begin(), window.end());
+		std::sort(v.begin(), v.end());
+		size_t L = v.size() >> 1;
+		return ((v.size() & 0x01) ? v[L] : 0.5 * (v[L] + v[L - 1]));
+	}
+}
+
+TEST(MedianFilter, matches_sorted_window)
+{
+	std::mt19937 gen(0);
+	std::uniform_real_distribution<double> real(-1.0, 1.0);
+	std::uniform_int_distribution<int> quantized(-3, 3);
+
+	for (size_t n = 0; n < 40; n++)
+	{
+		// the second channel is quantized to stress repeated values
+		Vector y0(2, 0.5);
+		MedianFilter filter(n, y0);
+		std::deque<double> window[2];
+
+		for (int k = 0; k < 500; k++)
+		{
+			Vector u(2);
+			u[0] = real(gen);
+			u[1] = quantized(gen);
+			const Vector& y = filter.filt(u);
+
+			for (int c = 0; c < 2; c++)
+			{
+				window[c].push_front(u[c]);
+				if (window[c].size() > n)
+				{
+					EXPECT_EQ(y[c], referenceMedian(window[c])) << "n=" << n << " k=" << k;
+					window[c].pop_back();
+				}
+				else
+				{
+					EXPECT_EQ(y[c], y0[c]);
+				}
+			}
+		}
+	}
+}
+
+TEST(MedianFilter, reset_on_new_order)
+{
+	MedianFilter filter(2, Vector(1, 0.0));
+	Vector u(1);
+	for (int k = 1; k <= 5; k++)
+	{
+		u[0] = k;
+		filter.filt(u);
+	}
+	EXPECT_EQ(filter.output()[0], 4.0);
+
+	filter.setOrder(3);
+	EXPECT_EQ(filter.getOrder(), 3u);
+	for (int k = 0; k < 3; k++)
+	{
+		u[0] = 10.0 * k;
+		EXPECT_EQ(filter.filt(u)[0], 4.0);
+	}
+	u[0] = 30.0;
+	EXPECT_EQ(filter.filt(u)[0], 15.0);
+}
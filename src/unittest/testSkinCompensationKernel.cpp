@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <iCub/skinManager/compensationKernel.h>
+
+using namespace iCub::skinManager;
+
+namespace
+{
+	const int MAX_SKIN = 255;
+	const double BIN_TOUCH = 100.0;
+	const double BIN_NO_TOUCH = 0.0;
+
+	struct Options
+	{
+		bool zeroUpRawData;
+		bool smoothFilter;
+		bool binarization;
+		float smoothFactor;
+		double addThreshold;
+		double compensationGain;
+		double contactCompensationGain;
+	};
+
+	struct State
+	{
+		std::vector<double> baselines, thresholds, compensated, compensatedOld, compensatedFilt, output;
+		std::vector<bool> touch, subTouch, touchFilt;
+
+		State(unsigned int n, std::mt19937& gen)
+			: baselines(n), thresholds(n), compensated(n), compensatedOld(n, 0.0), compensatedFilt(n), output(n),
+			  touch(n), subTouch(n), touchFilt(n)
+		{
+			std::uniform_real_distribution<double> base(5.0, 40.0), thr(0.5, 6.0);
+			for (unsigned int i = 0; i < n; i++)
+			{
+				baselines[i] = base(gen);
+				thresholds[i] = thr(gen);
+			}
+		}
+	};
+
+	// Compensator::readRawAndWriteCompensatedData() followed by Compensator::updateBaseline(),
+	// as they were before the compensation was fused into compensateTaxels()
+	void compensateBaseline(const Options& o, const std::vector<double>& raw, State& s)
+	{
+		double d;
+		for (unsigned int i = 0; i < raw.size(); i++)
+		{
+			d = (double)(o.zeroUpRawData ? raw[i] - s.baselines[i] : MAX_SKIN - raw[i] - s.baselines[i]);
+			d = std::min<double>(MAX_SKIN, d);
+			s.compensated[i] = d;
+
+			s.touch[i] = (d > s.thresholds[i] + o.addThreshold);
+			s.subTouch[i] = (d < -s.thresholds[i] - o.addThreshold);
+
+			if (o.smoothFilter)
+			{
+				d = (1 - o.smoothFactor) * d + o.smoothFactor * s.compensatedOld[i];
+				s.compensatedOld[i] = d;
+			}
+			s.compensatedFilt[i] = d;
+
+			s.touchFilt[i] = (d > s.thresholds[i] + o.addThreshold);
+			if (o.binarization)
+				d = (s.touchFilt[i] ? BIN_TOUCH : BIN_NO_TOUCH);
+
+			s.output[i] = std::max<double>(0.0, d);
+		}
+
+		double gain;
+		for (unsigned int j = 0; j < raw.size(); j++)
+		{
+			d = s.compensated[j];
+			if (s.touch[j])
+				gain = o.contactCompensationGain * 0.02;
+			else
+				gain = o.compensationGain * 0.02;
+			s.baselines[j] += gain * d / s.thresholds[j];
+		}
+	}
+
+	// returns the number of negative baselines met along the way
+	unsigned int checkEquivalence(const Options& o, unsigned int seed)
+	{
+		const unsigned int n = 500;
+		std::mt19937 gen(seed);
+		State expected(n, gen);
+		State s = expected;
+		std::vector<unsigned char> touch(n), subTouch(n), touchFilt(n);
+
+		// same coefficients as Compensator::readRawAndWriteCompensatedData(true)
+		CompensationCoeffs k;
+		k.rawOffset = (o.zeroUpRawData ? 0.0 : (double)MAX_SKIN);
+		k.rawSign = (o.zeroUpRawData ? 1.0 : -1.0);
+		k.addThr = o.addThreshold;
+		k.smoothNew = (o.smoothFilter ? (double)(1 - o.smoothFactor) : 1.0);
+		k.smoothOld = (o.smoothFilter ? (double)o.smoothFactor : 0.0);
+		k.touchGain = o.contactCompensationGain * 0.02;
+		k.noTouchGain = o.compensationGain * 0.02;
+		k.binTouch = BIN_TOUCH;
+		k.binNoTouch = BIN_NO_TOUCH;
+		k.binarize = o.binarization;
+
+		// raw data near the baselines, with some taxels pressed from time to time
+		std::normal_distribution<double> noise(0.0, 2.0);
+		std::uniform_real_distribution<double> press(0.0, 1.0);
+		std::vector<double> raw(n);
+		unsigned int totalNegatives = 0;
+		for (int cycle = 0; cycle < 200; cycle++)
+		{
+			for (unsigned int i = 0; i < n; i++)
+			{
+				double v = expected.baselines[i] + noise(gen) + (press(gen) < 0.05 ? 40.0 : 0.0);
+				raw[i] = std::max(0.0, std::min((double)MAX_SKIN, o.zeroUpRawData ? v : MAX_SKIN - v));
+			}
+
+			compensateBaseline(o, raw, expected);
+			unsigned int negativeBaselines = compensateTaxels(k, n, raw.data(), s.thresholds.data(),
+				s.baselines.data(), s.compensated.data(), s.compensatedOld.data(), s.compensatedFilt.data(),
+				s.output.data(), touch.data(), subTouch.data(), touchFilt.data(), MAX_SKIN);
+
+			unsigned int expectedNegatives = 0;
+			for (unsigned int i = 0; i < n; i++)
+			{
+				expectedNegatives += (expected.baselines[i] < 0.0);
+
+				EXPECT_DOUBLE_EQ(s.compensated[i], expected.compensated[i]) << "cycle=" << cycle << " i=" << i;
+				EXPECT_DOUBLE_EQ(s.compensatedFilt[i], expected.compensatedFilt[i]) << "cycle=" << cycle << " i=" << i;
+				EXPECT_DOUBLE_EQ(s.output[i], expected.output[i]) << "cycle=" << cycle << " i=" << i;
+				EXPECT_DOUBLE_EQ(s.baselines[i], expected.baselines[i]) << "cycle=" << cycle << " i=" << i;
+				EXPECT_EQ(touch[i] != 0, expected.touch[i]) << "cycle=" << cycle << " i=" << i;
+				EXPECT_EQ(subTouch[i] != 0, expected.subTouch[i]) << "cycle=" << cycle << " i=" << i;
+				EXPECT_EQ(touchFilt[i] != 0, expected.touchFilt[i]) << "cycle=" << cycle << " i=" << i;
+
+				// the old values are not kept when the smooth filter is off
+				if (o.smoothFilter)
+				{
+					EXPECT_DOUBLE_EQ(s.compensatedOld[i], expected.compensatedOld[i]) << "cycle=" << cycle << " i=" << i;
+				}
+			}
+			EXPECT_EQ(negativeBaselines, expectedNegatives);
+			totalNegatives += negativeBaselines;
+
+			// stop at the first cycle that differs
+			if (::testing::Test::HasFailure())
+				break;
+		}
+		return totalNegatives;
+	}
+}
+
+TEST(SkinCompensationKernel, matches_previous_compensation)
+{
+	unsigned int seed = 0;
+	for (bool zeroUp : {false, true})
+		for (bool smooth : {false, true})
+			for (bool bin : {false, true})
+			{
+				Options o = {zeroUp, smooth, bin, 0.7f, 2.0, 0.05, 0.01};
+				checkEquivalence(o, seed++);
+			}
+}
+
+TEST(SkinCompensationKernel, negative_baselines)
+{
+	// large gains drive the baselines of the untouched taxels below zero
+	Options o = {true, false, false, 0.5f, 0.0, 500.0, 0.0};
+	EXPECT_GT(checkEquivalence(o, 100), 0u);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+#include <yarp/os/DummyConnector.h>
+
+#include <iCub/skinDynLib/skinContactList.h>
+
+using namespace yarp::os;
+using namespace yarp::sig;
+using namespace iCub::skinDynLib;
+
+namespace
+{
+	skinContactList makeContacts(size_t numContacts, size_t numTaxels, unsigned int seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> real(-1.0, 1.0);
+		std::uniform_int_distribution<unsigned int> start(0, 700);
+		std::uniform_int_distribution<unsigned int> step(1, 12);
+
+		skinContactList list;
+		for (size_t i = 0; i < numContacts; i++)
+		{
+			Vector CoP(3), geoCenter(3), F(3), Mu(3), normalDir(3);
+			for (int j = 0; j < 3; j++)
+			{
+				CoP[j] = real(gen);
+				geoCenter[j] = real(gen);
+				F[j] = 10.0 * real(gen);
+				Mu[j] = real(gen);
+				normalDir[j] = real(gen);
+			}
+
+			// taxel ids are mostly increasing, with an occasional step back
+			std::vector<unsigned int> taxels;
+			unsigned int id = start(gen);
+			for (size_t k = 0; k < numTaxels; k++)
+			{
+				taxels.push_back(id);
+				id = (k % 7 == 6 ? id - step(gen) / 2 : id + step(gen));
+			}
+
+			skinContact c(RIGHT_ARM, SKIN_RIGHT_FOREARM, 4, CoP, geoCenter, taxels, 20.0 * real(gen), normalDir);
+			c.setForceMoment(F, Mu);
+			list.push_back(c);
+		}
+		return list;
+	}
+
+	bool sendAndReceive(const Portable &out, Portable &in, size_t &payloadSize)
+	{
+		DummyConnector connector;
+		if (!out.write(connector.getWriter()))
+			return false;
+		ConnectionReader &reader = connector.getReader();
+		payloadSize = reader.getSize();
+		return in.read(reader);
+	}
+
+	void expectSameContact(const dynContact &a, const dynContact &b)
+	{
+		EXPECT_EQ(a.getId(), b.getId());
+		EXPECT_EQ(a.getBodyPart(), b.getBodyPart());
+		EXPECT_EQ(a.getLinkNumber(), b.getLinkNumber());
+		for (int j = 0; j < 3; j++)
+		{
+			EXPECT_FLOAT_EQ(a.getCoP()[j], b.getCoP()[j]);
+			EXPECT_FLOAT_EQ(a.getForce()[j], b.getForce()[j]);
+			EXPECT_FLOAT_EQ(a.getMoment()[j], b.getMoment()[j]);
+		}
+	}
+}
+
+TEST(SkinContactListPacked, skin_round_trip)
+{
+	skinContactList sent = makeContacts(12, 40, 0);
+	sent.push_back(skinContact());  // no active taxels
+	sent.setPackedFormat(true);
+
+	skinContactList received;
+	size_t payloadSize;
+	ASSERT_TRUE(sendAndReceive(sent, received, payloadSize));
+	ASSERT_EQ(sent.size(), received.size());
+
+	for (size_t i = 0; i < sent.size(); i++)
+	{
+		expectSameContact(sent[i], received[i]);
+		EXPECT_EQ(sent[i].getSkinPart(), received[i].getSkinPart());
+		EXPECT_FLOAT_EQ(sent[i].getPressure(), received[i].getPressure());
+		for (int j = 0; j < 3; j++)
+		{
+			EXPECT_FLOAT_EQ(sent[i].getGeoCenter()[j], received[i].getGeoCenter()[j]);
+			EXPECT_FLOAT_EQ(sent[i].getNormalDir()[j], received[i].getNormalDir()[j]);
+		}
+		EXPECT_EQ(sent[i].getActiveTaxels(), received[i].getActiveTaxels());
+		EXPECT_EQ(sent[i].getTaxelList(), received[i].getTaxelList());
+	}
+}
+
+TEST(SkinContactListPacked, dyn_round_trip)
+{
+	dynContactList sent = makeContacts(5, 10, 1).toDynContactList();
+	EXPECT_FALSE(sent.isPackedFormat());
+	sent.setPackedFormat(true);
+
+	dynContactList received;
+	size_t payloadSize;
+	ASSERT_TRUE(sendAndReceive(sent, received, payloadSize));
+	ASSERT_EQ(sent.size(), received.size());
+	for (size_t i = 0; i < sent.size(); i++)
+		expectSameContact(sent[i], received[i]);
+
+	// a packed dynContactList cannot be read as a skinContactList
+	skinContactList wrongType;
+	EXPECT_FALSE(sendAndReceive(sent, wrongType, payloadSize));
+}
+
+TEST(SkinContactListPacked, default_format_unchanged)
+{
+	skinContactList sent = makeContacts(3, 20, 2);
+
+	skinContactList received;
+	size_t payloadSize;
+	ASSERT_TRUE(sendAndReceive(sent, received, payloadSize));
+	ASSERT_EQ(sent.size(), received.size());
+	for (size_t i = 0; i < sent.size(); i++)
+	{
+		EXPECT_EQ(sent[i].getCoP()[0], received[i].getCoP()[0]);
+		EXPECT_EQ(sent[i].getTaxelList(), received[i].getTaxelList());
+	}
+}
+
+TEST(SkinContactListPacked, size)
+{
+	for (size_t numTaxels : {4, 40, 200})
+	{
+		skinContactList sent = makeContacts(10, numTaxels, 3);
+		skinContactList received;
+		size_t sizes[2];
+
+		for (int packed = 0; packed < 2; packed++)
+		{
+			sent.setPackedFormat(packed != 0);
+			ASSERT_TRUE(sendAndReceive(sent, received, sizes[packed]));
+		}
+
+		EXPECT_LT(sizes[1], sizes[0]);
+	}
+}
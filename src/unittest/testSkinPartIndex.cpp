@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <iCub/skinDynLib/skinPart.h>
+
+using namespace yarp::sig;
+using namespace iCub::skinDynLib;
+
+namespace
+{
+	// taxels spread over the surface of a cylinder, as on a forearm
+	void fillCylinder(skinPart& part, size_t numTaxels, unsigned int seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> angle(0.0, 2.0 * M_PI);
+		std::uniform_real_distribution<double> length(0.0, 0.25);
+
+		part.clearTaxels();
+		for (size_t i = 0; i < numTaxels; i++)
+		{
+			double a = angle(gen);
+			Vector pos(3), nrm(3);
+			nrm[0] = cos(a);
+			nrm[1] = sin(a);
+			nrm[2] = 0.0;
+			pos[0] = 0.04 * nrm[0];
+			pos[1] = 0.04 * nrm[1];
+			pos[2] = length(gen);
+			part.taxels.push_back(new Taxel(pos, nrm, (int)i));
+		}
+		part.buildTaxelIndex();
+	}
+
+	double dist2(skinPart& part, int i, const Vector& p)
+	{
+		Vector q = part.taxels[i]->getPosition();
+		return (q[0] - p[0]) * (q[0] - p[0]) + (q[1] - p[1]) * (q[1] - p[1]) + (q[2] - p[2]) * (q[2] - p[2]);
+	}
+
+	int bruteNearest(skinPart& part, const Vector& p, double maxDist)
+	{
+		int nearest = -1;
+		double minDist2 = (maxDist > 0.0 ? maxDist * maxDist : 1e300);
+		for (int i = 0; i < part.getTaxelsSize(); i++)
+		{
+			double d2 = dist2(part, i, p);
+			if ((d2 < minDist2) || ((d2 == minDist2) && (nearest < 0)))
+			{
+				minDist2 = d2;
+				nearest = i;
+			}
+		}
+		return nearest;
+	}
+
+	std::vector<Vector> makeQueries(size_t numQueries, double extent, unsigned int seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> real(-extent, extent);
+		std::vector<Vector> queries;
+		for (size_t k = 0; k < numQueries; k++)
+		{
+			Vector p(3);
+			p[0] = real(gen);
+			p[1] = real(gen);
+			p[2] = 0.125 + 2.0 * real(gen);
+			queries.push_back(p);
+		}
+		return queries;
+	}
+}
+
+TEST(SkinPartIndex, nearest_matches_brute_force)
+{
+	skinPart part;
+	EXPECT_EQ(part.getNearestTaxel(Vector(3, 0.0)), -1);
+
+	fillCylinder(part, 2000, 0);
+	for (double extent : {0.05, 0.5, 20.0})
+	{
+		for (const Vector& p : makeQueries(500, extent, 1))
+		{
+			EXPECT_EQ(part.getNearestTaxel(p), bruteNearest(part, p, -1.0));
+			EXPECT_EQ(part.getNearestTaxel(p, 0.01), bruteNearest(part, p, 0.01));
+		}
+	}
+}
+
+TEST(SkinPartIndex, radius_matches_brute_force)
+{
+	skinPart part;
+	fillCylinder(part, 2000, 2);
+
+	for (double radius : {0.0, 0.005, 0.02, 0.1})
+	{
+		for (const Vector& p : makeQueries(200, 0.06, 3))
+		{
+			std::vector<int> expected;
+			for (int i = 0; i < part.getTaxelsSize(); i++)
+				if (dist2(part, i, p) <= radius * radius)
+					expected.push_back(i);
+			EXPECT_EQ(part.getTaxelsWithinRadius(p, radius), expected);
+		}
+	}
+}
+
+TEST(SkinPartIndex, copy_keeps_index)
+{
+	skinPart part;
+	fillCylinder(part, 300, 4);
+	skinPart copy(part);
+
+	for (const Vector& p : makeQueries(100, 0.06, 5))
+		EXPECT_EQ(copy.getNearestTaxel(p), part.getNearestTaxel(p));
+
+	part.clearTaxels();
+	EXPECT_EQ(part.getNearestTaxel(Vector(3, 0.0)), -1);
+	EXPECT_TRUE(part.getTaxelsWithinRadius(Vector(3, 0.0), 1.0).empty());
+}
+
+TEST(SkinPartIndex, non_finite_positions)
+{
+	skinPart part;
+	fillCylinder(part, 300, 6);
+
+	Vector pos(3, 0.0);
+	pos[0] = std::nan("");
+	part.taxels[10]->setPosition(pos);
+	pos[0] = 0.0;
+	pos[2] = std::numeric_limits<double>::infinity();
+	part.taxels[20]->setPosition(pos);
+	part.buildTaxelIndex();
+
+	for (const Vector& p : makeQueries(100, 0.06, 7))
+	{
+		EXPECT_EQ(part.getNearestTaxel(p), bruteNearest(part, p, -1.0));
+		for (int i : part.getTaxelsWithinRadius(p, 0.1))
+			EXPECT_TRUE((i != 10) && (i != 20));
+	}
+
+	// no finite position at all
+	for (Taxel* t : part.taxels)
+		t->setPosition(pos);
+	part.buildTaxelIndex();
+	EXPECT_EQ(part.getNearestTaxel(Vector(3, 0.0)), -1);
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <random>
+#include <vector>
+
+#include <iCub/skinManager/taxelClustering.h>
+
+using namespace iCub::skinManager;
+
+namespace
+{
+	// taxels on a rows x cols grid with 1 cm spacing
+	std::vector<double> makeGrid(unsigned int rows, unsigned int cols)
+	{
+		std::vector<double> pos;
+		for (unsigned int r = 0; r < rows; r++)
+		{
+			for (unsigned int c = 0; c < cols; c++)
+			{
+				pos.push_back(0.01 * c);
+				pos.push_back(0.01 * r);
+				pos.push_back(0.0);
+			}
+		}
+		return pos;
+	}
+
+	// neighbor lists as skinManager used to build them
+	std::vector<std::list<int>> oldNeighbors(const std::vector<double>& pos, double maxDist)
+	{
+		unsigned int n = pos.size() / 3;
+		std::vector<std::list<int>> neighbors(n);
+		for (unsigned int i = 0; i < n; i++)
+		{
+			for (unsigned int j = i + 1; j < n; j++)
+			{
+				double d2 = 0.0;
+				for (int k = 0; k < 3; k++)
+					d2 += (pos[3 * i + k] - pos[3 * j + k]) * (pos[3 * i + k] - pos[3 * j + k]);
+				if (d2 <= maxDist * maxDist)
+				{
+					neighbors[i].push_back(j);
+					neighbors[j].push_back(i);
+				}
+			}
+		}
+		return neighbors;
+	}
+
+	// the clustering of the active taxels that skinManager used before the union-find
+	std::deque<std::deque<int>> oldContacts(const std::vector<unsigned char>& active, const std::vector<std::list<int>>& neighborsXtaxel)
+	{
+		unsigned int skinDim = active.size();
+		std::vector<int> contactXtaxel(skinDim, -1);
+		std::deque<std::deque<int>> taxelsXcontact;
+		int contactId = 0;
+		for (unsigned int i = 0; i < skinDim; i++)
+		{
+			if (!active[i])
+				continue;
+			for (int neigh : neighborsXtaxel[i])
+			{
+				int neighCont = contactXtaxel[neigh];
+				if (neighCont < 0)
+					continue;
+				if (contactXtaxel[i] < 0)
+				{
+					contactXtaxel[i] = neighCont;
+					taxelsXcontact[neighCont].push_back(i);
+				}
+				else if (contactXtaxel[i] != neighCont)
+				{
+					int newId = std::min(contactXtaxel[i], neighCont);
+					int oldId = std::max(contactXtaxel[i], neighCont);
+					std::deque<int> tax2move = taxelsXcontact[oldId];
+					for (int t : tax2move)
+					{
+						contactXtaxel[t] = newId;
+						taxelsXcontact[newId].push_back(t);
+					}
+					taxelsXcontact[oldId].clear();
+				}
+			}
+			if (contactXtaxel[i] < 0)
+			{
+				contactXtaxel[i] = contactId;
+				taxelsXcontact.resize(contactId + 1);
+				taxelsXcontact[contactId].push_back(i);
+				contactId++;
+			}
+		}
+
+		std::deque<std::deque<int>> contacts;
+		for (auto& c : taxelsXcontact)
+			if (!c.empty())
+				contacts.push_back(c);
+		return contacts;
+	}
+
+	void expectSameContacts(const std::deque<std::deque<int>>& expected, const TaxelClustering& clusters, unsigned int num)
+	{
+		ASSERT_EQ(num, expected.size());
+		for (unsigned int c = 0; c < num; c++)
+		{
+			std::vector<int> taxels(clusters.taxelsXcontact.begin() + clusters.contactStart[c],
+			                        clusters.taxelsXcontact.begin() + clusters.contactStart[c + 1]);
+
+			// the taxels of a contact are listed in increasing id order
+			EXPECT_TRUE(std::is_sorted(taxels.begin(), taxels.end())) << "contact " << c;
+
+			std::vector<int> old(expected[c].begin(), expected[c].end());
+			std::sort(old.begin(), old.end());
+			EXPECT_EQ(taxels, old) << "contact " << c;
+		}
+	}
+}
+
+TEST(SkinTaxelClustering, neighbor_graph)
+{
+	std::vector<double> pos = makeGrid(7, 9);
+	unsigned int n = pos.size() / 3;
+
+	for (double maxDist : {0.0105, 0.0145, 0.025})
+	{
+		std::vector<unsigned int> start, list;
+		computeNeighborGraph(pos.data(), n, maxDist, start, list);
+		std::vector<std::list<int>> expected = oldNeighbors(pos, maxDist);
+
+		ASSERT_EQ(start.size(), n + 1);
+		ASSERT_EQ(start[n], list.size());
+		for (unsigned int i = 0; i < n; i++)
+		{
+			std::vector<int> neighbors(list.begin() + start[i], list.begin() + start[i + 1]);
+			EXPECT_EQ(neighbors, std::vector<int>(expected[i].begin(), expected[i].end())) << "taxel " << i;
+		}
+	}
+}
+
+TEST(SkinTaxelClustering, matches_previous_clustering)
+{
+	std::vector<double> pos = makeGrid(8, 8);
+	unsigned int n = pos.size() / 3;
+	std::mt19937 gen(0);
+
+	TaxelClustering clusters;
+	for (double maxDist : {0.0105, 0.0145})
+	{
+		std::vector<unsigned int> start, list;
+		computeNeighborGraph(pos.data(), n, maxDist, start, list);
+		std::vector<std::list<int>> neighbors = oldNeighbors(pos, maxDist);
+
+		for (double density : {0.1, 0.3, 0.5, 0.8})
+		{
+			std::bernoulli_distribution touched(density);
+			for (int trial = 0; trial < 50; trial++)
+			{
+				std::vector<unsigned char> active(n);
+				for (unsigned int i = 0; i < n; i++)
+					active[i] = touched(gen);
+
+				// the work buffers are reused across the calls
+				unsigned int num = clusters.cluster(active.data(), n, false, start, list);
+				expectSameContacts(oldContacts(active, neighbors), clusters, num);
+			}
+		}
+	}
+}
+
+TEST(SkinTaxelClustering, all_neighbors)
+{
+	unsigned int n = 40;
+	std::vector<std::list<int>> neighbors(n);
+	for (unsigned int i = 0; i < n; i++)
+		for (unsigned int j = 0; j < n; j++)
+			neighbors[i].push_back(j);
+
+	std::vector<unsigned char> active(n, 0);
+	std::vector<unsigned int> start, list;
+	TaxelClustering clusters;
+
+	EXPECT_EQ(clusters.cluster(active.data(), n, true, start, list), 0u);
+
+	active[3] = active[17] = active[39] = 1;
+	unsigned int num = clusters.cluster(active.data(), n, true, start, list);
+	expectSameContacts(oldContacts(active, neighbors), clusters, num);
+}
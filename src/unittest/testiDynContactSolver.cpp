@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <random>
+
+#include <yarp/math/Math.h>
+#include <yarp/math/SVD.h>
+
+#include <iCub/iDyn/iDyn.h>
+#include <iCub/iDyn/iDynInv.h>
+#include <iCub/iDyn/iDynContact.h>
+
+using namespace yarp::sig;
+using namespace yarp::math;
+using namespace iCub::iDyn;
+using namespace iCub::skinDynLib;
+
+namespace
+{
+	// exposes the linear system solved by iDynContactSolver
+	class ContactSolverProbe : public iDynContactSolver
+	{
+	public:
+		ContactSolverProbe(iDynChain* c, SensorLinkNewtonEuler* sensor)
+			: iDynContactSolver(c, 2, sensor, "", DYNAMIC, RIGHT_ARM) {}
+
+		Vector solve(const Matrix& _A, const Vector& _B)
+		{
+			A = _A;
+			B = _B;
+			return solveAXB();
+		}
+
+		const Matrix& getA() const { return A; }
+		const Vector& getB() const { return B; }
+		const Vector& getX() const { return X; }
+	};
+
+	void expectSameSolution(ContactSolverProbe& solver, const Matrix& A, const Vector& B)
+	{
+		Vector expected = pinv(A, TOLLERANCE) * B;
+		Vector X = solver.solve(A, B);
+		ASSERT_EQ(X.size(), expected.size());
+		for (size_t i = 0; i < X.size(); i++)
+			EXPECT_NEAR(X[i], expected[i], 1e-8 * (1.0 + norm(expected))) << "cols=" << A.cols() << " i=" << i;
+	}
+
+	dynContactList makeSkinContacts(size_t num)
+	{
+		dynContactList list;
+		for (size_t i = 0; i < num; i++)
+		{
+			Vector CoP(3);
+			CoP[0] = 0.01 * i;
+			CoP[1] = -0.02;
+			CoP[2] = 0.005 * i;
+			dynContact c(RIGHT_ARM, 4 + i % 3, CoP);
+			c.fixMoment();
+			list.push_back(c);
+		}
+		return list;
+	}
+}
+
+TEST(iDynContactSolver, solution_matches_pinv)
+{
+	iCubArmNoTorsoDyn arm("right");
+	ContactSolverProbe solver(&arm, new iCubArmSensorLink("right", DYNAMIC));
+
+	std::mt19937 gen(0);
+	std::uniform_real_distribution<double> real(-1.0, 1.0);
+
+	for (unsigned int cols : {1, 3, 6, 7, 12, 30})
+	{
+		for (int trial = 0; trial < 20; trial++)
+		{
+			Matrix A(6, cols);
+			Vector B(6);
+			for (int r = 0; r < 6; r++)
+			{
+				B[r] = real(gen);
+				for (unsigned int c = 0; c < cols; c++)
+					A(r, c) = real(gen);
+			}
+			expectSameSolution(solver, A, B);
+
+			// rank-deficient systems, as two contacts at the same point
+			if (cols >= 2)
+			{
+				A.setCol(1, A.getCol(0));
+				expectSameSolution(solver, A, B);
+			}
+			if (cols >= 7)
+			{
+				A.setRow(5, A.getRow(4));
+				expectSameSolution(solver, A, B);
+			}
+		}
+	}
+}
+
+TEST(iDynContactSolver, repeated_estimate)
+{
+	iCubArmNoTorsoDyn arm("right");
+	ContactSolverProbe solver(&arm, new iCubArmSensorLink("right", DYNAMIC));
+
+	Vector q(arm.getN());
+	for (size_t i = 0; i < q.size(); i++)
+		q[i] = 0.2 * std::sin(1.0 + i);
+	arm.setAng(q);
+
+	Vector FMsens(6);
+	for (int i = 0; i < 6; i++)
+		FMsens[i] = 0.7 * i - 1.3;
+
+	// the second estimate reuses the factorization of the first one
+	dynContactList first;
+	for (int k = 0; k < 2; k++)
+	{
+		solver.clearContactList();
+		solver.addContacts(makeSkinContacts(10));
+		const dynContactList& res = solver.computeExternalContacts(FMsens);
+		ASSERT_EQ(res.size(), 10);
+
+		// both estimates, the cached one included, match the pinv() solution
+		Vector expected = pinv(solver.getA(), TOLLERANCE) * solver.getB();
+		ASSERT_EQ(solver.getX().size(), expected.size());
+		for (size_t i = 0; i < expected.size(); i++)
+			EXPECT_NEAR(solver.getX()[i], expected[i], 1e-8 * (1.0 + norm(expected))) << "k=" << k << " i=" << i;
+
+		if (k == 0)
+		{
+			first = res;
+			continue;
+		}
+		for (size_t i = 0; i < res.size(); i++)
+			for (int j = 0; j < 3; j++)
+				EXPECT_EQ(res[i].getForce()[j], first[i].getForce()[j]);
+	}
+}
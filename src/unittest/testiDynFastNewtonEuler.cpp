@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+#include <iCub/iDyn/iDyn.h>
+#include <iCub/iDyn/iDynInv.h>
+
+using namespace yarp::sig;
+using namespace iCub::iDyn;
+
+namespace
+{
+	const NewEulMode modes[] = {STATIC, DYNAMIC, DYNAMIC_W_ROTOR, DYNAMIC_CORIOLIS_GRAVITY};
+
+	// gives access to the per-link recursion of OneLinkNewtonEuler,
+	// as the chain passes did before working on the compact state
+	class NewtonEulerProbe : public OneChainNewtonEuler
+	{
+	public:
+		NewtonEulerProbe(iDynChain* c, NewEulMode mode) : OneChainNewtonEuler(c, "probe", mode) {}
+
+		// the rotor axis is left null by iDynChain, which hides the rotor terms
+		void setRotorAxis(const Vector& zm)
+		{
+			for (unsigned int i = 1; i < nEndEff; i++)
+				neChain[i]->setZM(zm);
+		}
+
+		void computeBaseline(const Vector& w0, const Vector& dw0, const Vector& ddp0, const Vector& Fend, const Vector& Muend)
+		{
+			neChain[0]->setAsBase(w0, dw0, ddp0);
+			for (unsigned int i = 1; i < nEndEff; i++)
+				neChain[i]->ForwardKinematics(neChain[i - 1]);
+
+			neChain[nEndEff]->setAsFinal(Fend, Muend);
+			for (int i = nEndEff - 1; i >= 0; i--)
+				neChain[i]->BackwardWrench(neChain[i + 1]);
+			for (int i = nEndEff - 1; i > 0; i--)
+				neChain[i]->computeTorque(neChain[i - 1]);
+		}
+
+		void computeFast(const Vector& w0, const Vector& dw0, const Vector& ddp0, const Vector& Fend, const Vector& Muend)
+		{
+			ForwardKinematicFromBase(w0, dw0, ddp0);
+			BackwardWrenchFromEnd(Fend, Muend);
+		}
+	};
+
+	struct Result
+	{
+		Matrix F, Mu;
+		Vector tau;
+		std::vector<Vector> kin;
+
+		explicit Result(iDynChain& chain)
+		{
+			F = chain.getForcesNewtonEuler();
+			Mu = chain.getMomentsNewtonEuler();
+			tau = chain.getTorques();
+			for (unsigned int i = 0; i < chain.getN(); i++)
+			{
+				kin.push_back(chain.getAngVel(i));
+				kin.push_back(chain.getAngAcc(i));
+				kin.push_back(chain.getLinAcc(i));
+				kin.push_back(chain.getLinAccCOM(i));
+			}
+		}
+	};
+
+	void expectNear(const Matrix& expected, const Matrix& M, double tol)
+	{
+		ASSERT_EQ(M.rows(), expected.rows());
+		ASSERT_EQ(M.cols(), expected.cols());
+		for (size_t r = 0; r < M.rows(); r++)
+			for (size_t c = 0; c < M.cols(); c++)
+				EXPECT_NEAR(M(r, c), expected(r, c), tol * (1.0 + fabs(expected(r, c)))) << "r=" << r << " c=" << c;
+	}
+
+	void expectNear(const Vector& expected, const Vector& v, double tol)
+	{
+		ASSERT_EQ(v.size(), expected.size());
+		for (size_t i = 0; i < v.size(); i++)
+			EXPECT_NEAR(v[i], expected[i], tol * (1.0 + fabs(expected[i]))) << "i=" << i;
+	}
+
+	void expectSame(const Result& expected, const Result& result)
+	{
+		expectNear(expected.F, result.F, 1e-12);
+		expectNear(expected.Mu, result.Mu, 1e-12);
+		expectNear(expected.tau, result.tau, 1e-12);
+		ASSERT_EQ(result.kin.size(), expected.kin.size());
+		for (size_t k = 0; k < result.kin.size(); k++)
+			expectNear(expected.kin[k], result.kin[k], 1e-12);
+	}
+
+	void checkEquivalence(iDynLimb& limb, unsigned int seed)
+	{
+		iDynChain& chain = *limb.asChain();
+		const unsigned int n = chain.getN();
+		const unsigned int dof = chain.getDOF();
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> real(-1.0, 1.0);
+
+		// rotor parameters, so that DYNAMIC_W_ROTOR has its own terms
+		for (unsigned int i = 0; i < n; i++)
+			chain.setDynamicParameters(i, chain.getMass(i), chain.getCOM(i), chain.getInertia(i),
+									   100.0, 0.1, 0.2, 1e-5 * (1 + i));
+		Vector zm(3);
+		zm[0] = 0.1;
+		zm[1] = -0.2;
+		zm[2] = 1.0;
+
+		for (NewEulMode mode : modes)
+		{
+			chain.prepareNewtonEuler(mode);
+			NewtonEulerProbe baseline(&chain, mode);
+			NewtonEulerProbe rotor(&chain, mode);
+			rotor.setRotorAxis(zm);
+
+			for (int trial = 0; trial < 10; trial++)
+			{
+				Vector q(dof), dq(dof), ddq(dof);
+				for (unsigned int i = 0; i < dof; i++)
+				{
+					q[i] = real(gen);
+					dq[i] = 2.0 * real(gen);
+					ddq[i] = 5.0 * real(gen);
+				}
+				chain.setAng(q);
+				chain.setDAng(dq);
+				chain.setD2Ang(ddq);
+
+				Vector w0(3), dw0(3), ddp0(3), Fend(3), Muend(3);
+				for (int k = 0; k < 3; k++)
+				{
+					w0[k] = real(gen);
+					dw0[k] = real(gen);
+					ddp0[k] = 9.81 * real(gen);
+					Fend[k] = 3.0 * real(gen);
+					Muend[k] = 0.3 * real(gen);
+				}
+
+				// the computation of the limb
+				chain.computeNewtonEuler(w0, dw0, ddp0, Fend, Muend);
+				Result fast(chain);
+				baseline.computeBaseline(w0, dw0, ddp0, Fend, Muend);
+				expectSame(Result(chain), fast);
+
+				// the same passes with a non-null rotor axis
+				rotor.computeFast(w0, dw0, ddp0, Fend, Muend);
+				Result fastRotor(chain);
+				rotor.computeBaseline(w0, dw0, ddp0, Fend, Muend);
+				expectSame(Result(chain), fastRotor);
+			}
+		}
+	}
+}
+
+TEST(iDynFastNewtonEuler, arm)
+{
+	iCubArmDyn arm("right");
+	checkEquivalence(arm, 0);
+}
+
+TEST(iDynFastNewtonEuler, arm_no_torso)
+{
+	iCubArmNoTorsoDyn arm("left");
+	checkEquivalence(arm, 1);
+}
+
+TEST(iDynFastNewtonEuler, leg)
+{
+	iCubLegDyn leg("left");
+	checkEquivalence(leg, 2);
+}
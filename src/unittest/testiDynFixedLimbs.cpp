@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+#include <iCub/iDyn/iDyn.h>
+#include <iCub/iDyn/iDynFixed.h>
+
+using namespace yarp::sig;
+using namespace iCub::iDyn;
+
+namespace
+{
+	const NewEulMode modes[] = {DYNAMIC, STATIC, DYNAMIC_CORIOLIS_GRAVITY, DYNAMIC_W_ROTOR};
+
+	struct LimbInput
+	{
+		Vector q, dq, ddq;
+		Vector w0, dw0, ddp0, Fend, Muend;
+
+		// the first numBlocked links are kept at rest, as iDynLimb does with blocked links
+		LimbInput(unsigned int n, unsigned int numBlocked) : q(n, 0.0), dq(n, 0.0), ddq(n, 0.0), w0(3), dw0(3), ddp0(3), Fend(3), Muend(3)
+		{
+			for (unsigned int i = numBlocked; i < n; i++)
+			{
+				q[i] = 0.1 * (i + 1) - 0.3;
+				dq[i] = 0.2 * i - 0.5;
+				ddq[i] = 0.3 - 0.1 * i;
+			}
+
+			w0[0] = 0.1;  w0[1] = -0.2; w0[2] = 0.3;
+			dw0[0] = 0.5; dw0[1] = 0.1; dw0[2] = -0.1;
+			ddp0[0] = 0.3; ddp0[1] = -0.1; ddp0[2] = 9.81;
+			Fend[0] = 1.0; Fend[1] = 2.0; Fend[2] = -1.0;
+			Muend[0] = 0.1; Muend[1] = 0.2; Muend[2] = 0.3;
+		}
+	};
+
+	template <class Fixed>
+	void checkEquivalence(iDynLimb &limb, unsigned int numBlocked, NewEulMode mode)
+	{
+		unsigned int n = limb.getN();
+		ASSERT_EQ(Fixed::N, n);
+
+		LimbInput in(n, numBlocked);
+		limb.setAng(in.q.subVector(numBlocked, n - 1));
+		limb.setDAng(in.dq.subVector(numBlocked, n - 1));
+		limb.setD2Ang(in.ddq.subVector(numBlocked, n - 1));
+		limb.prepareNewtonEuler(mode);
+		limb.computeNewtonEuler(in.w0, in.dw0, in.ddp0, in.Fend, in.Muend);
+
+		Fixed fixed(mode);
+		ASSERT_TRUE(fixed.computeNewtonEuler(in.q, in.dq, in.ddq, in.w0, in.dw0, in.ddp0, in.Fend, in.Muend));
+
+		Vector tau = limb.getTorques();
+		Matrix F = limb.getForces();
+		Matrix Mu = limb.getMoments();
+		for (unsigned int i = 0; i < n; i++)
+		{
+			EXPECT_NEAR(tau[i], fixed.getTorque(i), 1e-12);
+			for (int k = 0; k < 3; k++)
+			{
+				EXPECT_NEAR(F(k, i), fixed.getForce(i)[k], 1e-12);
+				EXPECT_NEAR(Mu(k, i), fixed.getMoment(i)[k], 1e-12);
+			}
+		}
+	}
+}
+
+TEST(iDynFixedLimbs, right_arm_equivalence)
+{
+	for (NewEulMode mode : modes)
+	{
+		iCubArmDyn arm("right");
+		checkEquivalence<iCubRightArmDynFixed>(arm, 3, mode);
+	}
+}
+
+TEST(iDynFixedLimbs, left_arm_equivalence)
+{
+	for (NewEulMode mode : modes)
+	{
+		iCubArmDyn arm("left");
+		checkEquivalence<iCubLeftArmDynFixed>(arm, 3, mode);
+	}
+}
+
+TEST(iDynFixedLimbs, right_leg_equivalence)
+{
+	for (NewEulMode mode : modes)
+	{
+		iCubLegDyn leg("right");
+		checkEquivalence<iCubRightLegDynFixed>(leg, 0, mode);
+	}
+}
+
+TEST(iDynFixedLimbs, left_leg_equivalence)
+{
+	for (NewEulMode mode : modes)
+	{
+		iCubLegDyn leg("left");
+		checkEquivalence<iCubLeftLegDynFixed>(leg, 0, mode);
+	}
+}
+
+TEST(iDynFixedLimbs, torso_equivalence)
+{
+	for (NewEulMode mode : modes)
+	{
+		iCubTorsoDyn torso("lower", KINFWD_WREBWD);
+		checkEquivalence<iCubTorsoDynFixed>(torso, 0, mode);
+	}
+}
+
+TEST(iDynFixedLimbs, wrong_sizes)
+{
+	iCubRightLegDynFixed leg;
+	Vector q(5, 0.0), dq(6, 0.0), v3(3, 0.0);
+
+	EXPECT_FALSE(leg.computeNewtonEuler(q, dq, dq, v3, v3, v3, v3, v3));
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2022 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ * This software may be modified and distributed under the terms of the
+ * BSD-3-Clause license. See the accompanying LICENSE file for details.
+ */
+#include "gtest/gtest.h"
+
+#include <deque>
+#include <random>
+
+#include <iCub/iKin/iKinFwd.h>
+
+using namespace yarp::sig;
+using namespace iCub::iKin;
+
+namespace
+{
+	void expectSameMatrix(const Matrix& expected, const Matrix& M, double tol)
+	{
+		ASSERT_EQ(M.rows(), expected.rows());
+		ASSERT_EQ(M.cols(), expected.cols());
+		for (size_t r = 0; r < M.rows(); r++)
+			for (size_t c = 0; c < M.cols(); c++)
+				EXPECT_NEAR(M(r, c), expected(r, c), tol) << "r=" << r << " c=" << c;
+	}
+
+	void expectSameColumn(const Vector& expected, const Matrix& M, size_t col, double tol)
+	{
+		ASSERT_EQ(M.rows(), expected.length());
+		for (size_t r = 0; r < M.rows(); r++)
+			EXPECT_NEAR(M(r, col), expected[r], tol) << "r=" << r << " col=" << col;
+	}
+
+	// compares the allocation-free kinematics with the standard one
+	// over random configurations, reusing the same output matrices
+	void checkEquivalence(iKinLimb& limb, unsigned int seed)
+	{
+		iKinChain& chain = *limb.asChain();
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> real(-1.5, 1.5);
+
+		Matrix H, Jgeo, Jana;
+		for (int trial = 0; trial < 50; trial++)
+		{
+			Vector q(chain.getDOF());
+			for (size_t i = 0; i < q.length(); i++)
+				q[i] = real(gen);
+			chain.setAng(q);
+
+			chain.fastGetH(H);
+			expectSameMatrix(chain.getH(), H, 1e-12);
+
+			chain.fastGeoJacobian(Jgeo);
+			expectSameMatrix(chain.GeoJacobian(), Jgeo, 1e-12);
+
+			for (unsigned int col = 0; col < 4; col++)
+			{
+				chain.fastAnaJacobian(Jana, col);
+				expectSameMatrix(chain.AnaJacobian(col), Jana, 1e-12);
+			}
+		}
+	}
+
+	// compares the batch entry points with the per-configuration
+	// EndEffPose() and GeoJacobian() over random configurations
+	void checkBatchEquivalence(iKinLimb& limb, unsigned int seed, unsigned int nThreads)
+	{
+		iKinChain& chain = *limb.asChain();
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> real(-1.5, 1.5);
+
+		const size_t M = 37;
+		Matrix Q(chain.getDOF(), M);
+		for (size_t r = 0; r < Q.rows(); r++)
+			for (size_t c = 0; c < Q.cols(); c++)
+				Q(r, c) = real(gen);
+
+		Matrix Xaxis, Xeul, Xboth;
+		std::deque<Matrix> J, Jboth;
+		chain.batchEndEffPose(Q, Xaxis, true, nThreads);
+		chain.batchEndEffPose(Q, Xeul, false, nThreads);
+		chain.batchGeoJacobian(Q, J, nThreads);
+		chain.batchEndEffPose(Q, Xboth, Jboth, true, nThreads);
+
+		ASSERT_EQ(Xaxis.cols(), M);
+		ASSERT_EQ(Xeul.cols(), M);
+		ASSERT_EQ(J.size(), M);
+		ASSERT_EQ(Jboth.size(), M);
+
+		for (size_t k = 0; k < M; k++)
+		{
+			Vector q = Q.getCol(k);
+			Vector xaxis = chain.EndEffPose(q, true);
+			Vector xeul = chain.EndEffPose(q, false);
+			Matrix Jgeo = chain.GeoJacobian();
+
+			expectSameColumn(xaxis, Xaxis, k, 1e-12);
+			expectSameColumn(xeul, Xeul, k, 1e-12);
+			expectSameColumn(xaxis, Xboth, k, 1e-12);
+			expectSameMatrix(Jgeo, J[k], 1e-12);
+			expectSameMatrix(Jgeo, Jboth[k], 1e-12);
+		}
+	}
+}
+
+TEST(iKinFastKinematics, arm)
+{
+	iCubArm arm("right_v2");
+	checkEquivalence(arm, 0);
+
+	// blocked links change the number of DOF, hence the size of the Jacobians
+	arm.releaseLink(0);
+	arm.releaseLink(1);
+	arm.releaseLink(2);
+	checkEquivalence(arm, 1);
+}
+
+TEST(iKinFastKinematics, leg)
+{
+	iCubLeg leg("left_v2.5");
+	checkEquivalence(leg, 2);
+}
+
+TEST(iKinFastKinematics, eye)
+{
+	iCubEye eye("left_v2");
+	checkEquivalence(eye, 3);
+
+	eye.blockLink(3, 0.1);
+	checkEquivalence(eye, 4);
+}
+
+TEST(iKinFastKinematics, batch)
+{
+	iCubArm arm("right_v2");
+	checkBatchEquivalence(arm, 5, 1);
+	checkBatchEquivalence(arm, 6, 3);
+
+	arm.releaseLink(0);
+	arm.releaseLink(1);
+	arm.releaseLink(2);
+	checkBatchEquivalence(arm, 7, 4);
+
+	iCubLeg leg("left_v2.5");
+	checkBatchEquivalence(leg, 8, 2);
+}